@@ -74,9 +74,9 @@ void AAStarPathfindingGameMode::OnGridStateChanged()
 	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, TEXT("Grid state changed"));
 }
 
-void AAStarPathfindingGameMode::OnPathReCalculated(const TArray<FVector>& Path, const TArray<FVector>& ExploredNodes)
+void AAStarPathfindingGameMode::OnPathReCalculated(const FPathResult& Result)
 {
-	FString Message = FString::Printf(TEXT("New path calculated with %d points, %d nodes explored"), Path.Num(), ExploredNodes.Num());
+	FString Message = FString::Printf(TEXT("New path calculated with %d points, %d nodes explored"), Result.PathCells.Num(), Result.GetNumExplored());
 	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, Message);
 }
 
@@ -120,7 +120,7 @@ void AAStarPathfindingGameMode::InitializeGrid()
 	if (GridManager)
 	{
 		GridManager->OnGridChanged.AddDynamic(this, &AAStarPathfindingGameMode::OnGridStateChanged);
-		GridManager->OnPathUpdated.AddDynamic(this, &AAStarPathfindingGameMode::OnPathReCalculated);
+		GridManager->OnPathResultUpdated.AddUObject(this, &AAStarPathfindingGameMode::OnPathReCalculated);
 
 		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, TEXT("Grid Manager initialized successfully"));
 	}
@@ -30,8 +30,7 @@ protected:
 	UFUNCTION()
 	void OnGridStateChanged();
 
-	UFUNCTION()
-	void OnPathReCalculated(const TArray<FVector>& Path, const TArray<FVector>& ExploredNodes);
+	void OnPathReCalculated(const FPathResult& Result);
 
 private:
 	//////// METHODS ////////
@@ -0,0 +1,484 @@
+#include "PathfindingBenchmarkCommandlet.h"
+#include "AStarPathfinding/Grid/GridFile.h"
+#include "AStarPathfinding/Grid/GridManager.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "AStarPathfinding/Solver/AnyAnglePathFinder.h"
+#include "AStarPathfinding/Solver/BidirectionalContext.h"
+#include "AStarPathfinding/Solver/HierarchicalGraph.h"
+#include "AStarPathfinding/Solver/IncrementalPathFinder.h"
+#include "AStarPathfinding/Solver/JumpPointFinder.h"
+#include "AStarPathfinding/Solver/JumpPointTable.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfinding/Solver/PathFinderKernel.h"
+#include "AStarPathfinding/Solver/PathFinderTypes.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	/// Paths are measured in cells, a straight move is 1
+	constexpr float BENCHMARK_CELL_SIZE = 1.0f;
+
+	/// One line of a .scen file
+	struct FBenchmarkScenario
+	{
+		FString MapPath;
+		int32 Bucket = 0;
+		int32 StartX = 0;
+		int32 StartY = 0;
+		int32 GoalX = 0;
+		int32 GoalY = 0;
+
+		/// optimal length given by the file, where diagonal moves cannot cut corners
+		double ScenarioLength = 0.0;
+	};
+
+	struct FBenchmarkResult
+	{
+		bool bFoundPath = false;
+		bool bReferenceFoundPath = false;
+		int32 Expansions = 0;
+		double LatencyUs = 0.0;
+		double Length = 0.0;
+		double ReferenceLength = 0.0;
+
+		double GetGap() const
+		{
+			return bFoundPath && ReferenceLength > 0.0 ? (Length - ReferenceLength) / ReferenceLength : 0.0;
+		}
+	};
+
+	/// Solver state built once per map and reused by its scenarios
+	struct FBenchmarkSolvers
+	{
+		FPathFinderContext Context;
+		FBidirectionalContext BidirectionalContext;
+		FJumpPointTable JumpPointTable;
+		FHierarchicalGraph HierarchicalGraph;
+		FHierarchicalPath HierarchicalPath;
+		TArray<int32> HierarchicalCells;
+		TArray<int32> HierarchicalExploredCells;
+		FIncrementalPathFinder IncrementalPathFinder;
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return Context.GetAllocatedSize() + BidirectionalContext.GetAllocatedSize()
+				+ JumpPointTable.GetAllocatedSize() + HierarchicalGraph.GetAllocatedSize()
+				+ IncrementalPathFinder.GetAllocatedSize();
+		}
+	};
+
+	/// Reads every scenario of a .scen file, maps are looked up next to it then in MapDirectory
+	bool LoadScenarioFile(const FString& FilePath, const FString& MapDirectory, TArray<FBenchmarkScenario>& OutScenarios)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("PathfindingBenchmark : Could not read %s"), *FilePath);
+			return false;
+		}
+
+		const FString ScenarioDirectory = FPaths::GetPath(FilePath);
+		FString CurrentMapName;
+		FString CurrentMapPath;
+		for (const FString& Line : Lines)
+		{
+			// "version 1" then: bucket, map, map width, map height, start x, start y, goal x, goal y, optimal length
+			TArray<FString> Fields;
+			Line.ParseIntoArrayWS(Fields);
+			if (Fields.Num() < 9)
+			{
+				continue;
+			}
+
+			if (Fields[1] != CurrentMapName)
+			{
+				CurrentMapName = Fields[1];
+				const FString Candidates[] = {
+					FPaths::Combine(ScenarioDirectory, CurrentMapName),
+					FPaths::Combine(ScenarioDirectory, FPaths::GetCleanFilename(CurrentMapName)),
+					FPaths::Combine(MapDirectory, FPaths::GetCleanFilename(CurrentMapName))
+				};
+
+				CurrentMapPath.Reset();
+				for (const FString& Candidate : Candidates)
+				{
+					if (FPaths::FileExists(Candidate))
+					{
+						CurrentMapPath = Candidate;
+						break;
+					}
+				}
+
+				if (CurrentMapPath.IsEmpty())
+				{
+					UE_LOG(LogTemp, Error, TEXT("PathfindingBenchmark : Map %s of %s not found, use -MapDir"),
+						*CurrentMapName, *FilePath);
+					return false;
+				}
+			}
+
+			FBenchmarkScenario& Scenario = OutScenarios.AddDefaulted_GetRef();
+			Scenario.MapPath = CurrentMapPath;
+			Scenario.Bucket = FCString::Atoi(*Fields[0]);
+			Scenario.StartX = FCString::Atoi(*Fields[4]);
+			Scenario.StartY = FCString::Atoi(*Fields[5]);
+			Scenario.GoalX = FCString::Atoi(*Fields[6]);
+			Scenario.GoalY = FCString::Atoi(*Fields[7]);
+			Scenario.ScenarioLength = FCString::Atod(*Fields[8]);
+		}
+		return true;
+	}
+
+	bool LoadMap(const FString& MapPath, FWalkabilityGrid& OutGrid)
+	{
+		return FPaths::GetExtension(MapPath).ToLower() == TEXT("map")
+			? GridFile::ImportMovingAIMap(MapPath, OutGrid)
+			: GridFile::Load(MapPath, OutGrid);
+	}
+
+	void AppendCellPositions(const TArray<int32>& Cells, int32 GridSizeX, TArray<FVector>& OutPositions)
+	{
+		for (const int32 Cell : Cells)
+		{
+			OutPositions.Add(FVector((Cell % GridSizeX + 0.5f) * BENCHMARK_CELL_SIZE,
+				(Cell / GridSizeX + 0.5f) * BENCHMARK_CELL_SIZE, 0.0f));
+		}
+	}
+
+	/// Same dispatch as AGridManager::UpdatePathfinding, without the path cache and the reachability check
+	bool RunSolver(FBenchmarkSolvers& Solvers, const FWalkabilityGrid& Grid, ESolverMode SolverMode,
+		EOpenListType OpenListType, const FBenchmarkScenario& Scenario, TArray<FVector>& OutPath,
+		TArray<FVector>& OutExploredNodes)
+	{
+		const int32 GridSizeX = Grid.GetSizeX();
+		const int32 GridSizeY = Grid.GetSizeY();
+		switch (SolverMode)
+		{
+		case ESolverMode::JumpPoint:
+			return JumpPointFinder::Compute(Solvers.Context, Grid, GridSizeX, GridSizeY, Scenario.StartX,
+				Scenario.StartY, Scenario.GoalX, Scenario.GoalY, BENCHMARK_CELL_SIZE, OutPath, OutExploredNodes,
+				OpenListType);
+		case ESolverMode::JumpPointPlus:
+			return JumpPointFinder::Compute(Solvers.Context, Solvers.JumpPointTable, Grid, GridSizeX, GridSizeY,
+				Scenario.StartX, Scenario.StartY, Scenario.GoalX, Scenario.GoalY, BENCHMARK_CELL_SIZE, OutPath,
+				OutExploredNodes, OpenListType);
+		case ESolverMode::Hierarchical:
+		{
+			OutPath.Reset();
+			OutExploredNodes.Reset();
+			const bool bFoundPath = Solvers.HierarchicalGraph.FindAbstractPath(Grid, Scenario.StartX, Scenario.StartY,
+				Scenario.GoalX, Scenario.GoalY, Solvers.HierarchicalPath, &Solvers.HierarchicalExploredCells)
+				&& Solvers.HierarchicalGraph.RefinePath(Grid, Solvers.HierarchicalPath, Solvers.HierarchicalCells);
+			if (bFoundPath)
+			{
+				AppendCellPositions(Solvers.HierarchicalCells, GridSizeX, OutPath);
+			}
+			AppendCellPositions(Solvers.HierarchicalExploredCells, GridSizeX, OutExploredNodes);
+			return bFoundPath;
+		}
+		case ESolverMode::Incremental:
+			// Cold start of every query, replanning after edits is not measured here
+			Solvers.IncrementalPathFinder.Initialize(GridSizeX, GridSizeY, Scenario.StartX, Scenario.StartY,
+				Scenario.GoalX, Scenario.GoalY);
+			return Solvers.IncrementalPathFinder.ComputePath(Grid, BENCHMARK_CELL_SIZE, OutPath, OutExploredNodes);
+		case ESolverMode::Bidirectional:
+		case ESolverMode::BidirectionalParallel:
+			return PathFinder::ComputeBidirectional(Solvers.BidirectionalContext, Grid, GridSizeX, GridSizeY,
+				Scenario.StartX, Scenario.StartY, Scenario.GoalX, Scenario.GoalY, BENCHMARK_CELL_SIZE, OutPath,
+				OutExploredNodes, SolverMode == ESolverMode::BidirectionalParallel);
+		case ESolverMode::ThetaStar:
+		case ESolverMode::LazyThetaStar:
+			return AnyAnglePathFinder::Compute(Solvers.Context, Grid, GridSizeX, GridSizeY, Scenario.StartX,
+				Scenario.StartY, Scenario.GoalX, Scenario.GoalY, BENCHMARK_CELL_SIZE, OutPath, OutExploredNodes,
+				SolverMode == ESolverMode::LazyThetaStar, OpenListType);
+		case ESolverMode::AStar:
+		default:
+			return PathFinder::Compute(Solvers.Context, Grid, GridSizeX, GridSizeY, Scenario.StartX, Scenario.StartY,
+				Scenario.GoalX, Scenario.GoalY, BENCHMARK_CELL_SIZE, OutPath, OutExploredNodes, OpenListType);
+		}
+	}
+
+	/// A* the gap is measured against, without corner cutting it finds the optimal lengths of the MovingAI scenarios
+	bool RunReference(FPathFinderContext& Context, const FWalkabilityGrid& Grid, bool bNoCornerCutting,
+		const FBenchmarkScenario& Scenario, TArray<FVector>& OutPath, TArray<FVector>& OutExploredNodes)
+	{
+		using FNoCornerCuttingPathFinder = TPathFinder<FOctileHeuristic, FEightWayNoCornerCuttingNeighborhood, int32>;
+		return bNoCornerCutting
+			? FNoCornerCuttingPathFinder::Compute(Context, Grid, Grid.GetSizeX(), Grid.GetSizeY(), Scenario.StartX,
+				Scenario.StartY, Scenario.GoalX, Scenario.GoalY, BENCHMARK_CELL_SIZE, OutPath, OutExploredNodes)
+			: PathFinder::Compute(Context, Grid, Grid.GetSizeX(), Grid.GetSizeY(), Scenario.StartX, Scenario.StartY,
+				Scenario.GoalX, Scenario.GoalY, BENCHMARK_CELL_SIZE, OutPath, OutExploredNodes);
+	}
+
+	double GetPathLength(const TArray<FVector>& Path)
+	{
+		double Length = 0.0;
+		for (int32 Index = 1; Index < Path.Num(); ++Index)
+		{
+			Length += FVector::Dist2D(Path[Index - 1], Path[Index]);
+		}
+		return Length;
+	}
+
+	/// Nearest rank percentile of sorted values
+	double GetPercentile(const TArray<double>& SortedValues, double Percentile)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.0;
+		}
+		const int32 Rank = FMath::CeilToInt(Percentile * SortedValues.Num());
+		return SortedValues[FMath::Clamp(Rank - 1, 0, SortedValues.Num() - 1)];
+	}
+
+	TSharedRef<FJsonObject> MakeDistribution(TArray<double>& Values)
+	{
+		Values.Sort();
+
+		double Sum = 0.0;
+		for (const double Value : Values)
+		{
+			Sum += Value;
+		}
+
+		TSharedRef<FJsonObject> Distribution = MakeShared<FJsonObject>();
+		Distribution->SetNumberField(TEXT("Mean"), Values.Num() > 0 ? Sum / Values.Num() : 0.0);
+		Distribution->SetNumberField(TEXT("P50"), GetPercentile(Values, 0.50));
+		Distribution->SetNumberField(TEXT("P95"), GetPercentile(Values, 0.95));
+		Distribution->SetNumberField(TEXT("P99"), GetPercentile(Values, 0.99));
+		Distribution->SetNumberField(TEXT("Max"), Values.Num() > 0 ? Values.Last() : 0.0);
+		return Distribution;
+	}
+}
+
+UPathfindingBenchmarkCommandlet::UPathfindingBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Runs MovingAI scenarios through a solver and writes latency, expansions and optimality gap");
+	HelpUsage = TEXT("-run=PathfindingBenchmark -nullrhi -Scenarios=<.scen file or directory> [-MapDir=<dir>] "
+		"[-Solver=AStar] [-OpenList=BinaryHeap] [-Repeat=1] [-ClusterSize=16] [-NoCornerCutting] [-Csv=<file>] "
+		"[-Json=<file>]");
+}
+
+int32 UPathfindingBenchmarkCommandlet::Main(const FString& Params)
+{
+	//// Parameters
+	FString ScenarioPath, MapDirectory, SolverName(TEXT("AStar")), OpenListName(TEXT("BinaryHeap"));
+	int32 Repeat = 1;
+	int32 ClusterSize = FHierarchicalGraph::DEFAULT_CLUSTER_SIZE;
+	FParse::Value(*Params, TEXT("Scenarios="), ScenarioPath);
+	FParse::Value(*Params, TEXT("MapDir="), MapDirectory);
+	FParse::Value(*Params, TEXT("Solver="), SolverName);
+	FParse::Value(*Params, TEXT("OpenList="), OpenListName);
+	FParse::Value(*Params, TEXT("Repeat="), Repeat);
+	FParse::Value(*Params, TEXT("ClusterSize="), ClusterSize);
+	const bool bNoCornerCutting = FParse::Param(*Params, TEXT("NoCornerCutting"));
+	const TCHAR* ReferenceName = bNoCornerCutting ? TEXT("AStarNoCornerCutting") : TEXT("AStar");
+	Repeat = FMath::Max(Repeat, 1);
+	ClusterSize = FMath::Max(ClusterSize, 2);
+
+	const int64 SolverValue = StaticEnum<ESolverMode>()->GetValueByNameString(SolverName);
+	const int64 OpenListValue = StaticEnum<EOpenListType>()->GetValueByNameString(OpenListName);
+	if (SolverValue == INDEX_NONE || OpenListValue == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PathfindingBenchmark : Unknown solver %s or open list %s"), *SolverName,
+			*OpenListName);
+		return 1;
+	}
+
+	const ESolverMode SolverMode = static_cast<ESolverMode>(SolverValue);
+	const EOpenListType OpenListType = static_cast<EOpenListType>(OpenListValue);
+	if (SolverMode == ESolverMode::FlowField)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PathfindingBenchmark : Flow fields answer a goal, not a query, pick another solver"));
+		return 1;
+	}
+
+	const FString OutputName = FString::Printf(TEXT("PathfindingBenchmark_%s_%s"), *SolverName, *OpenListName);
+	FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), OutputName + TEXT(".csv"));
+	FString JsonPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), OutputName + TEXT(".json"));
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+	FParse::Value(*Params, TEXT("Json="), JsonPath);
+
+	//// Scenarios, sorted by file name so runs on the same set are comparable
+	TArray<FString> ScenarioFiles;
+	if (FPaths::DirectoryExists(ScenarioPath))
+	{
+		IFileManager::Get().FindFilesRecursive(ScenarioFiles, *ScenarioPath, TEXT("*.scen"), true, false);
+		ScenarioFiles.Sort();
+	}
+	else if (FPaths::FileExists(ScenarioPath))
+	{
+		ScenarioFiles.Add(ScenarioPath);
+	}
+
+	TArray<FBenchmarkScenario> Scenarios;
+	for (const FString& ScenarioFile : ScenarioFiles)
+	{
+		if (!LoadScenarioFile(ScenarioFile, MapDirectory, Scenarios))
+		{
+			return 1;
+		}
+	}
+
+	if (Scenarios.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PathfindingBenchmark : No scenario found in '%s', see -Scenarios"), *ScenarioPath);
+		return 1;
+	}
+
+	//// Runs
+	FWalkabilityGrid Grid;
+	FString LoadedMapPath;
+	TUniquePtr<FBenchmarkSolvers> Solvers;
+	FPathFinderContext ReferenceContext;
+	TArray<FVector> Path, ExploredNodes, ReferencePath, ReferenceExploredNodes;
+	TArray<FBenchmarkResult> Results;
+	Results.SetNum(Scenarios.Num());
+	double PreprocessMs = 0.0;
+	SIZE_T PeakSolverBytes = 0;
+
+	for (int32 ScenarioIndex = 0; ScenarioIndex < Scenarios.Num(); ++ScenarioIndex)
+	{
+		const FBenchmarkScenario& Scenario = Scenarios[ScenarioIndex];
+		if (Scenario.MapPath != LoadedMapPath)
+		{
+			if (!LoadMap(Scenario.MapPath, Grid))
+			{
+				return 1;
+			}
+			LoadedMapPath = Scenario.MapPath;
+
+			// Fresh state per map, so a map does not pay for the buffers a previous larger map grew
+			Solvers = MakeUnique<FBenchmarkSolvers>();
+			const uint64 PreprocessStart = FPlatformTime::Cycles64();
+			if (SolverMode == ESolverMode::JumpPointPlus)
+			{
+				Solvers->JumpPointTable.Build(Grid, Grid.GetSizeX(), Grid.GetSizeY());
+			}
+			else if (SolverMode == ESolverMode::Hierarchical)
+			{
+				Solvers->HierarchicalGraph.Build(Grid, Grid.GetSizeX(), Grid.GetSizeY(), ClusterSize);
+			}
+			PreprocessMs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - PreprocessStart);
+		}
+
+		if (!AGridManager::StaticIsValidPos(Scenario.StartX, Scenario.StartY, Grid.GetSizeX(), Grid.GetSizeY())
+			|| !AGridManager::StaticIsValidPos(Scenario.GoalX, Scenario.GoalY, Grid.GetSizeX(), Grid.GetSizeY()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("PathfindingBenchmark : Scenario %d is outside %s"), ScenarioIndex,
+				*Scenario.MapPath);
+			return 1;
+		}
+
+		// The fastest of the repeats, the slower ones measure the machine rather than the solver
+		FBenchmarkResult& Result = Results[ScenarioIndex];
+		Result.LatencyUs = MAX_dbl;
+		for (int32 Run = 0; Run < Repeat; ++Run)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Result.bFoundPath = RunSolver(*Solvers, Grid, SolverMode, OpenListType, Scenario, Path, ExploredNodes);
+			const double LatencyUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+			Result.LatencyUs = FMath::Min(Result.LatencyUs, LatencyUs);
+		}
+		Result.Expansions = ExploredNodes.Num();
+		Result.Length = Result.bFoundPath ? GetPathLength(Path) : 0.0;
+		PeakSolverBytes = FMath::Max(PeakSolverBytes, Solvers->GetAllocatedSize() + Grid.GetAllocatedSize());
+
+		// A* of this module is optimal for its own moves, corners included, so it is its own reference
+		if (SolverMode == ESolverMode::AStar && !bNoCornerCutting)
+		{
+			Result.bReferenceFoundPath = Result.bFoundPath;
+			Result.ReferenceLength = Result.Length;
+		}
+		else
+		{
+			Result.bReferenceFoundPath = RunReference(ReferenceContext, Grid, bNoCornerCutting, Scenario, ReferencePath,
+				ReferenceExploredNodes);
+			Result.ReferenceLength = Result.bReferenceFoundPath ? GetPathLength(ReferencePath) : 0.0;
+		}
+	}
+
+	//// CSV, one line per scenario
+	FString Csv(TEXT("Map,Bucket,StartX,StartY,GoalX,GoalY,Found,Expansions,LatencyUs,Length,ReferenceLength,Gap,"
+		"ScenarioLength\n"));
+	TArray<double> Expansions, Latencies, Gaps;
+	int32 NumFound = 0;
+	int32 NumMissed = 0;
+	int32 NumSuboptimal = 0;
+	for (int32 ScenarioIndex = 0; ScenarioIndex < Scenarios.Num(); ++ScenarioIndex)
+	{
+		const FBenchmarkScenario& Scenario = Scenarios[ScenarioIndex];
+		const FBenchmarkResult& Result = Results[ScenarioIndex];
+		Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%d,%d,%d,%.3f,%.6f,%.6f,%.6f,%.6f\n"),
+			*FPaths::GetCleanFilename(Scenario.MapPath), Scenario.Bucket, Scenario.StartX, Scenario.StartY,
+			Scenario.GoalX, Scenario.GoalY, Result.bFoundPath ? 1 : 0, Result.Expansions, Result.LatencyUs,
+			Result.Length, Result.ReferenceLength, Result.GetGap(), Scenario.ScenarioLength);
+
+		Expansions.Add(Result.Expansions);
+		Latencies.Add(Result.LatencyUs);
+		NumFound += Result.bFoundPath ? 1 : 0;
+		NumMissed += Result.bReferenceFoundPath && !Result.bFoundPath ? 1 : 0;
+		if (Result.bFoundPath)
+		{
+			Gaps.Add(Result.GetGap());
+			NumSuboptimal += Result.GetGap() > KINDA_SMALL_NUMBER ? 1 : 0;
+		}
+	}
+
+	//// JSON summary, with what the numbers depend on
+	TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	Summary->SetStringField(TEXT("Solver"), SolverName);
+	Summary->SetStringField(TEXT("OpenList"), OpenListName);
+	Summary->SetStringField(TEXT("Reference"), ReferenceName);
+	Summary->SetStringField(TEXT("Scenarios"), ScenarioPath);
+	Summary->SetNumberField(TEXT("Repeat"), Repeat);
+	Summary->SetStringField(TEXT("BuildVersion"), FApp::GetBuildVersion());
+	Summary->SetStringField(TEXT("BuildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+	Summary->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Summary->SetStringField(TEXT("Cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	Summary->SetNumberField(TEXT("NumScenarios"), Scenarios.Num());
+	Summary->SetNumberField(TEXT("NumFound"), NumFound);
+	Summary->SetNumberField(TEXT("NumMissed"), NumMissed);
+	Summary->SetNumberField(TEXT("NumSuboptimal"), NumSuboptimal);
+	Summary->SetNumberField(TEXT("PreprocessMs"), PreprocessMs);
+	Summary->SetObjectField(TEXT("Expansions"), MakeDistribution(Expansions));
+	Summary->SetObjectField(TEXT("LatencyUs"), MakeDistribution(Latencies));
+	Summary->SetObjectField(TEXT("Gap"), MakeDistribution(Gaps));
+	Summary->SetNumberField(TEXT("PeakSolverBytes"), static_cast<double>(PeakSolverBytes));
+	Summary->SetNumberField(TEXT("PeakUsedPhysicalBytes"),
+		static_cast<double>(FPlatformMemory::GetStats().PeakUsedPhysical));
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Summary, Writer);
+
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath) || !FFileHelper::SaveStringToFile(Json, *JsonPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("PathfindingBenchmark : Could not write %s or %s"), *CsvPath, *JsonPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display,
+		TEXT("PathfindingBenchmark : %s against %s, %d scenarios, %d found, %d missed, %d suboptimal"),
+		*SolverName, ReferenceName, Scenarios.Num(), NumFound, NumMissed, NumSuboptimal);
+	UE_LOG(LogTemp, Display, TEXT("PathfindingBenchmark : Latency p50 %.1fus p95 %.1fus p99 %.1fus max %.1fus"),
+		GetPercentile(Latencies, 0.50), GetPercentile(Latencies, 0.95), GetPercentile(Latencies, 0.99),
+		GetPercentile(Latencies, 1.0));
+	UE_LOG(LogTemp, Display, TEXT("PathfindingBenchmark : Results written to %s and %s"), *CsvPath, *JsonPath);
+	return 0;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PathfindingBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs MovingAI benchmark scenarios (https://movingai.com/benchmarks/formats.html) through one solver, headless:
+ *   UnrealEditor-Cmd AStarPathfinding.uproject -run=PathfindingBenchmark -nullrhi -unattended
+ *     -Scenarios=<.scen file or directory> [-MapDir=<dir>] [-Solver=AStar] [-OpenList=BinaryHeap] [-Repeat=3]
+ *     [-ClusterSize=16] [-NoCornerCutting] [-Csv=<file>] [-Json=<file>]
+ * Every scenario is written to the CSV, the JSON holds the distributions of expansions, latency and optimality gap
+ * with the build, engine and CPU they were measured on. The gap is measured against A* of this module, which cuts
+ * corners. With -NoCornerCutting the reference A* does not, its lengths are the MovingAI ones and solvers that cut
+ * corners get negative gaps. The JSON and the log name the reference used.
+ */
+UCLASS()
+class UPathfindingBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	//////// CONSTRUCTOR ////////
+	UPathfindingBenchmarkCommandlet();
+
+	//////// OVERRIDES ////////
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,54 @@
+#include "FindPathAsyncAction.h"
+#include "GridManager.h"
+
+UFindPathAsyncAction* UFindPathAsyncAction::FindPathAsync(AGridManager* GridManager, FVector StartWorldPosition,
+	FVector GoalWorldPosition, int32 AgentId)
+{
+	UFindPathAsyncAction* Action = NewObject<UFindPathAsyncAction>();
+	Action->GridManager = GridManager;
+	Action->StartWorldPosition = StartWorldPosition;
+	Action->GoalWorldPosition = GoalWorldPosition;
+	Action->AgentId = AgentId < 0 ? INDEX_NONE : AgentId;
+	if (GridManager)
+	{
+		Action->RegisterWithGameInstance(GridManager);
+	}
+	return Action;
+}
+
+void UFindPathAsyncAction::Activate()
+{
+	if (!GridManager.IsValid())
+	{
+		OnPathFailed.Broadcast(TArray<FVector>(), FPathRequestHandle());
+		SetReadyToDestroy();
+		return;
+	}
+
+	TWeakObjectPtr<UFindPathAsyncAction> WeakThis(this);
+	const FPathRequestHandle Handle = GridManager->RequestPath(StartWorldPosition, GoalWorldPosition, AgentId,
+		[WeakThis](FPathRequestResult& Result)
+		{
+			UFindPathAsyncAction* Action = WeakThis.Get();
+			if (!Action)
+			{
+				return;
+			}
+
+			if (Result.bFoundPath)
+			{
+				Action->OnPathFound.Broadcast(Result.Path, Result.Handle);
+			}
+			else
+			{
+				Action->OnPathFailed.Broadcast(Result.Path, Result.Handle);
+			}
+			Action->SetReadyToDestroy();
+		});
+
+	if (!Handle.IsValid())
+	{
+		OnPathFailed.Broadcast(TArray<FVector>(), Handle);
+		SetReadyToDestroy();
+	}
+}
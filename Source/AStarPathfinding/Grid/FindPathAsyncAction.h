@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "AStarPathfinding/Solver/PathFinderTypes.h"
+#include "FindPathAsyncAction.generated.h"
+
+class AGridManager;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFindPathAsyncCompleted, const TArray<FVector>&, Path, FPathRequestHandle, Handle);
+
+/** Latent "Find Path Async" node, the search runs on the task system through AGridManager::RequestPath */
+UCLASS()
+class ASTARPATHFINDING_API UFindPathAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	//////// DELEGATES ////////
+	UPROPERTY(BlueprintAssignable)
+	FOnFindPathAsyncCompleted OnPathFound;
+
+	/** Also fired when the request is cancelled or superseded by a newer one of the same agent */
+	UPROPERTY(BlueprintAssignable)
+	FOnFindPathAsyncCompleted OnPathFailed;
+
+	//////// METHODS ////////
+	/** AgentId >= 0 cancels the request still pending for the same agent */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding",
+		meta = (BlueprintInternalUseOnly = "true", DisplayName = "Find Path Async"))
+	static UFindPathAsyncAction* FindPathAsync(AGridManager* GridManager, FVector StartWorldPosition,
+		FVector GoalWorldPosition, int32 AgentId = -1);
+
+	virtual void Activate() override;
+
+private:
+	//////// FIELDS ////////
+	UPROPERTY()
+	TWeakObjectPtr<AGridManager> GridManager;
+	FVector StartWorldPosition;
+	FVector GoalWorldPosition;
+	int32 AgentId;
+};
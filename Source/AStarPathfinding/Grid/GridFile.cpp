@@ -0,0 +1,523 @@
+#include "GridFile.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+	struct FGridFileHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 GridSizeX;
+		int32 GridSizeY;
+		int32 TileSize;
+		int32 NumLayers;
+	};
+
+	struct FGridFileLayer
+	{
+		GridFile::ELayerType Type;
+		uint32 Reserved;
+		uint64 Offset;
+		uint64 Size;
+	};
+
+	/** Walkability tile slots and words, followed by the cost tile slots and tiles on grids with cell costs */
+	constexpr int32 NUM_WALKABILITY_LAYERS = 2;
+	constexpr int32 MAX_WRITTEN_LAYERS = 4;
+	constexpr uint64 LAYER_ALIGNMENT = sizeof(uint64);
+
+	/** Keeps a grid file mapped while grids read their tiles from it */
+	class FMappedGridFile final : public FWalkabilityTileStorage
+	{
+	public:
+		TUniquePtr<IMappedFileHandle> Handle;
+		/** Declared after the handle so it is unmapped before the file closes */
+		TUniquePtr<IMappedFileRegion> Region;
+	};
+
+	/** Crossable cells from 8-bit gray levels, row by row from Y = 0 */
+	void BuildFromGrayLevels(const TArray<uint8>& GrayLevels, int32 Width, int32 Height, uint8 MinCrossableLevel,
+		FWalkabilityGrid& OutGrid)
+	{
+		OutGrid.InitTiles(Width, Height, [&GrayLevels, Width, Height, MinCrossableLevel](int32 TileX, int32 TileY,
+			uint64* OutRows)
+		{
+			const int32 FirstX = TileX * FWalkabilityGrid::TILE_SIZE;
+			const int32 FirstY = TileY * FWalkabilityGrid::TILE_SIZE;
+			const int32 EndX = FMath::Min(FirstX + FWalkabilityGrid::TILE_SIZE, Width);
+			const int32 EndY = FMath::Min(FirstY + FWalkabilityGrid::TILE_SIZE, Height);
+			for (int32 Y = FirstY; Y < EndY; ++Y)
+			{
+				const uint8* Row = &GrayLevels[static_cast<int64>(Y) * Width];
+				uint64 Bits = 0;
+				for (int32 X = FirstX; X < EndX; ++X)
+				{
+					Bits |= static_cast<uint64>(Row[X] >= MinCrossableLevel) << (X - FirstX);
+				}
+				OutRows[Y - FirstY] = Bits;
+			}
+		});
+	}
+
+	/** Binary (P5) or ASCII (P2) PGM, levels are rescaled to 8 bits */
+	bool ParsePgm(const TArray<uint8>& Bytes, int32& OutWidth, int32& OutHeight, TArray<uint8>& OutGrayLevels)
+	{
+		int64 Position = 2;
+		auto ReadNumber = [&Bytes, &Position](int64& OutNumber)
+		{
+			// Whitespace and # comments may separate the header numbers
+			while (Position < Bytes.Num() && (FChar::IsWhitespace(Bytes[Position]) || Bytes[Position] == '#'))
+			{
+				if (Bytes[Position] == '#')
+				{
+					while (Position < Bytes.Num() && Bytes[Position] != '\n')
+					{
+						++Position;
+					}
+				}
+				else
+				{
+					++Position;
+				}
+			}
+
+			const int64 Start = Position;
+			OutNumber = 0;
+			while (Position < Bytes.Num() && FChar::IsDigit(Bytes[Position]) && OutNumber <= MAX_int32)
+			{
+				OutNumber = OutNumber * 10 + (Bytes[Position++] - '0');
+			}
+			return Position > Start && OutNumber <= MAX_int32;
+		};
+
+		const bool bIsBinary = Bytes[1] == '5';
+		int64 Width, Height, MaxLevel;
+		if (!ReadNumber(Width) || !ReadNumber(Height) || !ReadNumber(MaxLevel)
+			|| !FWalkabilityGrid::IsValidSize(Width, Height) || MaxLevel <= 0 || MaxLevel > MAX_uint16)
+		{
+			return false;
+		}
+
+		// The levels must fit the rest of the file before they are allocated, an ASCII level takes at least a digit
+		// and a separator
+		const int64 NumPixels = Width * Height;
+		const int32 BytesPerLevel = MaxLevel > MAX_uint8 ? 2 : 1;
+		const int64 NumLevelBytes = Bytes.Num() - Position;
+		if (NumPixels > MAX_int32 || NumLevelBytes < (bIsBinary ? 1 + NumPixels * BytesPerLevel : 2 * NumPixels))
+		{
+			return false;
+		}
+
+		// A single whitespace separates the binary levels from the header
+		++Position;
+		OutGrayLevels.SetNumUninitialized(static_cast<int32>(NumPixels));
+		for (int64 Pixel = 0; Pixel < NumPixels; ++Pixel)
+		{
+			int64 Level;
+			if (!bIsBinary)
+			{
+				if (!ReadNumber(Level))
+				{
+					return false;
+				}
+			}
+			else if (BytesPerLevel == 2)
+			{
+				Level = (Bytes[Position] << 8) | Bytes[Position + 1];
+				Position += 2;
+			}
+			else
+			{
+				Level = Bytes[Position++];
+			}
+			OutGrayLevels[Pixel] = static_cast<uint8>(FMath::Min(Level, MaxLevel) * MAX_uint8 / MaxLevel);
+		}
+
+		OutWidth = static_cast<int32>(Width);
+		OutHeight = static_cast<int32>(Height);
+		return true;
+	}
+}
+
+bool GridFile::Save(const FString& FilePath, const FWalkabilityGrid& Grid)
+{
+	// Released slots are dropped, each dense tile is used by a single table entry and is written in table order
+	const TConstArrayView<int32> TileSlots = Grid.GetTileSlots();
+	const TConstArrayView<uint64> TileWords = Grid.GetTileWords();
+	TArray<int32> FileSlots;
+	TArray<int32> DenseSlots;
+	FileSlots.SetNumUninitialized(TileSlots.Num());
+	for (int32 Tile = 0; Tile < TileSlots.Num(); ++Tile)
+	{
+		const int32 Slot = TileSlots[Tile];
+		if (Slot < FWalkabilityGrid::NUM_UNIFORM_TILES)
+		{
+			FileSlots[Tile] = Slot;
+		}
+		else
+		{
+			FileSlots[Tile] = FWalkabilityGrid::NUM_UNIFORM_TILES + DenseSlots.Num();
+			DenseSlots.Add(Slot);
+		}
+	}
+
+	// Cost tiles are compacted the same way, the default tile first
+	const TConstArrayView<int32> CostTileSlots = Grid.GetCostTileSlots();
+	const TConstArrayView<uint8> CostTiles = Grid.GetCostTiles();
+	TArray<int32> FileCostSlots;
+	TArray<int32> DenseCostSlots;
+	FileCostSlots.SetNumUninitialized(CostTileSlots.Num());
+	for (int32 Tile = 0; Tile < CostTileSlots.Num(); ++Tile)
+	{
+		const int32 Slot = CostTileSlots[Tile];
+		if (Slot == FWalkabilityGrid::DEFAULT_COST_TILE)
+		{
+			FileCostSlots[Tile] = Slot;
+		}
+		else
+		{
+			FileCostSlots[Tile] = FWalkabilityGrid::DEFAULT_COST_TILE + 1 + DenseCostSlots.Num();
+			DenseCostSlots.Add(Slot);
+		}
+	}
+
+	const uint64 TileBytes = FWalkabilityGrid::TILE_SIZE * sizeof(uint64);
+	const int32 NumLayers = Grid.HasUniformCosts() ? NUM_WALKABILITY_LAYERS : MAX_WRITTEN_LAYERS;
+	FGridFileHeader Header = { MAGIC, VERSION, Grid.GetSizeX(), Grid.GetSizeY(), FWalkabilityGrid::TILE_SIZE,
+		NumLayers };
+	FGridFileLayer Layers[MAX_WRITTEN_LAYERS];
+	Layers[0] = { ELayerType::TileSlots, 0, Align(sizeof(Header) + NumLayers * sizeof(FGridFileLayer), LAYER_ALIGNMENT),
+		FileSlots.Num() * sizeof(int32) };
+	Layers[1] = { ELayerType::TileWords, 0, Align(Layers[0].Offset + Layers[0].Size, LAYER_ALIGNMENT),
+		(FWalkabilityGrid::NUM_UNIFORM_TILES + DenseSlots.Num()) * TileBytes };
+	Layers[2] = { ELayerType::CostTileSlots, 0, Align(Layers[1].Offset + Layers[1].Size, LAYER_ALIGNMENT),
+		FileCostSlots.Num() * sizeof(int32) };
+	Layers[3] = { ELayerType::CostTiles, 0, Align(Layers[2].Offset + Layers[2].Size, LAYER_ALIGNMENT),
+		(1 + DenseCostSlots.Num()) * static_cast<uint64>(FWalkabilityGrid::NUM_TILE_CELLS) };
+
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	bool bIsWritten;
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("GridFile : Could not create %s"), *TempFilePath);
+			return false;
+		}
+
+		auto PadTo = [&Writer](uint64 Offset)
+		{
+			uint8 Padding[LAYER_ALIGNMENT] = {};
+			Writer->Serialize(Padding, Offset - Writer->Tell());
+		};
+
+		Writer->Serialize(&Header, sizeof(Header));
+		Writer->Serialize(Layers, NumLayers * sizeof(FGridFileLayer));
+		PadTo(Layers[0].Offset);
+		Writer->Serialize(FileSlots.GetData(), Layers[0].Size);
+		PadTo(Layers[1].Offset);
+		Writer->Serialize(const_cast<uint64*>(TileWords.GetData()), FWalkabilityGrid::NUM_UNIFORM_TILES * TileBytes);
+		for (const int32 Slot : DenseSlots)
+		{
+			Writer->Serialize(const_cast<uint64*>(&TileWords[Slot * FWalkabilityGrid::TILE_SIZE]), TileBytes);
+		}
+		if (NumLayers > NUM_WALKABILITY_LAYERS)
+		{
+			PadTo(Layers[2].Offset);
+			Writer->Serialize(FileCostSlots.GetData(), Layers[2].Size);
+			PadTo(Layers[3].Offset);
+			Writer->Serialize(const_cast<uint8*>(CostTiles.GetData()), FWalkabilityGrid::NUM_TILE_CELLS);
+			for (const int32 Slot : DenseCostSlots)
+			{
+				Writer->Serialize(const_cast<uint8*>(&CostTiles[Slot << FWalkabilityGrid::COST_TILE_SHIFT]),
+					FWalkabilityGrid::NUM_TILE_CELLS);
+			}
+		}
+		bIsWritten = Writer->Close();
+	}
+
+	// The previous file is only replaced by a complete one
+	if (!bIsWritten || !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		IFileManager::Get().Delete(*TempFilePath);
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : Could not write %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool GridFile::Load(const FString& FilePath, FWalkabilityGrid& OutGrid)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult MappedFile = PlatformFile.OpenMappedEx(*FilePath);
+	if (MappedFile.HasError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : Could not open %s"), *FilePath);
+		return false;
+	}
+
+	const TSharedRef<FMappedGridFile> Storage = MakeShared<FMappedGridFile>();
+	Storage->Handle = MappedFile.StealValue();
+	const int64 FileSize = Storage->Handle->GetFileSize();
+	if (FileSize >= static_cast<int64>(sizeof(FGridFileHeader)))
+	{
+		Storage->Region.Reset(Storage->Handle->MapRegion(0, FileSize));
+	}
+	if (!Storage->Region)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : Could not map %s"), *FilePath);
+		return false;
+	}
+
+	// Every offset and slot is checked, the grid reads the mapping without bounds checks
+	const uint8* Data = Storage->Region->GetMappedPtr();
+	auto Fail = [&FilePath](const TCHAR* Reason)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : %s is not a valid grid file, %s"), *FilePath, Reason);
+		return false;
+	};
+
+	FGridFileHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+	if (Header.Magic != MAGIC)
+	{
+		return Fail(TEXT("unknown format"));
+	}
+	if (Header.Version > VERSION)
+	{
+		return Fail(TEXT("saved by a newer version"));
+	}
+	if (Header.TileSize != FWalkabilityGrid::TILE_SIZE
+		|| !FWalkabilityGrid::IsValidSize(Header.GridSizeX, Header.GridSizeY) || Header.NumLayers < 0
+		|| Header.NumLayers > (FileSize - static_cast<int64>(sizeof(Header))) / static_cast<int64>(sizeof(FGridFileLayer)))
+	{
+		return Fail(TEXT("invalid header"));
+	}
+
+	TConstArrayView<int32> TileSlots;
+	TConstArrayView<uint64> TileWords;
+	TConstArrayView<int32> CostTileSlots;
+	TConstArrayView<uint8> CostTiles;
+	for (int32 LayerIndex = 0; LayerIndex < Header.NumLayers; ++LayerIndex)
+	{
+		FGridFileLayer Layer;
+		FMemory::Memcpy(&Layer, Data + sizeof(Header) + LayerIndex * sizeof(FGridFileLayer), sizeof(Layer));
+		if (Layer.Offset % LAYER_ALIGNMENT != 0 || Layer.Offset > static_cast<uint64>(FileSize)
+			|| Layer.Size > static_cast<uint64>(FileSize) - Layer.Offset || Layer.Size / sizeof(int32) > MAX_int32)
+		{
+			return Fail(TEXT("layer out of the file"));
+		}
+
+		const uint8* LayerData = Data + Layer.Offset;
+		if (Layer.Type == ELayerType::TileSlots)
+		{
+			TileSlots = MakeArrayView(reinterpret_cast<const int32*>(LayerData),
+				static_cast<int32>(Layer.Size / sizeof(int32)));
+		}
+		else if (Layer.Type == ELayerType::TileWords && Layer.Size % (FWalkabilityGrid::TILE_SIZE * sizeof(uint64)) == 0)
+		{
+			TileWords = MakeArrayView(reinterpret_cast<const uint64*>(LayerData),
+				static_cast<int32>(Layer.Size / sizeof(uint64)));
+		}
+		else if (Layer.Type == ELayerType::CostTileSlots)
+		{
+			CostTileSlots = MakeArrayView(reinterpret_cast<const int32*>(LayerData),
+				static_cast<int32>(Layer.Size / sizeof(int32)));
+		}
+		else if (Layer.Type == ELayerType::CostTiles && Layer.Size <= MAX_int32
+			&& Layer.Size % FWalkabilityGrid::NUM_TILE_CELLS == 0)
+		{
+			CostTiles = MakeArrayView(LayerData, static_cast<int32>(Layer.Size));
+		}
+	}
+
+	const int32 TilesX = (Header.GridSizeX + FWalkabilityGrid::TILE_MASK) >> FWalkabilityGrid::TILE_SHIFT;
+	const int32 TilesY = (Header.GridSizeY + FWalkabilityGrid::TILE_MASK) >> FWalkabilityGrid::TILE_SHIFT;
+	const int32 NumTileSlots = TileWords.Num() / FWalkabilityGrid::TILE_SIZE;
+	if (TileSlots.Num() != TilesX * TilesY || NumTileSlots < FWalkabilityGrid::NUM_UNIFORM_TILES)
+	{
+		return Fail(TEXT("missing walkability layers"));
+	}
+
+	for (const int32 Slot : TileSlots)
+	{
+		if (static_cast<uint32>(Slot) >= static_cast<uint32>(NumTileSlots))
+		{
+			return Fail(TEXT("tile slot out of range"));
+		}
+	}
+
+	for (int32 Row = 0; Row < FWalkabilityGrid::TILE_SIZE; ++Row)
+	{
+		if (TileWords[FWalkabilityGrid::BLOCKED_TILE * FWalkabilityGrid::TILE_SIZE + Row] != 0
+			|| TileWords[FWalkabilityGrid::CROSSABLE_TILE * FWalkabilityGrid::TILE_SIZE + Row] != ~uint64(0))
+		{
+			return Fail(TEXT("invalid uniform tiles"));
+		}
+	}
+
+	OutGrid.InitShared(Header.GridSizeX, Header.GridSizeY, TileSlots, TileWords, Storage);
+	if ((CostTileSlots.Num() > 0 || CostTiles.Num() > 0) && !OutGrid.InitCostTiles(CostTileSlots, CostTiles))
+	{
+		OutGrid.Empty();
+		return Fail(TEXT("invalid cost layers"));
+	}
+	return true;
+}
+
+bool GridFile::ImportMovingAIMap(const FString& FilePath, FWalkabilityGrid& OutGrid)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : Could not read %s"), *FilePath);
+		return false;
+	}
+
+	int64 Position = 0;
+	auto ReadLine = [&Bytes, &Position](int64& OutStart, int64& OutLength)
+	{
+		if (Position >= Bytes.Num())
+		{
+			return false;
+		}
+
+		OutStart = Position;
+		while (Position < Bytes.Num() && Bytes[Position] != '\n')
+		{
+			++Position;
+		}
+		OutLength = Position - OutStart;
+		if (OutLength > 0 && Bytes[OutStart + OutLength - 1] == '\r')
+		{
+			--OutLength;
+		}
+		++Position;
+		return true;
+	};
+
+	// Header lines "type octile", "height H" and "width W" come before the "map" line
+	int64 Width = 0;
+	int64 Height = 0;
+	int64 LineStart, LineLength;
+	while (ReadLine(LineStart, LineLength))
+	{
+		const FString Line(static_cast<int32>(LineLength), reinterpret_cast<const ANSICHAR*>(&Bytes[LineStart]));
+		FString Key, Value;
+		if (!Line.Split(TEXT(" "), &Key, &Value))
+		{
+			Key = Line.TrimEnd();
+		}
+
+		if (Key == TEXT("height"))
+		{
+			Height = FCString::Atoi64(*Value);
+		}
+		else if (Key == TEXT("width"))
+		{
+			Width = FCString::Atoi64(*Value);
+		}
+		else if (Key == TEXT("map"))
+		{
+			break;
+		}
+	}
+
+	if (!FWalkabilityGrid::IsValidSize(Width, Height))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : %s is not a valid MovingAI map, invalid size"), *FilePath);
+		return false;
+	}
+
+	// The first map line is Y = 0
+	TArray<int64> RowStarts;
+	RowStarts.SetNumUninitialized(Height);
+	for (int64 Y = 0; Y < Height; ++Y)
+	{
+		if (!ReadLine(LineStart, LineLength) || LineLength < Width)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("GridFile : %s is not a valid MovingAI map, row %lld is too short"),
+				*FilePath, Y);
+			return false;
+		}
+		RowStarts[Y] = LineStart;
+	}
+
+	const int32 GridSizeX = static_cast<int32>(Width);
+	const int32 GridSizeY = static_cast<int32>(Height);
+	OutGrid.InitTiles(GridSizeX, GridSizeY, [&Bytes, &RowStarts, GridSizeX, GridSizeY](int32 TileX, int32 TileY,
+		uint64* OutRows)
+	{
+		const int32 FirstX = TileX * FWalkabilityGrid::TILE_SIZE;
+		const int32 FirstY = TileY * FWalkabilityGrid::TILE_SIZE;
+		const int32 EndX = FMath::Min(FirstX + FWalkabilityGrid::TILE_SIZE, GridSizeX);
+		const int32 EndY = FMath::Min(FirstY + FWalkabilityGrid::TILE_SIZE, GridSizeY);
+		for (int32 Y = FirstY; Y < EndY; ++Y)
+		{
+			const uint8* Row = &Bytes[RowStarts[Y]];
+			uint64 Bits = 0;
+			for (int32 X = FirstX; X < EndX; ++X)
+			{
+				// Ground, passable terrain and swamp, trees, water and out of bounds cells block
+				const bool bIsCrossable = Row[X] == '.' || Row[X] == 'G' || Row[X] == 'S';
+				Bits |= static_cast<uint64>(bIsCrossable) << (X - FirstX);
+			}
+			OutRows[Y - FirstY] = Bits;
+		}
+	});
+	return true;
+}
+
+bool GridFile::ImportImage(const FString& FilePath, FWalkabilityGrid& OutGrid, float CrossableThreshold)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : Could not read %s"), *FilePath);
+		return false;
+	}
+
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<uint8> GrayLevels;
+	bool bIsDecoded;
+	if (Bytes.Num() >= 2 && Bytes[0] == 'P' && (Bytes[1] == '5' || Bytes[1] == '2'))
+	{
+		bIsDecoded = ParsePgm(Bytes, Width, Height, GrayLevels);
+	}
+	else
+	{
+		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+		const EImageFormat Format = ImageWrapperModule.DetectImageFormat(Bytes.GetData(), Bytes.Num());
+		const TSharedPtr<IImageWrapper> ImageWrapper = Format != EImageFormat::Invalid
+			? ImageWrapperModule.CreateImageWrapper(Format)
+			: nullptr;
+
+		bIsDecoded = ImageWrapper && ImageWrapper->SetCompressed(Bytes.GetData(), Bytes.Num())
+			&& FWalkabilityGrid::IsValidSize(ImageWrapper->GetWidth(), ImageWrapper->GetHeight())
+			&& ImageWrapper->GetRaw(ERGBFormat::Gray, 8, GrayLevels);
+		if (bIsDecoded)
+		{
+			Width = static_cast<int32>(ImageWrapper->GetWidth());
+			Height = static_cast<int32>(ImageWrapper->GetHeight());
+		}
+	}
+
+	// Decoders may return fewer levels than the size they read, BuildFromGrayLevels reads Width * Height of them
+	if (!bIsDecoded || GrayLevels.Num() != static_cast<int64>(Width) * Height)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GridFile : Could not decode the image %s"), *FilePath);
+		return false;
+	}
+
+	// The first image row is Y = 0
+	const uint8 MinCrossableLevel = static_cast<uint8>(FMath::Clamp(FMath::CeilToInt(CrossableThreshold * 255.0f), 0, 255));
+	BuildFromGrayLevels(GrayLevels, Width, Height, MinCrossableLevel, OutGrid);
+	return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WalkabilityGrid.h"
+
+/**
+ * Binary grid files, and importers for maps made outside the editor.
+ * A grid file is a header, a table of layers, then the data of each layer aligned to 8 bytes, little-endian.
+ * The walkability layers are the tile slots and tile words of FWalkabilityGrid as they are laid out in memory,
+ * so a loaded grid reads its cells straight from the mapped file.
+ * Grids with cell costs add the cost tile slots and cost tiles, they are copied into the grid on load.
+ */
+class ASTARPATHFINDING_API GridFile
+{
+public:
+	//////// CONSTANTS ////////
+	/// format constants
+	static constexpr uint32 MAGIC = 0x44524741; // "AGRD"
+	static constexpr uint32 VERSION = 1;
+
+	/** Data stored by a layer, layers of an unknown type are skipped by Load */
+	enum class ELayerType : uint32
+	{
+		TileSlots = 1,
+		TileWords = 2,
+		CostTileSlots = 3,
+		CostTiles = 4
+	};
+
+	//////// METHODS ////////
+	/// binary grid files
+	/** Writes a temporary file next to FilePath then moves it over, a failed save leaves the previous file intact */
+	static bool Save(const FString& FilePath, const FWalkabilityGrid& Grid);
+
+	/** Maps the file, OutGrid reads its tiles from the mapping until its first edit copies them */
+	static bool Load(const FString& FilePath, FWalkabilityGrid& OutGrid);
+
+	/// importers
+	/** MovingAI benchmark map (https://movingai.com/benchmarks/formats.html), '.', 'G' and 'S' are crossable */
+	static bool ImportMovingAIMap(const FString& FilePath, FWalkabilityGrid& OutGrid);
+
+	/**
+	 * Grayscale image, binary or ASCII PGM, or any format ImageWrapper reads such as PNG.
+	 * Pixels at least as bright as CrossableThreshold, from 0 (black) to 1 (white), are crossable.
+	 */
+	static bool ImportImage(const FString& FilePath, FWalkabilityGrid& OutGrid, float CrossableThreshold = 0.5f);
+};
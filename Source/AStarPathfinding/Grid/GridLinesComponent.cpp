@@ -0,0 +1,312 @@
+#include "GridLinesComponent.h"
+#include "ProceduralMeshComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Materials/MaterialInterface.h"
+#include "AStarPathfinding/Solver/PathFinderStats.h"
+#include "UObject/ConstructorHelpers.h"
+
+namespace
+{
+	/** Flat quad facing up, clockwise seen from above */
+	void AddQuad(TArray<FVector>& Vertices, TArray<int32>& Triangles, float X0, float Y0, float X1, float Y1)
+	{
+		const int32 First = Vertices.Num();
+		Vertices.Add(FVector(X0, Y0, 0.0f));
+		Vertices.Add(FVector(X1, Y0, 0.0f));
+		Vertices.Add(FVector(X1, Y1, 0.0f));
+		Vertices.Add(FVector(X0, Y1, 0.0f));
+		Triangles.Append({ First, First + 1, First + 2, First, First + 2, First + 3 });
+	}
+}
+
+UGridLinesComponent::UGridLinesComponent()
+	: LineColor(FLinearColor::Red)
+	, LineThickness(3.0f)
+	, LineMaterial(nullptr)
+	, ChunkSize(128)
+	, CoarseLineStep(8)
+	, CoarseLinesDistance(10000.0f)
+	, HighlightHeight(15.0f)
+	, CoarseLinesMesh(nullptr)
+	, HighlightMesh(nullptr)
+{
+	// Only ticks to follow the camera and to time the highlight
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickInterval = 0.1f;
+
+	static ConstructorHelpers::FObjectFinder<UMaterialInterface> VertexColorMaterialAsset(
+		TEXT("/Engine/EngineDebugMaterials/VertexColorMaterial"));
+	if (VertexColorMaterialAsset.Succeeded())
+	{
+		LineMaterial = VertexColorMaterialAsset.Object;
+	}
+}
+
+void UGridLinesComponent::Build(int32 InGridSizeX, int32 InGridSizeY, float InCellSize, const FVector& Origin)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGridLinesComponent::Build);
+
+	ReleaseChunks();
+	GridSizeX = InGridSizeX;
+	GridSizeY = InGridSizeY;
+	CellSize = InCellSize;
+	NumChunksX = 0;
+	NumChunksY = 0;
+	SetWorldLocationAndRotation(Origin, FRotator::ZeroRotator);
+	if (CoarseLinesMesh)
+	{
+		CoarseLinesMesh->SetVisibility(false);
+	}
+
+	if (GridSizeX <= 0 || GridSizeY <= 0 || !GetWorld())
+	{
+		return;
+	}
+
+	NumChunksX = FMath::DivideAndRoundUp(GridSizeX, ChunkSize);
+	NumChunksY = FMath::DivideAndRoundUp(GridSizeY, ChunkSize);
+	if (CoarseLinesDistance > 0.0f)
+	{
+		// Only the chunks around the camera get every line, here and as it moves, the coarse lines cover the rest
+		if (!CoarseLinesMesh)
+		{
+			CoarseLinesMesh = CreateMesh();
+		}
+		BuildLines(CoarseLinesMesh, 0, 0, GridSizeX, GridSizeY, CoarseLineStep);
+		CoarseLinesMesh->SetVisibility(true);
+		UpdateChunks();
+	}
+	else
+	{
+		for (int32 Chunk = 0; Chunk < NumChunksX * NumChunksY; ++Chunk)
+		{
+			BuildChunk(Chunk);
+		}
+	}
+
+	if (!HighlightMesh)
+	{
+		HighlightMesh = CreateMesh();
+		HighlightMesh->SetVisibility(false);
+	}
+	ClearHighlight();
+	BuildHighlight();
+
+	SetComponentTickEnabled(CoarseLinesDistance > 0.0f || HighlightTimeLeft > 0.0f);
+}
+
+void UGridLinesComponent::HighlightCell(int32 X, int32 Y, const FLinearColor& Color, float Duration)
+{
+	if (!HighlightMesh || X < 0 || X >= GridSizeX || Y < 0 || Y >= GridSizeY)
+	{
+		return;
+	}
+
+	if (Color != HighlightColor)
+	{
+		HighlightColor = Color;
+		BuildHighlight();
+	}
+	HighlightMesh->SetRelativeLocation(FVector(X * CellSize, Y * CellSize, HighlightHeight));
+	HighlightMesh->SetVisibility(true);
+
+	HighlightTimeLeft = FMath::Max(Duration, 0.0f);
+	if (HighlightTimeLeft > 0.0f)
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UGridLinesComponent::ClearHighlight()
+{
+	HighlightTimeLeft = 0.0f;
+	if (HighlightMesh)
+	{
+		HighlightMesh->SetVisibility(false);
+	}
+}
+
+void UGridLinesComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (HighlightTimeLeft > 0.0f)
+	{
+		HighlightTimeLeft -= DeltaTime;
+		if (HighlightTimeLeft <= 0.0f)
+		{
+			ClearHighlight();
+		}
+	}
+
+	UpdateChunks();
+
+	if (CoarseLinesDistance <= 0.0f && HighlightTimeLeft <= 0.0f)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+UProceduralMeshComponent* UGridLinesComponent::CreateMesh()
+{
+	UProceduralMeshComponent* Mesh = NewObject<UProceduralMeshComponent>(GetOwner());
+	Mesh->SetupAttachment(this);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Mesh->SetCastShadow(false);
+	Mesh->SetCanEverAffectNavigation(false);
+	Mesh->RegisterComponent();
+	return Mesh;
+}
+
+void UGridLinesComponent::BuildLines(UProceduralMeshComponent* Mesh, int32 MinX, int32 MinY, int32 MaxX, int32 MaxY,
+	int32 Step) const
+{
+	// A chunk owns the lines on its lower sides, the last chunks of the grid also own the lines closing it
+	const int32 LastX = MaxX == GridSizeX ? MaxX : MaxX - 1;
+	const int32 LastY = MaxY == GridSizeY ? MaxY : MaxY - 1;
+	const float HalfThickness = LineThickness * 0.5f;
+	const auto IsLineShown = [Step](int32 Line, int32 GridSize)
+	{
+		return Line % Step == 0 || Line == GridSize;
+	};
+
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	for (int32 X = MinX; X <= LastX; ++X)
+	{
+		if (IsLineShown(X, GridSizeX))
+		{
+			AddQuad(Vertices, Triangles, X * CellSize - HalfThickness, MinY * CellSize,
+				X * CellSize + HalfThickness, MaxY * CellSize);
+		}
+	}
+	for (int32 Y = MinY; Y <= LastY; ++Y)
+	{
+		if (IsLineShown(Y, GridSizeY))
+		{
+			AddQuad(Vertices, Triangles, MinX * CellSize, Y * CellSize - HalfThickness,
+				MaxX * CellSize, Y * CellSize + HalfThickness);
+		}
+	}
+
+	TArray<FVector> Normals;
+	Normals.Init(FVector::UpVector, Vertices.Num());
+	TArray<FLinearColor> Colors;
+	Colors.Init(LineColor, Vertices.Num());
+	Mesh->CreateMeshSection_LinearColor(0, Vertices, Triangles, Normals, TArray<FVector2D>(), Colors,
+		TArray<FProcMeshTangent>(), false);
+	Mesh->SetMaterial(0, LineMaterial);
+}
+
+void UGridLinesComponent::BuildChunk(int32 Chunk)
+{
+	UProceduralMeshComponent* Mesh = FreeChunkMeshes.Num() > 0
+		? FreeChunkMeshes.Pop(EAllowShrinking::No)
+		: CreateMesh();
+	const int32 MinX = Chunk % NumChunksX * ChunkSize;
+	const int32 MinY = Chunk / NumChunksX * ChunkSize;
+	const int32 MaxX = FMath::Min(MinX + ChunkSize, GridSizeX);
+	const int32 MaxY = FMath::Min(MinY + ChunkSize, GridSizeY);
+	BuildLines(Mesh, MinX, MinY, MaxX, MaxY, 1);
+	Mesh->SetVisibility(true);
+	ChunkMeshes.Add(Chunk, Mesh);
+}
+
+void UGridLinesComponent::ReleaseChunks()
+{
+	for (const TPair<int32, UProceduralMeshComponent*>& ChunkMesh : ChunkMeshes)
+	{
+		ChunkMesh.Value->SetVisibility(false);
+		FreeChunkMeshes.Add(ChunkMesh.Value);
+	}
+	ChunkMeshes.Reset();
+}
+
+void UGridLinesComponent::BuildHighlight()
+{
+	// Outline of a cell starting at the mesh origin, moved over the highlighted cell
+	const float Inner = CellSize * 0.05f;
+	const float Outer = CellSize * 0.95f;
+	const float Thickness = FMath::Min(LineThickness, (Outer - Inner) * 0.5f);
+
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	AddQuad(Vertices, Triangles, Inner, Inner, Outer, Inner + Thickness);
+	AddQuad(Vertices, Triangles, Inner, Outer - Thickness, Outer, Outer);
+	AddQuad(Vertices, Triangles, Inner, Inner + Thickness, Inner + Thickness, Outer - Thickness);
+	AddQuad(Vertices, Triangles, Outer - Thickness, Inner + Thickness, Outer, Outer - Thickness);
+
+	TArray<FVector> Normals;
+	Normals.Init(FVector::UpVector, Vertices.Num());
+	TArray<FLinearColor> Colors;
+	Colors.Init(HighlightColor, Vertices.Num());
+	HighlightMesh->CreateMeshSection_LinearColor(0, Vertices, Triangles, Normals, TArray<FVector2D>(), Colors,
+		TArray<FProcMeshTangent>(), false);
+	HighlightMesh->SetMaterial(0, LineMaterial);
+}
+
+void UGridLinesComponent::UpdateChunks()
+{
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (CoarseLinesDistance <= 0.0f || NumChunksX == 0 || !PlayerController || !PlayerController->PlayerCameraManager)
+	{
+		return;
+	}
+
+	const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation() - GetComponentLocation();
+
+	// Chunks left behind go back to the pool, only the built ones are visited
+	const float SquaredReleaseDistance = FMath::Square(CoarseLinesDistance * CHUNK_RELEASE_FACTOR);
+	for (auto It = ChunkMeshes.CreateIterator(); It; ++It)
+	{
+		if (GetChunkBounds(It.Key()).ComputeSquaredDistanceToPoint(CameraLocation) > SquaredReleaseDistance)
+		{
+			It.Value()->SetVisibility(false);
+			FreeChunkMeshes.Add(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+
+	// Only the chunks under the circle the distance cuts on the grid plane can be close enough
+	const float SquaredBuildDistance = FMath::Square(CoarseLinesDistance);
+	const float SquaredRadius = SquaredBuildDistance - FMath::Square(CameraLocation.Z);
+	if (SquaredRadius < 0.0f)
+	{
+		return;
+	}
+	const float Radius = FMath::Sqrt(SquaredRadius);
+	const float ChunkExtent = ChunkSize * CellSize;
+	const auto GetChunkCoordinate = [ChunkExtent](float Position, int32 NumChunks)
+	{
+		const float Coordinate = FMath::Clamp(Position / ChunkExtent, -1.0f, static_cast<float>(NumChunks));
+		return FMath::Clamp(FMath::FloorToInt(Coordinate), 0, NumChunks - 1);
+	};
+	const int32 MinChunkX = GetChunkCoordinate(CameraLocation.X - Radius, NumChunksX);
+	const int32 MaxChunkX = GetChunkCoordinate(CameraLocation.X + Radius, NumChunksX);
+	const int32 MinChunkY = GetChunkCoordinate(CameraLocation.Y - Radius, NumChunksY);
+	const int32 MaxChunkY = GetChunkCoordinate(CameraLocation.Y + Radius, NumChunksY);
+	for (int32 ChunkY = MinChunkY; ChunkY <= MaxChunkY; ++ChunkY)
+	{
+		for (int32 ChunkX = MinChunkX; ChunkX <= MaxChunkX; ++ChunkX)
+		{
+			const int32 Chunk = ChunkY * NumChunksX + ChunkX;
+			if (!ChunkMeshes.Contains(Chunk)
+				&& GetChunkBounds(Chunk).ComputeSquaredDistanceToPoint(CameraLocation) <= SquaredBuildDistance)
+			{
+				BuildChunk(Chunk);
+			}
+		}
+	}
+}
+
+FBox UGridLinesComponent::GetChunkBounds(int32 Chunk) const
+{
+	const int32 MinX = Chunk % NumChunksX * ChunkSize;
+	const int32 MinY = Chunk / NumChunksX * ChunkSize;
+	return FBox(FVector(MinX * CellSize, MinY * CellSize, 0.0f),
+		FVector(FMath::Min(MinX + ChunkSize, GridSizeX) * CellSize, FMath::Min(MinY + ChunkSize, GridSizeY) * CellSize,
+			0.0f));
+}
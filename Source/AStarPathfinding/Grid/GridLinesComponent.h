@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "GridLinesComponent.generated.h"
+
+class UMaterialInterface;
+class UProceduralMeshComponent;
+
+/**
+ * Lines of the grid as flat quads in procedural meshes. One mesh holds every CoarseLineStep-th line of the whole grid,
+ * each spanning it in a single quad. Every line is only built around the camera, in chunks of ChunkSize x ChunkSize
+ * cells made when the camera comes within CoarseLinesDistance of them and released past a margin, their meshes are
+ * kept for the next chunks. The cost of the lines thus follows the view and not the size of the grid.
+ * One cell can be highlighted with an outline moved over it, without rebuilding the lines.
+ */
+UCLASS(ClassGroup = (Grid), meta = (BlueprintSpawnableComponent))
+class ASTARPATHFINDING_API UGridLinesComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	//////// CONSTRUCTOR ////////
+	UGridLinesComponent();
+
+	//////// FIELDS ////////
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Lines")
+	FLinearColor LineColor;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Lines")
+	float LineThickness;
+
+	/** Reading the vertex colors, the engine vertex color material by default */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Lines")
+	UMaterialInterface* LineMaterial;
+
+	/** Cells per side of a chunk, a chunk of every line is built, culled and released as a whole */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Lines", meta = (ClampMin = "1"))
+	int32 ChunkSize;
+
+	/** Only every CoarseLineStep-th line is kept by the coarse lines of the whole grid */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Lines", meta = (ClampMin = "1"))
+	int32 CoarseLineStep;
+
+	/** Distance from the camera to a chunk below which it shows every line, 0 builds every chunk up front */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Lines", meta = (ClampMin = "0"))
+	float CoarseLinesDistance;
+
+	/** Height of the highlight outline above the grid, over the path node meshes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Lines")
+	float HighlightHeight;
+
+	//////// METHODS ////////
+	/** Builds the lines of a grid whose cell (0, 0) starts at Origin, replaces the previous grid */
+	void Build(int32 InGridSizeX, int32 InGridSizeY, float InCellSize, const FVector& Origin);
+
+	/** Outlines a cell for Duration seconds, a duration of 0 or less keeps it until the next highlight */
+	void HighlightCell(int32 X, int32 Y, const FLinearColor& Color, float Duration);
+	void ClearHighlight();
+
+	//////// OVERRIDES ////////
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+		FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	//////// FIELDS ////////
+	/// chunks are released this many times CoarseLinesDistance away, so the ones on the edge are not rebuilt each tick
+	static constexpr float CHUNK_RELEASE_FACTOR = 1.5f;
+
+	/// built chunks by index, row by row, and the hidden meshes of the released ones
+	UPROPERTY(Transient)
+	TMap<int32, UProceduralMeshComponent*> ChunkMeshes;
+	UPROPERTY(Transient)
+	TArray<UProceduralMeshComponent*> FreeChunkMeshes;
+	UPROPERTY(Transient)
+	UProceduralMeshComponent* CoarseLinesMesh;
+	UPROPERTY(Transient)
+	UProceduralMeshComponent* HighlightMesh;
+
+	int32 GridSizeX = 0;
+	int32 GridSizeY = 0;
+	int32 NumChunksX = 0;
+	int32 NumChunksY = 0;
+	float CellSize = 0.0f;
+	float HighlightTimeLeft = 0.0f;
+	FLinearColor HighlightColor = FLinearColor::Green;
+
+	//////// METHODS ////////
+	UProceduralMeshComponent* CreateMesh();
+	void BuildLines(UProceduralMeshComponent* Mesh, int32 MinX, int32 MinY, int32 MaxX, int32 MaxY, int32 Step) const;
+	void BuildChunk(int32 Chunk);
+	void ReleaseChunks();
+	void BuildHighlight();
+	void UpdateChunks();
+	/// box of the chunk relative to the grid origin
+	FBox GetChunkBounds(int32 Chunk) const;
+};
@@ -1,16 +1,51 @@
 ﻿#include "GridManager.h"
-#include "DrawDebugHelpers.h"
+#include "GridFile.h"
+#include "GridNodeMaterialSubsystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Misc/Paths.h"
+#include "AStarPathfinding/Solver/AnyAnglePathFinder.h"
+#include "AStarPathfinding/Solver/JumpPointFinder.h"
 #include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderStats.h"
 
 AGridManager::AGridManager()
     : GridSizeX(DEFAULT_GRID_SIZE)
       , GridSizeY(DEFAULT_GRID_SIZE)
       , CellSize(DEFAULT_CELL_SIZE)
+      , SolverMode(ESolverMode::AStar)
+      , OpenListType(EOpenListType::BinaryHeap)
+      , ClusterSize(FHierarchicalGraph::DEFAULT_CLUSTER_SIZE)
+      , bUseAsyncPathfinding(true)
+      , bSmoothPaths(false)
+      , bRejectUnreachablePaths(true)
+      , bPathToNearestReachableCell(false)
+      , PathCacheBudgetKB(1024)
+      , bUseInstancedWalls(false)
+      , MaxPooledNodeActors(256)
       , InteractionDistance(0), InteractionRate(0), CurrentPlacementType(), LastHighlightedNodeX(-1)
       , LastHighlightedNodeY(-1)
       , bHasHighlightedNode(false), StartNode(nullptr), GoalNode(nullptr)
 {
-    PrimaryActorTick.bCanEverTick = false;
+    // Only ticks while a replan or path requests are pending, to run it and deliver their results
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
+
+    SearchVisualization = CreateDefaultSubobject<USearchVisualizationComponent>(TEXT("SearchVisualization"));
+    RootComponent = SearchVisualization;
+    GridLines = CreateDefaultSubobject<UGridLinesComponent>(TEXT("GridLines"));
+    GridLines->SetupAttachment(RootComponent);
+
+    WallInstances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("WallInstances"));
+    WallInstances->SetupAttachment(RootComponent);
+    WallInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMeshAsset(TEXT("/Engine/BasicShapes/Cube"));
+    if (CubeMeshAsset.Succeeded())
+    {
+        WallInstances->SetStaticMesh(CubeMeshAsset.Object);
+    }
+
+    // Explored cells are part of what the grid displays
+    DisplayedResult.ExploredCapture = EExploredCapture::Indices;
 }
 
 bool AGridManager::StaticIsValidPos(int32 X, int32 Y, int32 GridSizeX, int32 GridSizeY)
@@ -35,21 +70,7 @@ void AGridManager::DebugDrawCell(int32 X, int32 Y, FColor Color, float Duration)
         return;
     }
 
-    FVector BoxPosition = GetWorldPositionFromCell(X, Y);
-    BoxPosition += FVector(0.0f, 0.0f, CellSize * 0.5f);
-    FVector Extent(CellSize * 0.45f, CellSize * 0.45f, 50.0f);
-    
-    DrawDebugBox(
-        GetWorld(),
-        BoxPosition,
-        Extent,
-        Color,
-        false,
-        Duration,
-        0,
-        2.0f
-    );
-
+    GridLines->HighlightCell(X, Y, FLinearColor(Color), Duration);
     UpdateHighlightedCell(X, Y);
 }
 
@@ -76,7 +97,8 @@ EGridActorType AGridManager::GetNodeTypeAtPosition(const FVector& WorldPosition)
         return EGridActorType::Goal;
     }
     
-    if (WallNodes.Contains(FIntPoint(GridX, GridY)))
+    // Walls loaded from a file have no actor
+    if (!IsNodeCrossable(GridX, GridY))
     {
         return EGridActorType::Wall;
     }
@@ -100,32 +122,47 @@ bool AGridManager::ToggleNodeActorInGrid(const FVector& WorldPosition)
         return false;
     }
 
+    // Moving the start or goal node changes two cells, they are committed as one edit
+    BeginGridEdit();
+    const bool bIsToggled = ToggleNodeActorAtCell(GridX, GridY);
+    CommitGridEdit();
+    return bIsToggled;
+}
+
+bool AGridManager::ToggleNodeActorAtCell(int32 GridX, int32 GridY)
+{
     FIntPoint Point(GridX, GridY);
     
-    EGridActorType ExistingType = GetNodeTypeAtPosition(WorldPosition);
+    EGridActorType ExistingType = GetNodeTypeAtPosition(GetWorldPositionFromCell(GridX, GridY));
     if (ExistingType == CurrentPlacementType)
     {
         RemoveExistingNodeActorAtCell(GridX, GridY);
-        OnGridChanged.Broadcast();
-        UpdatePathfinding();
         return true;
     }
     
     RemoveExistingNodeActorAtCell(GridX, GridY);
-    GetNode(GridX, GridY).IsCrossable = true;
+    SetNodeCrossable(GridX, GridY, true);
     
     TSubclassOf<AGridNodeActorBase> ClassToSpawn = nullptr;
     switch (CurrentPlacementType)
     {
     case EGridActorType::Start:
-        if (StartNode) StartNode->Destroy();
+        ReleaseNodeActor(StartNode);
+        StartNode = nullptr;
         ClassToSpawn = StartNodeClass;
         break;
     case EGridActorType::Goal:
-        if (GoalNode) GoalNode->Destroy();
+        ReleaseNodeActor(GoalNode);
+        GoalNode = nullptr;
         ClassToSpawn = GoalNodeClass;
         break;
     case EGridActorType::Wall:
+        if (bUseInstancedWalls)
+        {
+            AddWallInstance(GridX, GridY);
+            SetNodeCrossable(GridX, GridY, false);
+            return true;
+        }
         ClassToSpawn = WallNodeClass;
         break;
     default:
@@ -139,21 +176,393 @@ bool AGridManager::ToggleNodeActorInGrid(const FVector& WorldPosition)
     {
     case EGridActorType::Start:
         StartNode = NewActor;
+        MarkCellEdited(GridX, GridY);
         break;
     case EGridActorType::Goal:
         GoalNode = NewActor;
+        MarkCellEdited(GridX, GridY);
         break;
     case EGridActorType::Wall:
         WallNodes.Add(Point, NewActor);
-        GetNode(GridX, GridY).IsCrossable = false;
+        SetNodeCrossable(GridX, GridY, false);
         break;
     }
 
+    return true;
+}
+
+void AGridManager::BeginGridEdit()
+{
+    ++GridEditDepth;
+}
+
+void AGridManager::CommitGridEdit()
+{
+    if (GridEditDepth == 0 || --GridEditDepth > 0)
+    {
+        return;
+    }
+
+    ApplyPendingCells();
+    if (EditMinCell.X > EditMaxCell.X)
+    {
+        return;
+    }
+
+    // Cleared first, listeners may start another edit
+    const FIntPoint MinCell = EditMinCell;
+    const FIntPoint MaxCell = EditMaxCell;
+    EditMinCell = FIntPoint(MAX_int32, MAX_int32);
+    EditMaxCell = FIntPoint(MIN_int32, MIN_int32);
+
+    OnGridRegionChanged.Broadcast(MinCell, MaxCell);
     OnGridChanged.Broadcast();
-    UpdatePathfinding();
+    RequestPathfindingUpdate();
+}
+
+void AGridManager::SetWallAtCell(FIntPoint Cell, bool bIsWall)
+{
+    const int32 X = Cell.X;
+    const int32 Y = Cell.Y;
+    if (!IsValidPos(X, Y) || IsNodeCrossable(X, Y) != bIsWall)
+    {
+        return;
+    }
+
+    if ((StartNode && StartNode->GridX == X && StartNode->GridY == Y)
+        || (GoalNode && GoalNode->GridX == X && GoalNode->GridY == Y))
+    {
+        return;
+    }
+
+    BeginGridEdit();
+    if (!bIsWall)
+    {
+        RemoveExistingNodeActorAtCell(X, Y);
+    }
+    else
+    {
+        if (bUseInstancedWalls)
+        {
+            AddWallInstance(X, Y);
+        }
+        else if (AGridNodeActorBase* NewWall = SpawnNodeActor(WallNodeClass, X, Y))
+        {
+            WallNodes.Add(Cell, NewWall);
+        }
+        SetNodeCrossable(X, Y, false);
+    }
+    CommitGridEdit();
+}
+
+void AGridManager::SetWallsInRect(FIntPoint CornerA, FIntPoint CornerB, bool bIsWall)
+{
+    const int32 MinX = FMath::Max(FMath::Min(CornerA.X, CornerB.X), 0);
+    const int32 MinY = FMath::Max(FMath::Min(CornerA.Y, CornerB.Y), 0);
+    const int32 MaxX = FMath::Min(FMath::Max(CornerA.X, CornerB.X), GridSizeX - 1);
+    const int32 MaxY = FMath::Min(FMath::Max(CornerA.Y, CornerB.Y), GridSizeY - 1);
+
+    BeginGridEdit();
+    for (int32 Y = MinY; Y <= MaxY; ++Y)
+    {
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            SetWallAtCell(FIntPoint(X, Y), bIsWall);
+        }
+    }
+    CommitGridEdit();
+}
+
+void AGridManager::SetWallsAlongLine(FIntPoint From, FIntPoint To, bool bIsWall)
+{
+    // Only the part over the grid is walked, the endpoints may be anywhere in int32
+    if (!ClipLineToGrid(From, To))
+    {
+        return;
+    }
+
+    // Bresenham, with the diagonal steps split in two since diagonal moves cut corners between walls
+    const int64 DeltaX = FMath::Abs(static_cast<int64>(To.X) - From.X);
+    const int64 DeltaY = -FMath::Abs(static_cast<int64>(To.Y) - From.Y);
+    const int32 StepX = From.X < To.X ? 1 : -1;
+    const int32 StepY = From.Y < To.Y ? 1 : -1;
+    int64 Error = DeltaX + DeltaY;
+    FIntPoint Cell = From;
+
+    BeginGridEdit();
+    while (true)
+    {
+        SetWallAtCell(Cell, bIsWall);
+        if (Cell == To)
+        {
+            break;
+        }
+
+        const int64 DoubleError = 2 * Error;
+        const bool bStepsX = DoubleError >= DeltaY;
+        const bool bStepsY = DoubleError <= DeltaX;
+        if (bStepsX)
+        {
+            Error += DeltaY;
+            Cell.X += StepX;
+        }
+        if (bStepsY)
+        {
+            if (bStepsX)
+            {
+                SetWallAtCell(Cell, bIsWall);
+            }
+            Error += DeltaX;
+            Cell.Y += StepY;
+        }
+    }
+    CommitGridEdit();
+}
+
+bool AGridManager::ClipLineToGrid(FIntPoint& InOutFrom, FIntPoint& InOutTo) const
+{
+    if (GridSizeX <= 0 || GridSizeY <= 0)
+    {
+        return false;
+    }
+
+    // Liang-Barsky: the segment is From + T * Delta, each side of the grid box bounds T from below or above
+    const double FromX = InOutFrom.X;
+    const double FromY = InOutFrom.Y;
+    const double DeltaX = static_cast<double>(InOutTo.X) - FromX;
+    const double DeltaY = static_cast<double>(InOutTo.Y) - FromY;
+    const double Directions[] = { -DeltaX, DeltaX, -DeltaY, DeltaY };
+    const double Distances[] = { FromX, GridSizeX - 1 - FromX, FromY, GridSizeY - 1 - FromY };
+
+    double EnterT = 0.0;
+    double ExitT = 1.0;
+    for (int32 Side = 0; Side < UE_ARRAY_COUNT(Directions); ++Side)
+    {
+        if (Directions[Side] == 0.0)
+        {
+            if (Distances[Side] < 0.0)
+            {
+                return false; // Parallel to the side and outside it
+            }
+            continue;
+        }
+
+        const double T = Distances[Side] / Directions[Side];
+        if (Directions[Side] < 0.0)
+        {
+            EnterT = FMath::Max(EnterT, T);
+        }
+        else
+        {
+            ExitT = FMath::Min(ExitT, T);
+        }
+    }
+    if (EnterT > ExitT)
+    {
+        return false;
+    }
+
+    // Rounding can land a hair outside the box, the clamp keeps both ends on the grid
+    InOutFrom = FIntPoint(
+        FMath::Clamp(FMath::RoundToInt32(FromX + EnterT * DeltaX), 0, GridSizeX - 1),
+        FMath::Clamp(FMath::RoundToInt32(FromY + EnterT * DeltaY), 0, GridSizeY - 1));
+    InOutTo = FIntPoint(
+        FMath::Clamp(FMath::RoundToInt32(FromX + ExitT * DeltaX), 0, GridSizeX - 1),
+        FMath::Clamp(FMath::RoundToInt32(FromY + ExitT * DeltaY), 0, GridSizeY - 1));
     return true;
 }
 
+void AGridManager::SetWallsInCircle(FIntPoint Center, int32 Radius, bool bIsWall)
+{
+    if (Radius < 0)
+    {
+        return;
+    }
+    Radius = FMath::Min(Radius, GridSizeX + GridSizeY);
+
+    // Center may be anywhere in int32, a center farther than Radius from the grid has no cell on it. The bounds below
+    // are computed in int64 and clamped to the grid before they go back to int32
+    const int64 CenterX = Center.X;
+    const int64 CenterY = Center.Y;
+    if (CenterX < -Radius || CenterX > GridSizeX - 1 + static_cast<int64>(Radius)
+        || CenterY < -Radius || CenterY > GridSizeY - 1 + static_cast<int64>(Radius))
+    {
+        return;
+    }
+
+    const int32 MinY = static_cast<int32>(FMath::Max<int64>(CenterY - Radius, 0));
+    const int32 MaxY = static_cast<int32>(FMath::Min<int64>(CenterY + Radius, GridSizeY - 1));
+    const int64 RadiusSquared = static_cast<int64>(Radius) * Radius;
+
+    BeginGridEdit();
+    for (int32 Y = MinY; Y <= MaxY; ++Y)
+    {
+        // Half width of the row, the cells of a row are contiguous
+        const int64 DeltaY = Y - CenterY;
+        const int64 HalfWidth = static_cast<int64>(FMath::Sqrt(static_cast<double>(RadiusSquared - DeltaY * DeltaY)));
+        const int32 MinX = static_cast<int32>(FMath::Max<int64>(CenterX - HalfWidth, 0));
+        const int32 MaxX = static_cast<int32>(FMath::Min<int64>(CenterX + HalfWidth, GridSizeX - 1));
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            SetWallAtCell(FIntPoint(X, Y), bIsWall);
+        }
+    }
+    CommitGridEdit();
+}
+
+void AGridManager::MarkCellEdited(int32 X, int32 Y)
+{
+    if (GridEditDepth == 0 || !IsValidPos(X, Y))
+    {
+        return;
+    }
+
+    EditMinCell = FIntPoint(FMath::Min(EditMinCell.X, X), FMath::Min(EditMinCell.Y, Y));
+    EditMaxCell = FIntPoint(FMath::Max(EditMaxCell.X, X), FMath::Max(EditMaxCell.Y, Y));
+}
+
+void AGridManager::MarkGridEdited()
+{
+    if (GridEditDepth == 0 || GridSizeX <= 0 || GridSizeY <= 0)
+    {
+        return;
+    }
+
+    EditMinCell = FIntPoint(0, 0);
+    EditMaxCell = FIntPoint(GridSizeX - 1, GridSizeY - 1);
+}
+
+void AGridManager::ApplyPendingCells()
+{
+    if (PendingCells.Num() == 0)
+    {
+        return;
+    }
+
+    // Costs are only read by A* and the path cache, the other derived data only count walkability changes
+    int64 NumCrossableChanges = 0;
+    for (const TPair<FIntPoint, FPendingCell>& Cell : PendingCells)
+    {
+        NumCrossableChanges += Cell.Value.ChangesCrossable();
+    }
+
+    // Labels are joined and split against the grid one cell at a time, so each cell is patched right after its write
+    const int64 NumCells = static_cast<int64>(GridSizeX) * GridSizeY;
+    const bool bPatchesComponents = ConnectedComponents.IsBuiltFor(GridSizeX, GridSizeY)
+        && NumCrossableChanges * COMPONENTS_REBUILD_DIVISOR <= NumCells;
+    const uint8 PreviousMinCellCost = Grid.GetMinCellCost();
+
+    // Workers copy the grid under the read lock, the revision tells them their copy is stale
+    {
+        FWriteScopeLock WriteLock(PathRequestQueue.GetGridLock());
+        for (const TPair<FIntPoint, FPendingCell>& Cell : PendingCells)
+        {
+            if (Cell.Value.Cost != Cell.Value.PreviousCost)
+            {
+                Grid.SetCellCost(Cell.Key.X, Cell.Key.Y, Cell.Value.Cost);
+            }
+            if (Cell.Value.ChangesCrossable())
+            {
+                Grid.SetCrossable(Cell.Key.X, Cell.Key.Y, Cell.Value.bIsCrossable);
+                if (bPatchesComponents)
+                {
+                    ConnectedComponents.UpdateCell(Grid, Cell.Key.X, Cell.Key.Y);
+                }
+            }
+        }
+        PathRequestQueue.MarkGridChanged();
+    }
+    if (!bPatchesComponents && NumCrossableChanges > 0)
+    {
+        ConnectedComponents.Empty();
+    }
+
+    // Cached paths bound their detours with the cheapest cost, a new minimum invalidates every bound
+    bool bPatchesPathCache = true;
+    if (Grid.GetMinCellCost() < PreviousMinCellCost)
+    {
+        PathCache.Reset();
+        bPatchesPathCache = false;
+    }
+
+    // Patching a cell of the other derived data costs about a row and a column of the grid, past that many cells the
+    // next queries rebuild them for less
+    if (NumCrossableChanges * (GridSizeX + GridSizeY) > NumCells)
+    {
+        JumpPointTable.Empty();
+        HierarchicalGraph.Empty();
+        IncrementalPathFinder.Empty();
+        FlowField.Empty();
+        PathCache.Reset();
+        PendingCells.Reset();
+        return;
+    }
+
+    for (const TPair<FIntPoint, FPendingCell>& Cell : PendingCells)
+    {
+        const int32 X = Cell.Key.X;
+        const int32 Y = Cell.Key.Y;
+        const FPendingCell& Change = Cell.Value;
+
+        // A cheaper cell may shorten the paths around it, a dearer one lengthens the paths crossing it
+        if (bPatchesPathCache && Change.Cost != Change.PreviousCost)
+        {
+            if (Change.Cost < Change.PreviousCost)
+            {
+                PathCache.InvalidateImprovedCell(X, Y);
+            }
+            else
+            {
+                PathCache.InvalidateWorsenedCell(X, Y);
+            }
+        }
+
+        if (!Change.ChangesCrossable())
+        {
+            continue;
+        }
+
+        // Only the jump distances around the cell change, the table is patched instead of rebuilt
+        if (JumpPointTable.IsBuiltFor(GridSizeX, GridSizeY))
+        {
+            JumpPointTable.UpdateCell(Grid, X, Y);
+        }
+
+        // Clusters around the cell are rebuilt by the next hierarchical query
+        if (HierarchicalGraph.IsBuiltFor(GridSizeX, GridSizeY, ClusterSize))
+        {
+            HierarchicalGraph.MarkCellDirty(X, Y);
+        }
+
+        // The incremental solver repairs its costs around the cell on its next query
+        if (IncrementalPathFinder.IsInitialized())
+        {
+            IncrementalPathFinder.NotifyCellChanged(X, Y);
+        }
+
+        // The field keeps its own walkability, each cell is diffed against it and only its costs are recomputed
+        if (FlowField.IsBuilt())
+        {
+            FlowField.UpdateCell(Grid, X, Y);
+        }
+
+        // A wall only evicts the paths running next to it, an opening the paths it could shorten
+        if (!bPatchesPathCache)
+        {
+            continue;
+        }
+        if (Change.bIsCrossable)
+        {
+            PathCache.InvalidateImprovedCell(X, Y);
+        }
+        else
+        {
+            PathCache.InvalidateWorsenedCell(X, Y);
+        }
+    }
+    PendingCells.Reset();
+}
+
 void AGridManager::BeginPlay()
 {
     Super::BeginPlay();
@@ -161,11 +570,36 @@ void AGridManager::BeginPlay()
     GridOrigin = FVector::ZeroVector;
     Initialize();
     DrawGrid();
+
+    if (UGridNodeMaterialSubsystem* MaterialSubsystem = GetWorld()->GetSubsystem<UGridNodeMaterialSubsystem>())
+    {
+        WallInstances->SetMaterial(0,
+            MaterialSubsystem->GetNodeMaterial(AGridNodeActorBase::GetNodeTypeColor(EGridActorType::Wall)));
+    }
 }
 
 void AGridManager::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
+
+    if (bIsPathfindingUpdatePending)
+    {
+        bIsPathfindingUpdatePending = false;
+        UpdatePathfinding();
+    }
+
+    PathRequestQueue.DeliverCompletedRequests();
+    if (PathRequestQueue.GetNumPending() == 0 && !bIsPathfindingUpdatePending)
+    {
+        SetActorTickEnabled(false);
+    }
+}
+
+void AGridManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Running searches read the grid, they are waited for before it goes away
+    PathRequestQueue.CancelAll();
+    Super::EndPlay(EndPlayReason);
 }
 
 int32 AGridManager::GetIndexFromXY(int32 X, int32 Y) const
@@ -178,42 +612,80 @@ bool AGridManager::IsValidPos(int32 X, int32 Y) const
     return StaticIsValidPos(X, Y, GridSizeX, GridSizeY);
 }
 
-FGridNode& AGridManager::GetNode(int32 X, int32 Y)
+void AGridManager::SetNodeCrossable(int32 X, int32 Y, bool bIsCrossable)
+{
+    if (IsNodeCrossable(X, Y) == bIsCrossable)
+    {
+        return;
+    }
+
+    // The cell is written and the derived data patched by the commit, once for the whole edit
+    BeginGridEdit();
+    MarkCellEdited(X, Y);
+    FPendingCell& PendingCell = FindOrAddPendingCell(X, Y);
+    PendingCell.bIsCrossable = bIsCrossable;
+    if (PendingCell.IsUnchanged())
+    {
+        PendingCells.Remove(FIntPoint(X, Y));
+    }
+    CommitGridEdit();
+}
+
+bool AGridManager::IsNodeCrossable(int32 X, int32 Y) const
+{
+    const FPendingCell* PendingCell = PendingCells.Find(FIntPoint(X, Y));
+    return PendingCell ? PendingCell->bIsCrossable : Grid.IsCrossable(X, Y);
+}
+
+uint8 AGridManager::GetPendingCellCost(int32 X, int32 Y) const
 {
-    return Grid[GetIndexFromXY(X, Y)];
+    const FPendingCell* PendingCell = PendingCells.Find(FIntPoint(X, Y));
+    return PendingCell ? PendingCell->Cost : Grid.GetCellCost(X, Y);
+}
+
+AGridManager::FPendingCell& AGridManager::FindOrAddPendingCell(int32 X, int32 Y)
+{
+    if (FPendingCell* PendingCell = PendingCells.Find(FIntPoint(X, Y)))
+    {
+        return *PendingCell;
+    }
+
+    const bool bIsCrossable = Grid.IsCrossable(X, Y);
+    const uint8 Cost = Grid.GetCellCost(X, Y);
+    return PendingCells.Add(FIntPoint(X, Y), { bIsCrossable, bIsCrossable, Cost, Cost });
 }
 
 void AGridManager::Initialize()
 {
     GridOrigin = FVector::ZeroVector;
     
-    const int32 GridSize = GridSizeX * GridSizeY;
-    Grid.Empty(GridSize);
-    Grid.SetNum(GridSize);
-    
-    for (int32 y = 0; y < GridSizeY; y++)
+    PathRequestQueue.CancelAll();
+    PendingCells.Reset();
+    JumpPointTable.Empty();
+    HierarchicalGraph.Empty();
+    IncrementalPathFinder.Empty();
+    FlowField.Empty();
+    ConnectedComponents.Empty();
+    PathCache.Reset();
+
+    // Solvers index cells with int32, larger grids are clamped instead of overflowing
+    if (!FWalkabilityGrid::IsValidSize(GridSizeX, GridSizeY))
     {
-        const float YPos = GridOrigin.Y + (y * CellSize);
-        
-        for (int32 x = 0; x < GridSizeX; x++)
-        {
-            FGridNode& Node = GetNode(x, y);
-            Node.WorldPosition = FVector(
-                GridOrigin.X + (x * CellSize),
-                YPos,
-                GridOrigin.Z
-            );
-            Node.IsCrossable = true;
-        }
-    };
-}
+        UE_LOG(LogTemp, Warning, TEXT("GridManager : a %d x %d grid is too large or empty, clamped"), GridSizeX,
+            GridSizeY);
+        GridSizeX = FMath::Clamp(GridSizeX, 1, FWalkabilityGrid::MAX_GRID_SIZE);
+        GridSizeY = FMath::Clamp(GridSizeY, 1,
+            FMath::Min(FWalkabilityGrid::MAX_GRID_SIZE, static_cast<int32>(FWalkabilityGrid::MAX_NUM_CELLS / GridSizeX)));
+    }
 
-void AGridManager::ClearDebugLines()
-{
-    if (GetWorld())
+    // World positions are derived from GridOrigin and CellSize, the grid only stores walkability.
+    // Requests submitted by the callbacks CancelAll ran may already be reading it.
     {
-        FlushPersistentDebugLines(GetWorld());
+        FWriteScopeLock WriteLock(PathRequestQueue.GetGridLock());
+        Grid.Init(GridSizeX, GridSizeY);
     }
+
+    PathRequestQueue.SetGrid(&Grid, CellSize);
 }
 
 bool AGridManager::IsNodeAlreadyHighlighted(int32 X, int32 Y) const
@@ -247,14 +719,14 @@ void AGridManager::RemoveExistingNodeActorAtCell(int32 X, int32 Y)
 {
     if (StartNode && StartNode->GridX == X && StartNode->GridY == Y)
     {
-        StartNode->Destroy();
+        ReleaseNodeActor(StartNode);
         StartNode = nullptr;
         return;
     }
     
     if (GoalNode && GoalNode->GridX == X && GoalNode->GridY == Y)
     {
-        GoalNode->Destroy();
+        ReleaseNodeActor(GoalNode);
         GoalNode = nullptr;
         return;
     }
@@ -262,10 +734,29 @@ void AGridManager::RemoveExistingNodeActorAtCell(int32 X, int32 Y)
     FIntPoint Point(X, Y);
     if (AGridNodeActorBase* ExistingWall = WallNodes.FindRef(Point))
     {
-        ExistingWall->Destroy();
+        ReleaseNodeActor(ExistingWall);
         WallNodes.Remove(Point);
-        GetNode(X, Y).IsCrossable = true;
     }
+    RemoveWallInstance(X, Y);
+    SetNodeCrossable(X, Y, true);
+}
+
+void AGridManager::RemoveAllNodeActors()
+{
+    ReleaseNodeActor(StartNode);
+    StartNode = nullptr;
+    ReleaseNodeActor(GoalNode);
+    GoalNode = nullptr;
+
+    for (auto& Pair : WallNodes)
+    {
+        ReleaseNodeActor(Pair.Value);
+    }
+    WallNodes.Empty();
+    WallInstances->ClearInstances();
+    WallInstanceCells.Reset();
+    WallInstanceByCell.Reset();
+    ClearPathNodes();
 }
 
 AGridNodeActorBase* AGridManager::SpawnNodeActor(TSubclassOf<AGridNodeActorBase> ActorClass, int32 X, int32 Y)
@@ -278,7 +769,26 @@ AGridNodeActorBase* AGridManager::SpawnNodeActor(TSubclassOf<AGridNodeActorBase>
     FVector Location = GetWorldPositionFromCell(X, Y);
     FTransform SpawnTransform(FRotator::ZeroRotator, Location);
 
-    AGridNodeActorBase* NewActor = GetWorld()->SpawnActor<AGridNodeActorBase>(ActorClass, SpawnTransform);
+    // A pooled actor of the class is shown again instead of spawning one
+    AGridNodeActorBase* NewActor = nullptr;
+    const int32 PooledIndex = PooledNodeActors.FindLastByPredicate([&ActorClass](const AGridNodeActorBase* NodeActor)
+    {
+        return IsValid(NodeActor) && NodeActor->GetClass() == ActorClass;
+    });
+    if (PooledIndex != INDEX_NONE)
+    {
+        NewActor = PooledNodeActors[PooledIndex];
+        PooledNodeActors.RemoveAtSwap(PooledIndex, 1, EAllowShrinking::No);
+        NewActor->SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+        NewActor->SetActorHiddenInGame(false);
+        NewActor->SetActorEnableCollision(true);
+        NewActor->SetupNodeColor(NewActor->NodeType);
+    }
+    else
+    {
+        NewActor = GetWorld()->SpawnActor<AGridNodeActorBase>(ActorClass, SpawnTransform);
+    }
+
     if (NewActor)
     {
         NewActor->GridX = X;
@@ -288,112 +798,696 @@ AGridNodeActorBase* AGridManager::SpawnNodeActor(TSubclassOf<AGridNodeActorBase>
     return NewActor;
 }
 
-void AGridManager::SpawnPathNode(int32 X, int32 Y, bool bIsFinalPath)
+void AGridManager::ReleaseNodeActor(AGridNodeActorBase* NodeActor)
 {
-    if (GetNodeActorAtCell(X, Y) != nullptr)
+    if (!IsValid(NodeActor))
     {
         return;
     }
 
-    FIntPoint Point(X, Y);
-    
-    if (APathNodeActor* ExistingNode = Cast<APathNodeActor>(PathNodes.FindRef(Point)))
+    // The cell the node leaves changes too, for the start and goal nodes
+    MarkCellEdited(NodeActor->GridX, NodeActor->GridY);
+
+    if (PooledNodeActors.Num() >= MaxPooledNodeActors)
+    {
+        NodeActor->Destroy();
+        return;
+    }
+
+    NodeActor->SetActorHiddenInGame(true);
+    NodeActor->SetActorEnableCollision(false);
+    NodeActor->GridX = INDEX_NONE;
+    NodeActor->GridY = INDEX_NONE;
+    PooledNodeActors.Add(NodeActor);
+}
+
+void AGridManager::AddWallInstance(int32 X, int32 Y)
+{
+    const int32 Cell = GetIndexFromXY(X, Y);
+    if (WallInstanceByCell.Contains(Cell))
+    {
+        return;
+    }
+
+    const FTransform Transform(FQuat::Identity, GetWorldPositionFromCell(X, Y), FVector(0.95f, 0.95f, 0.2f));
+    WallInstanceByCell.Add(Cell, WallInstances->AddInstance(Transform, true));
+    WallInstanceCells.Add(Cell);
+}
+
+void AGridManager::RemoveWallInstance(int32 X, int32 Y)
+{
+    int32 Instance;
+    if (!WallInstanceByCell.RemoveAndCopyValue(GetIndexFromXY(X, Y), Instance))
     {
-        ExistingNode->SetPathNodeType(bIsFinalPath);
         return;
     }
-    
-    FVector Location = GetWorldPositionFromCell(X, Y);
-    FTransform SpawnTransform(FRotator::ZeroRotator, Location);
 
-    if (APathNodeActor* NewNode = GetWorld()->SpawnActor<APathNodeActor>(PathNodeClass, SpawnTransform))
+    // Only the last instance is removed so no other index moves, it takes the place of the removed one
+    const int32 LastInstance = WallInstanceCells.Num() - 1;
+    if (Instance != LastInstance)
     {
-        NewNode->GridX = X;
-        NewNode->GridY = Y;
-        NewNode->SetPathNodeType(bIsFinalPath);
-        PathNodes.Add(Point, NewNode);
+        FTransform LastTransform;
+        WallInstances->GetInstanceTransform(LastInstance, LastTransform, true);
+        WallInstances->UpdateInstanceTransform(Instance, LastTransform, true, false, true);
+        WallInstanceCells[Instance] = WallInstanceCells[LastInstance];
+        WallInstanceByCell[WallInstanceCells[Instance]] = Instance;
     }
+    WallInstances->RemoveInstance(LastInstance);
+    WallInstanceCells.RemoveAt(LastInstance, 1, EAllowShrinking::No);
 }
 
-void AGridManager::ClearPathNodes()
+void AGridManager::RebuildWallInstances()
 {
-    for (auto& Pair : PathNodes)
+    WallInstances->ClearInstances();
+    WallInstanceCells.Reset();
+    WallInstanceByCell.Reset();
+
+    // Walls without an actor, added in one batch. Only the tiles holding walls are read, a row word at a time
+    TArray<FTransform> Transforms;
+    const TConstArrayView<int32> TileSlots = Grid.GetTileSlots();
+    const TConstArrayView<uint64> TileWords = Grid.GetTileWords();
+    for (int32 TileY = 0; TileY < Grid.GetNumTilesY(); ++TileY)
     {
-        if (Pair.Value)
+        for (int32 TileX = 0; TileX < Grid.GetNumTilesX(); ++TileX)
         {
-            Pair.Value->Destroy();
+            const int32 Slot = TileSlots[TileY * Grid.GetNumTilesX() + TileX];
+            if (Slot == FWalkabilityGrid::CROSSABLE_TILE)
+            {
+                continue;
+            }
+
+            const int32 MinX = TileX << FWalkabilityGrid::TILE_SHIFT;
+            const int32 MinY = TileY << FWalkabilityGrid::TILE_SHIFT;
+            const int32 NumColumns = FMath::Min(FWalkabilityGrid::TILE_SIZE, GridSizeX - MinX);
+            const int32 NumRows = FMath::Min(FWalkabilityGrid::TILE_SIZE, GridSizeY - MinY);
+            const uint64 ColumnMask = NumColumns == FWalkabilityGrid::TILE_SIZE
+                ? ~uint64(0)
+                : (uint64(1) << NumColumns) - 1;
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                // Bits past the grid are undefined, the mask keeps the walls of the grid
+                uint64 Walls = ~TileWords[(Slot << FWalkabilityGrid::TILE_SHIFT) + Row] & ColumnMask;
+                while (Walls != 0)
+                {
+                    const int32 X = MinX + static_cast<int32>(FMath::CountTrailingZeros64(Walls));
+                    const int32 Y = MinY + Row;
+                    Walls &= Walls - 1;
+                    if (!WallNodes.Contains(FIntPoint(X, Y)))
+                    {
+                        const int32 Cell = GetIndexFromXY(X, Y);
+                        WallInstanceByCell.Add(Cell, WallInstanceCells.Add(Cell));
+                        Transforms.Emplace(FQuat::Identity, GetWorldPositionFromCell(X, Y),
+                            FVector(0.95f, 0.95f, 0.2f));
+                    }
+                }
+            }
         }
     }
-    PathNodes.Empty();
+    WallInstances->AddInstances(Transforms, false, true);
+}
+
+void AGridManager::ClearPathNodes()
+{
+    SearchVisualization->ClearResult();
+}
+
+void AGridManager::RequestPathfindingUpdate()
+{
+    bIsPathfindingUpdatePending = true;
+    SetActorTickEnabled(true);
 }
 
 void AGridManager::UpdatePathfinding()
 {
-    ClearPathNodes();
-    CurrentPath.Empty();
-    ExploredNodes.Empty();
+    TRACE_CPUPROFILER_EVENT_SCOPE(AGridManager::UpdatePathfinding);
+    SCOPE_CYCLE_COUNTER(STAT_AStar_UpdatePathfinding);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    // A result still in flight was computed for the previous grid or endpoints
+    PathRequestQueue.Cancel(DisplayedPathRequest);
+    DisplayedPathRequest = FPathRequestHandle();
     
     if (!StartNode || !GoalNode)
     {
+        ClearPathNodes();
+        CurrentPath.Reset();
+        ExploredNodes.Reset();
+        DisplayedResult.Reset(GridSizeX, GridSizeY);
+        LastQueryMetrics = FPathQueryMetrics();
+        return;
+    }
+
+    // Only A* reads the cell costs, the other solvers would return paths that ignore them
+    const ESolverMode ActiveSolverMode = Grid.HasUniformCosts() ? SolverMode : ESolverMode::AStar;
+
+    // The previous path stays displayed until the new one arrives
+    if (bUseAsyncPathfinding
+        && (ActiveSolverMode == ESolverMode::AStar || ActiveSolverMode == ESolverMode::JumpPoint
+            || ActiveSolverMode == ESolverMode::ThetaStar || ActiveSolverMode == ESolverMode::LazyThetaStar))
+    {
+        DisplayedPathRequest = RequestPath(StartNode->GetActorLocation(), GoalNode->GetActorLocation(), INDEX_NONE,
+            [this](FPathRequestResult& Result)
+            {
+                if (Result.bWasCancelled)
+                {
+                    return;
+                }
+                DisplayedPathRequest = FPathRequestHandle();
+                CurrentPath = MoveTemp(Result.Path);
+                ExploredNodes = MoveTemp(Result.ExploredNodes);
+                LastQueryMetrics = Result.Metrics;
+                DisplayPath();
+            }, true);
+        return;
+    }
+
+    CurrentPath.Reset();
+    ExploredNodes.Reset();
+    LastQueryMetrics = FPathQueryMetrics();
+
+    // The flow field already answers unreachable cells without a search
+    int32 GoalX = GoalNode->GridX;
+    int32 GoalY = GoalNode->GridY;
+    if (ActiveSolverMode != ESolverMode::FlowField
+        && !ResolveReachableGoal(StartNode->GridX, StartNode->GridY, GoalX, GoalY))
+    {
+        DisplayPath();
+        return;
+    }
+
+    // D* Lite and the flow field already keep their state across queries
+    const bool bUsePathCache = ActiveSolverMode != ESolverMode::Incremental
+        && ActiveSolverMode != ESolverMode::FlowField;
+    const FPathCacheKey PathCacheKey = MakePathCacheKey(StartNode->GridX, StartNode->GridY, GoalX, GoalY,
+        ActiveSolverMode);
+    bool bFoundCachedPath;
+    if (bUsePathCache && FindCachedPath(PathCacheKey, bFoundCachedPath, CurrentPath))
+    {
+        DisplayPath();
         return;
     }
     
-    TArray<FVector> ExploredPositions;
-    CurrentPath = PathFinder::Compute(
-        Grid,
-        GridSizeX,
-        GridSizeY,
-        StartNode->GridX,
-        StartNode->GridY,
-        GoalNode->GridX,
-        GoalNode->GridY,
-        CellSize,
-        ExploredNodes
-    );
-    
-    for(const auto& ExploredPos : ExploredNodes)
+    // Searches on the shared context report their open list counters, the other solvers their explored nodes
     {
-        int32 X, Y;
-        if(GetCellFromWorldPosition(ExploredPos, X, Y))
+        FPathQueryMetricsScope MetricsScope(LastQueryMetrics, &PathFinderContext, ExploredNodes);
+        switch (ActiveSolverMode)
         {
-            SpawnPathNode(X, Y, false);
+        case ESolverMode::JumpPoint:
+            JumpPointFinder::Compute(PathFinderContext, Grid, GridSizeX, GridSizeY, StartNode->GridX, StartNode->GridY,
+                GoalX, GoalY, CellSize, CurrentPath, ExploredNodes, OpenListType);
+            break;
+        case ESolverMode::JumpPointPlus:
+            // Built once per grid, then kept up to date by SetNodeCrossable
+            if (!JumpPointTable.IsBuiltFor(GridSizeX, GridSizeY))
+            {
+                JumpPointTable.Build(Grid, GridSizeX, GridSizeY);
+            }
+            JumpPointFinder::Compute(PathFinderContext, JumpPointTable, Grid, GridSizeX, GridSizeY, StartNode->GridX,
+                StartNode->GridY, GoalX, GoalY, CellSize, CurrentPath, ExploredNodes, OpenListType);
+            break;
+        case ESolverMode::Hierarchical:
+            // Explored nodes are the expanded cluster entrances, the path is fully refined for display
+            EnsureHierarchicalGraph();
+            if (HierarchicalGraph.FindAbstractPath(Grid, StartNode->GridX, StartNode->GridY, GoalX, GoalY,
+                HierarchicalPath, &HierarchicalExploredCells)
+                && HierarchicalGraph.RefinePath(Grid, HierarchicalPath, HierarchicalCells))
+            {
+                AppendCellPositions(HierarchicalCells, CurrentPath);
+            }
+            AppendCellPositions(HierarchicalExploredCells, ExploredNodes);
+            break;
+        case ESolverMode::Incremental:
+            // Search state is kept while the goal stays, a moved start only shifts the keys
+            if (IncrementalPathFinder.IsInitializedFor(GridSizeX, GridSizeY, GoalX, GoalY))
+            {
+                IncrementalPathFinder.MoveStart(StartNode->GridX, StartNode->GridY);
+            }
+            else
+            {
+                IncrementalPathFinder.Initialize(GridSizeX, GridSizeY, StartNode->GridX, StartNode->GridY, GoalX,
+                    GoalY);
+            }
+            IncrementalPathFinder.ComputePath(Grid, CellSize, CurrentPath, ExploredNodes);
+            break;
+        case ESolverMode::Bidirectional:
+        case ESolverMode::BidirectionalParallel:
+            PathFinder::ComputeBidirectional(BidirectionalContext, Grid, GridSizeX, GridSizeY, StartNode->GridX,
+                StartNode->GridY, GoalX, GoalY, CellSize, CurrentPath, ExploredNodes,
+                ActiveSolverMode == ESolverMode::BidirectionalParallel);
+            break;
+        case ESolverMode::FlowField:
+            // The whole grid is explored, only the followed flow is displayed
+            if (EnsureFlowField() && FlowField.TracePath(StartNode->GridX, StartNode->GridY, FlowFieldCells))
+            {
+                AppendCellPositions(FlowFieldCells, CurrentPath);
+            }
+            break;
+        case ESolverMode::ThetaStar:
+        case ESolverMode::LazyThetaStar:
+            AnyAnglePathFinder::Compute(PathFinderContext, Grid, GridSizeX, GridSizeY, StartNode->GridX,
+                StartNode->GridY, GoalX, GoalY, CellSize, CurrentPath, ExploredNodes,
+                ActiveSolverMode == ESolverMode::LazyThetaStar, OpenListType);
+            break;
+        case ESolverMode::AStar:
+        default:
+            // Kept as cells for display, world positions are only built below when the cache or smoothing needs them
+            PathFinder::Compute(
+                PathFinderContext,
+                Grid,
+                GridSizeX,
+                GridSizeY,
+                StartNode->GridX,
+                StartNode->GridY,
+                GoalX,
+                GoalY,
+                DisplayedResult,
+                OpenListType
+            );
+            break;
         }
     }
-    
-    for(const auto& PathPos : CurrentPath)
+
+    const bool bHasCellResult = ActiveSolverMode == ESolverMode::AStar;
+    const bool bSmoothPath = bSmoothPaths && Grid.HasUniformCosts();
+    if (bHasCellResult && (bSmoothPath || bUsePathCache))
+    {
+        DisplayedResult.GetWorldPath(CellSize, CurrentPath);
+    }
+
+    if (bSmoothPath)
+    {
+        AnyAnglePathFinder::SmoothPath(Grid, CellSize, CurrentPath);
+    }
+
+    if (bUsePathCache)
     {
-        int32 X, Y;
-        if(GetCellFromWorldPosition(PathPos, X, Y))
+        PathCache.Add(PathCacheKey, PathCache.GetVersion(), CurrentPath.Num() > 0, CurrentPath, Grid, CellSize);
+    }
+
+    if (!bHasCellResult)
+    {
+        DisplayPath();
+        return;
+    }
+
+    if (bSmoothPath)
+    {
+        DisplayedResult.SetPathFromWorldPositions(CurrentPath, CellSize);
+    }
+    DisplayPathResult();
+}
+
+void AGridManager::DisplayPath()
+{
+    // Results of the solvers without a cell output, converted once
+    DisplayedResult.Reset(GridSizeX, GridSizeY);
+    DisplayedResult.SetPathFromWorldPositions(CurrentPath, CellSize);
+    DisplayedResult.AddExploredFromWorldPositions(ExploredNodes, CellSize);
+    DisplayPathResult();
+}
+
+void AGridManager::DisplayPathResult()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AGridManager::DisplayPathResult);
+    SCOPE_CYCLE_COUNTER(STAT_AStar_SpawnPathNodes);
+
+    // Start and goal keep their own actors, only the cells that changed since the last result are touched
+    TArray<int32, TInlineAllocator<2>> NodeCells;
+    for (const AGridNodeActorBase* Node : { StartNode, GoalNode })
+    {
+        if (Node)
         {
-            SpawnPathNode(X, Y, true);
+            NodeCells.Add(GetIndexFromXY(Node->GridX, Node->GridY));
         }
     }
+    SearchVisualization->ShowResult(DisplayedResult, GridOrigin, CellSize, NodeCells);
 
-    OnPathUpdated.Broadcast(CurrentPath, ExploredNodes);
+    // The dynamic delegate copies its arrays into its parameters, they are only built when a listener reads them
+    if (OnPathUpdated.IsBound())
+    {
+        DisplayedResult.GetWorldPath(CellSize, CurrentPath);
+        DisplayedResult.GetWorldExploredNodes(CellSize, ExploredNodes);
+        OnPathUpdated.Broadcast(CurrentPath, ExploredNodes);
+    }
+    OnPathResultUpdated.Broadcast(DisplayedResult);
 }
 
-void AGridManager::DrawGrid()
+bool AGridManager::SaveGridToFile(const FString& FilePath)
 {
-    if (!GetWorld()) return;
+    return GridFile::Save(FilePath, Grid);
+}
 
-    ClearDebugLines();
-    
-    const FColor LineColor = FColor::Red;
-    const float LineThickness = 3.0f;
-    static const float LifeTime = -1.0f;
-    static const bool bPersistent = true;
-    
-    for (int32 y = 0; y <= GridSizeY; y++)
+bool AGridManager::LoadGridFromFile(const FString& FilePath)
+{
+    const FString Extension = FPaths::GetExtension(FilePath).ToLower();
+    FWalkabilityGrid LoadedGrid;
+    bool bIsLoaded;
+    if (Extension == TEXT("map"))
     {
-        const FVector StartPoint = GridOrigin + FVector(0.0f, y * CellSize, 0.0f);
-        const FVector EndPoint = StartPoint + FVector(GridSizeX * CellSize, 0.0f, 0.0f);
-        DrawDebugLine(GetWorld(), StartPoint, EndPoint, LineColor, bPersistent, LifeTime, 0, LineThickness);
+        bIsLoaded = GridFile::ImportMovingAIMap(FilePath, LoadedGrid);
     }
-    
-    for (int32 x = 0; x <= GridSizeX; x++)
+    else if (Extension == TEXT("pgm") || Extension == TEXT("png") || Extension == TEXT("bmp"))
+    {
+        bIsLoaded = GridFile::ImportImage(FilePath, LoadedGrid);
+    }
+    else
+    {
+        bIsLoaded = GridFile::Load(FilePath, LoadedGrid);
+    }
+
+    if (!bIsLoaded)
+    {
+        return false;
+    }
+
+    BeginGridEdit();
+    RemoveAllNodeActors();
+    GridSizeX = LoadedGrid.GetSizeX();
+    GridSizeY = LoadedGrid.GetSizeY();
+    Initialize();
+    MarkGridEdited();
+
+    // Initialize waited for the running searches, the revision drops the snapshots of the previous grid
+    {
+        FWriteScopeLock WriteLock(PathRequestQueue.GetGridLock());
+        Grid = MoveTemp(LoadedGrid);
+        PathRequestQueue.MarkGridChanged();
+    }
+
+    // Loaded walls never get an actor, whatever bUseInstancedWalls says, or they would not be drawn at all
+    RebuildWallInstances();
+
+    DrawGrid();
+    CommitGridEdit();
+    return true;
+}
+
+bool AGridManager::SetCellCost(const FVector& WorldPosition, uint8 Cost)
+{
+    int32 X, Y;
+    if (!GetCellFromWorldPosition(WorldPosition, X, Y))
+    {
+        return false;
+    }
+
+    Cost = FMath::Max<uint8>(Cost, 1);
+    if (GetPendingCellCost(X, Y) == Cost)
+    {
+        return true;
+    }
+
+    // Buffered with the walkability edits, the commit writes the cell and invalidates the cached paths
+    BeginGridEdit();
+    MarkCellEdited(X, Y);
+    FPendingCell& PendingCell = FindOrAddPendingCell(X, Y);
+    PendingCell.Cost = Cost;
+    if (PendingCell.IsUnchanged())
+    {
+        PendingCells.Remove(FIntPoint(X, Y));
+    }
+    CommitGridEdit();
+    return true;
+}
+
+uint8 AGridManager::GetCellCost(const FVector& WorldPosition) const
+{
+    int32 X, Y;
+    if (!GetCellFromWorldPosition(WorldPosition, X, Y))
+    {
+        return FWalkabilityGrid::DEFAULT_CELL_COST;
+    }
+    return GetPendingCellCost(X, Y);
+}
+
+void AGridManager::ResetCellCosts()
+{
+    BeginGridEdit();
+
+    // Cost edits of the open edit are dropped, the cells keep their walkability changes
+    for (TMap<FIntPoint, FPendingCell>::TIterator It = PendingCells.CreateIterator(); It; ++It)
+    {
+        It.Value().PreviousCost = FWalkabilityGrid::DEFAULT_CELL_COST;
+        It.Value().Cost = FWalkabilityGrid::DEFAULT_CELL_COST;
+        if (It.Value().IsUnchanged())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Written at once instead of at the commit, the reset has no cells to buffer
+    if (!Grid.HasUniformCosts())
+    {
+        {
+            FWriteScopeLock WriteLock(PathRequestQueue.GetGridLock());
+            Grid.ResetCellCosts();
+            PathRequestQueue.MarkGridChanged();
+        }
+        PathCache.Reset();
+        MarkGridEdited();
+    }
+    CommitGridEdit();
+}
+
+bool AGridManager::FindHierarchicalPath(const FVector& StartWorldPosition, const FVector& GoalWorldPosition,
+    bool bRefine, TArray<FVector>& OutPath)
+{
+    OutPath.Reset();
+
+    int32 StartX, StartY, GoalX, GoalY;
+    if (!GetCellFromWorldPosition(StartWorldPosition, StartX, StartY)
+        || !GetCellFromWorldPosition(GoalWorldPosition, GoalX, GoalY))
+    {
+        return false;
+    }
+
+    if (!ResolveReachableGoal(StartX, StartY, GoalX, GoalY))
+    {
+        return false;
+    }
+
+    EnsureHierarchicalGraph();
+    if (!HierarchicalGraph.FindAbstractPath(Grid, StartX, StartY, GoalX, GoalY, HierarchicalPath))
+    {
+        return false;
+    }
+
+    if (!bRefine)
     {
-        const FVector StartPoint = GridOrigin + FVector(x * CellSize, 0.0f, 0.0f);
-        const FVector EndPoint = StartPoint + FVector(0.0f, GridSizeY * CellSize, 0.0f);
-        DrawDebugLine(GetWorld(), StartPoint, EndPoint, LineColor, bPersistent, LifeTime, 0, LineThickness);
+        AppendCellPositions(HierarchicalPath.Waypoints, OutPath);
+        return true;
+    }
+
+    if (!HierarchicalGraph.RefinePath(Grid, HierarchicalPath, HierarchicalCells))
+    {
+        return false;
+    }
+    AppendCellPositions(HierarchicalCells, OutPath);
+    return true;
+}
+
+FPathRequestHandle AGridManager::RequestPath(const FVector& StartWorldPosition, const FVector& GoalWorldPosition,
+    int32 AgentId, FPathRequestQueue::FOnPathRequestCompleted&& OnCompleted, bool bCaptureExploredNodes)
+{
+    FPathRequest Request;
+    if (!GetCellFromWorldPosition(StartWorldPosition, Request.StartX, Request.StartY)
+        || !GetCellFromWorldPosition(GoalWorldPosition, Request.GoalX, Request.GoalY))
+    {
+        return FPathRequestHandle();
+    }
+
+    Request.AgentId = AgentId;
+    Request.SolverMode = SolverMode == ESolverMode::JumpPoint || SolverMode == ESolverMode::ThetaStar
+        || SolverMode == ESolverMode::LazyThetaStar ? SolverMode : ESolverMode::AStar;
+
+    // Once per session, agents request paths every few frames
+    static bool bHasWarnedSolverFallback = false;
+    if (Request.SolverMode != SolverMode && !bHasWarnedSolverFallback)
+    {
+        bHasWarnedSolverFallback = true;
+        UE_LOG(LogTemp, Warning, TEXT("GridManager : %s has no async version, path requests run as A*"),
+            *StaticEnum<ESolverMode>()->GetDisplayNameTextByValue(static_cast<int64>(SolverMode)).ToString());
+    }
+    Request.OpenListType = OpenListType;
+    Request.bSmoothPath = bSmoothPaths;
+    Request.bCaptureExploredNodes = bCaptureExploredNodes;
+    Request.bIsKnownUnreachable = !ResolveReachableGoal(Request.StartX, Request.StartY, Request.GoalX, Request.GoalY);
+
+    SetActorTickEnabled(true);
+    if (Request.bIsKnownUnreachable)
+    {
+        return PathRequestQueue.Submit(Request, MoveTemp(OnCompleted));
+    }
+
+    const FPathCacheKey PathCacheKey = MakePathCacheKey(Request.StartX, Request.StartY, Request.GoalX, Request.GoalY,
+        Request.SolverMode);
+    bool bFoundCachedPath;
+    TArray<FVector> CachedPath;
+    if (FindCachedPath(PathCacheKey, bFoundCachedPath, CachedPath))
+    {
+        return PathRequestQueue.SubmitResult(Request, bFoundCachedPath, MoveTemp(CachedPath), MoveTemp(OnCompleted));
+    }
+
+    if (!PathCache.IsEnabled())
+    {
+        return PathRequestQueue.Submit(Request, MoveTemp(OnCompleted));
+    }
+
+    // A result computed on a grid edited since the submit is not cached, the version tells them apart
+    return PathRequestQueue.Submit(Request,
+        [this, PathCacheKey, QueryVersion = PathCache.GetVersion(), OnCompleted = MoveTemp(OnCompleted)](
+            FPathRequestResult& Result)
+        {
+            if (!Result.bWasCancelled)
+            {
+                PathCache.Add(PathCacheKey, QueryVersion, Result.bFoundPath, Result.Path, Grid, CellSize);
+            }
+            if (OnCompleted)
+            {
+                OnCompleted(Result);
+            }
+        });
+}
+
+FPathCacheStats AGridManager::GetPathCacheStats() const
+{
+    return PathCache.GetStats();
+}
+
+void AGridManager::ClearPathCache()
+{
+    PathCache.Empty();
+}
+
+FPathQueryMetrics AGridManager::GetLastQueryMetrics() const
+{
+    return LastQueryMetrics;
+}
+
+TArray<FVector> AGridManager::GetPathWaypoints() const
+{
+    TArray<FVector> Waypoints;
+    DisplayedResult.GetWorldPath(CellSize, Waypoints, true);
+    return Waypoints;
+}
+
+bool AGridManager::CancelPathRequest(FPathRequestHandle Handle)
+{
+    return PathRequestQueue.Cancel(Handle);
+}
+
+bool AGridManager::GetFlowFieldNextPosition(const FVector& WorldPosition, FVector& OutNextPosition)
+{
+    int32 X, Y;
+    if (!GetCellFromWorldPosition(WorldPosition, X, Y) || !EnsureFlowField())
+    {
+        return false;
     }
+
+    const int32 Direction = FlowField.GetDirection(GetIndexFromXY(X, Y));
+    if (Direction == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutNextPosition = GetWorldPositionFromCell(X + FEightWayNeighborhood::OFFSET_X[Direction],
+        Y + FEightWayNeighborhood::OFFSET_Y[Direction]);
+    return true;
+}
+
+bool AGridManager::GetFlowFieldDirection(const FVector& WorldPosition, FVector& OutDirection)
+{
+    int32 X, Y;
+    if (!GetCellFromWorldPosition(WorldPosition, X, Y) || !EnsureFlowField())
+    {
+        return false;
+    }
+
+    const int32 Direction = FlowField.GetDirection(GetIndexFromXY(X, Y));
+    if (Direction == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutDirection = FVector(FEightWayNeighborhood::OFFSET_X[Direction], FEightWayNeighborhood::OFFSET_Y[Direction],
+        0.0f).GetSafeNormal();
+    return true;
+}
+
+void AGridManager::EnsureHierarchicalGraph()
+{
+    // Built once per grid and cluster size, then only dirty clusters are rebuilt
+    if (!HierarchicalGraph.IsBuiltFor(GridSizeX, GridSizeY, ClusterSize))
+    {
+        HierarchicalGraph.Build(Grid, GridSizeX, GridSizeY, ClusterSize);
+    }
+}
+
+bool AGridManager::EnsureFlowField()
+{
+    if (!GoalNode)
+    {
+        return false;
+    }
+
+    // Rebuilt when the goal moves, then kept up to date by SetNodeCrossable
+    if (!FlowField.IsBuiltFor(GridSizeX, GridSizeY, GoalNode->GridX, GoalNode->GridY))
+    {
+        FlowField.Build(Grid, GridSizeX, GridSizeY, GoalNode->GridX, GoalNode->GridY);
+    }
+    return true;
+}
+
+bool AGridManager::ResolveReachableGoal(int32 StartX, int32 StartY, int32& InOutGoalX, int32& InOutGoalY)
+{
+    if (!bRejectUnreachablePaths)
+    {
+        return true;
+    }
+
+    // Labelled by the first query, then kept up to date by SetNodeCrossable
+    if (!ConnectedComponents.IsBuiltFor(GridSizeX, GridSizeY))
+    {
+        ConnectedComponents.Build(Grid, GridSizeX, GridSizeY);
+    }
+
+    if (bPathToNearestReachableCell)
+    {
+        return ConnectedComponents.FindNearestReachableCell(StartX, StartY, InOutGoalX, InOutGoalY, InOutGoalX,
+            InOutGoalY);
+    }
+    return ConnectedComponents.AreConnected(StartX, StartY, InOutGoalX, InOutGoalY);
+}
+
+FPathCacheKey AGridManager::MakePathCacheKey(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY,
+    ESolverMode Mode) const
+{
+    // Same mapping as the solvers: grids with cell costs always run A* and are never smoothed
+    FPathCacheKey Key;
+    Key.StartIndex = GetIndexFromXY(StartX, StartY);
+    Key.GoalIndex = GetIndexFromXY(GoalX, GoalY);
+    Key.SolverMode = Grid.HasUniformCosts() ? Mode : ESolverMode::AStar;
+    Key.OpenListType = OpenListType;
+    Key.bSmoothPath = bSmoothPaths && Grid.HasUniformCosts();
+    return Key;
+}
+
+bool AGridManager::FindCachedPath(const FPathCacheKey& Key, bool& bOutFoundPath, TArray<FVector>& OutPath)
+{
+    // The budget is read on every query so it can be changed at runtime
+    PathCache.SetBudget(static_cast<SIZE_T>(FMath::Max(PathCacheBudgetKB, 0)) * 1024);
+    return PathCache.Find(Key, bOutFoundPath, OutPath);
+}
+
+void AGridManager::AppendCellPositions(const TArray<int32>& Cells, TArray<FVector>& OutPositions) const
+{
+    OutPositions.Reserve(OutPositions.Num() + Cells.Num());
+    for (const int32 Cell : Cells)
+    {
+        OutPositions.Add(GetWorldPositionFromCell(Cell % GridSizeX, Cell / GridSizeX));
+    }
+}
+
+void AGridManager::DrawGrid()
+{
+    GridLines->Build(GridSizeX, GridSizeY, CellSize, GridOrigin);
 }
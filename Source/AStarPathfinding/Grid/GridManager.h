@@ -2,13 +2,27 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "GridNode.h"
+#include "WalkabilityGrid.h"
+#include "GridLinesComponent.h"
 #include "GridNodeActorBase.h"
-#include "PathNodeActor.h"
+#include "SearchVisualizationComponent.h"
+#include "AStarPathfinding/Solver/BidirectionalContext.h"
+#include "AStarPathfinding/Solver/ConnectedComponents.h"
+#include "AStarPathfinding/Solver/FlowField.h"
+#include "AStarPathfinding/Solver/HierarchicalGraph.h"
+#include "AStarPathfinding/Solver/IncrementalPathFinder.h"
+#include "AStarPathfinding/Solver/JumpPointTable.h"
+#include "AStarPathfinding/Solver/PathCache.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfinding/Solver/PathFinderTypes.h"
+#include "AStarPathfinding/Solver/PathRequestQueue.h"
+#include "AStarPathfinding/Solver/PathResult.h"
 #include "GridManager.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGridChanged);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGridRegionChanged, FIntPoint, MinCell, FIntPoint, MaxCell);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPathUpdated, const TArray<FVector>&, Path, const TArray<FVector>&, ExploredNodes);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPathResultUpdated, const FPathResult&);
 
 UCLASS()
 class ASTARPATHFINDING_API AGridManager : public AActor
@@ -27,9 +41,17 @@ public:
 	//// Grid delegates
 	UPROPERTY(BlueprintAssignable, Category = "Grid|Events")
 	FOnGridChanged OnGridChanged;
+
+	/** Inclusive box of the cells an edit changed, broadcast once per committed edit just before OnGridChanged */
+	UPROPERTY(BlueprintAssignable, Category = "Grid|Events")
+	FOnGridRegionChanged OnGridRegionChanged;
     
+	/** Copies the path and explored nodes as world positions into its parameters, they are only built while bound */
 	UPROPERTY(BlueprintAssignable, Category = "Grid|Events")
 	FOnPathUpdated OnPathUpdated;
+
+	/** Same update for C++ listeners, passed as cells by reference */
+	FOnPathResultUpdated OnPathResultUpdated;
 	
 	//////// FIELDS ////////
 	//// Grid fields
@@ -40,6 +62,29 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Settings")
 	float CellSize;
 
+	//// Pathfinding fields
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding")
+	ESolverMode SolverMode;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding")
+	EOpenListType OpenListType;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding", meta = (ClampMin = "2"))
+	int32 ClusterSize;
+	/** A*, JPS and Theta* queries of the displayed path run on worker threads, the other solvers always run inline */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding")
+	bool bUseAsyncPathfinding;
+	/** Cell paths are string pulled down to the cells where they turn around a wall, on grids without cell costs */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding")
+	bool bSmoothPaths;
+	/** Queries between two disconnected regions fail without a search, costs 4 bytes per cell once labelled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding")
+	bool bRejectUnreachablePaths;
+	/** An unreachable goal is replaced by the reachable cell closest to it, needs bRejectUnreachablePaths */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding", meta = (EditCondition = "bRejectUnreachablePaths"))
+	bool bPathToNearestReachableCell;
+	/** Memory kept for the results of recent queries, the least recently used go first, 0 disables the cache */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Pathfinding", meta = (ClampMin = "0"))
+	int32 PathCacheBudgetKB;
+
 	//// Interaction fields
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction Settings")
 	float InteractionDistance;
@@ -55,8 +100,25 @@ public:
 	TSubclassOf<AGridNodeActorBase> GoalNodeClass;
 	UPROPERTY(EditDefaultsOnly, Category = "Grid|Nodes")
 	TSubclassOf<AGridNodeActorBase> WallNodeClass;
-	UPROPERTY(EditDefaultsOnly, Category = "Grid|Nodes") 
-	TSubclassOf<AGridNodeActorBase> PathNodeClass;
+
+	/** Draws placed walls as instances of one mesh instead of spawning a wall actor each, loaded walls always are */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Nodes")
+	bool bUseInstancedWalls;
+
+	/** Removed node actors kept hidden for reuse, the ones above the limit are destroyed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Nodes", meta = (ClampMin = "0"))
+	int32 MaxPooledNodeActors;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Grid|Nodes")
+	UHierarchicalInstancedStaticMeshComponent* WallInstances;
+
+	/** Explored and path cells of the displayed search */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Grid|Nodes")
+	USearchVisualizationComponent* SearchVisualization;
+
+	/** Lines of the grid and the highlighted cell */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Grid")
+	UGridLinesComponent* GridLines;
 
 	//////// METHODS ////////
 	//// Grid methods
@@ -70,24 +132,142 @@ public:
 	FVector GetHighlightedCellWorldPosition() const;
 	UFUNCTION(BlueprintCallable, Category = "Grid")
 	EGridActorType GetNodeTypeAtPosition(const FVector& WorldPosition) const;
+
+	//// File methods
+	/** Saves the walkability of the grid to a binary grid file, the start and goal nodes and cell costs are not saved */
+	UFUNCTION(BlueprintCallable, Category = "Grid|File")
+	bool SaveGridToFile(const FString& FilePath);
+
+	/**
+	 * Replaces the grid with a binary grid file, a MovingAI .map or a grayscale image (.pgm, .png, ...).
+	 * The grid is resized to the file, walls go straight into the grid and are drawn as instances, without actors.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid|File")
+	bool LoadGridFromFile(const FString& FilePath);
+	
+	//// Terrain methods
+	/**
+	 * Cost multiplying the moves that enter the cell, from 1 (the default) to 255, for mud, roads or water.
+	 * Only A* reads costs: while a cell costs more than 1 the other solver modes run A* instead.
+	 * Inside BeginGridEdit / CommitGridEdit the cost is written to the grid at the commit, GetCellCost reads it before.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Terrain")
+	bool SetCellCost(const FVector& WorldPosition, uint8 Cost);
+	UFUNCTION(BlueprintCallable, Category = "Grid|Terrain")
+	uint8 GetCellCost(const FVector& WorldPosition) const;
+	UFUNCTION(BlueprintCallable, Category = "Grid|Terrain")
+	void ResetCellCosts();
 	
 	//// Nodes methods
 	UFUNCTION(BlueprintCallable, Category = "Grid|Interaction")
 	bool ToggleNodeActorInGrid(const FVector& WorldPosition);
+
+	//// Edit methods
+	/**
+	 * Groups the edits made until the matching CommitGridEdit into one: the data derived from the grid is updated once,
+	 * OnGridRegionChanged and OnGridChanged are broadcast once and the path is replanned once, on the next tick.
+	 * Edits nest, only the outermost commit applies them. Every edit opens its own when none is open.
+	 * Walkability and cost changes are written to the grid at the commit, searches run during the edit see the
+	 * previous grid. ResetCellCosts is the exception, it resets the grid at once.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Edit")
+	void BeginGridEdit();
+	UFUNCTION(BlueprintCallable, Category = "Grid|Edit")
+	void CommitGridEdit();
+
+	/** Places or removes a wall, the start and goal cells are left as they are */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Edit")
+	void SetWallAtCell(FIntPoint Cell, bool bIsWall);
+
+	/** Every cell of the box between two corner cells, both included */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Edit")
+	void SetWallsInRect(FIntPoint CornerA, FIntPoint CornerB, bool bIsWall);
+
+	/** Cells of the 4-connected line between two cells, to join the samples of a brush stroke without diagonal gaps */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Edit")
+	void SetWallsAlongLine(FIntPoint From, FIntPoint To, bool bIsWall);
+
+	/** Cells whose center lies within Radius cells of the center of the Center cell */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Edit")
+	void SetWallsInCircle(FIntPoint Center, int32 Radius, bool bIsWall);
+
+	//// Pathfinding methods
+	/** HPA* query, bRefine = false only returns the cluster entrances crossed, for agents that are still far away */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	bool FindHierarchicalPath(const FVector& StartWorldPosition, const FVector& GoalWorldPosition, bool bRefine,
+		TArray<FVector>& OutPath);
+
+	/**
+	 * Queues an A*, JPS or Theta* query (following SolverMode) on the task system, OnCompleted runs on the game thread.
+	 * The other solver modes keep state on the game thread (JPS+, HPA*, D* Lite, flow fields) or run their own threads
+	 * (bidirectional A*), their requests run as A* and the first one logs a warning.
+	 * Grids with cell costs always use A*.
+	 * A newer request with the same AgentId cancels this one, INDEX_NONE never supersedes.
+	 * Returns an invalid handle and never calls OnCompleted when a position is outside the grid.
+	 * Explored nodes are only recorded with bCaptureExploredNodes, agents following the path never read them.
+	 */
+	FPathRequestHandle RequestPath(const FVector& StartWorldPosition, const FVector& GoalWorldPosition, int32 AgentId,
+		FPathRequestQueue::FOnPathRequestCompleted&& OnCompleted, bool bCaptureExploredNodes = false);
+
+	/** Start, goal and turn points of the displayed path, the straight runs between them dropped */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	TArray<FVector> GetPathWaypoints() const;
+
+	/** Its callback still runs, with bWasCancelled set */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	bool CancelPathRequest(FPathRequestHandle Handle);
+
+	/** Cached results are dropped when a wall or cost change can affect them, D* Lite and flow fields are not cached */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	FPathCacheStats GetPathCacheStats() const;
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	void ClearPathCache();
+
+	/** Work done by the query behind the displayed path, the same counters are shown in game by "stat AStar" */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	FPathQueryMetrics GetLastQueryMetrics() const;
+
+	/** Next cell toward the goal node from the flow field, false on the goal or when it cannot be reached */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	bool GetFlowFieldNextPosition(const FVector& WorldPosition, FVector& OutNextPosition);
+
+	/** Unit direction of the flow field toward the goal node, false on the goal or when it cannot be reached */
+	UFUNCTION(BlueprintCallable, Category = "Grid|Pathfinding")
+	bool GetFlowFieldDirection(const FVector& WorldPosition, FVector& OutDirection);
 	
 protected:
 	//////// UNREAL LIFECYCLE ////////
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 private:
+	//////// STRUCTS ////////
+	/// cell changed by the open edit, from its values in the grid to the ones the commit writes
+	struct FPendingCell
+	{
+		bool bWasCrossable;
+		bool bIsCrossable;
+		uint8 PreviousCost;
+		uint8 Cost;
+
+		bool ChangesCrossable() const
+		{
+			return bWasCrossable != bIsCrossable;
+		}
+
+		bool IsUnchanged() const
+		{
+			return !ChangesCrossable() && PreviousCost == Cost;
+		}
+	};
+
 	//////// FIELDS ////////
 	//// Grid fields
 	static constexpr float DEFAULT_CELL_SIZE = 100.0f;
 	static constexpr int32 DEFAULT_GRID_SIZE = 10;
 	
-	UPROPERTY()
-	TArray<FGridNode> Grid;
+	FWalkabilityGrid Grid;
 	FVector GridOrigin;
 	
 	int32 LastHighlightedNodeX;
@@ -101,33 +281,97 @@ private:
 	AGridNodeActorBase* GoalNode;
 	
 	TMap<FIntPoint, AGridNodeActorBase*> WallNodes;
-	TMap<FIntPoint, APathNodeActor*> PathNodes;
+	UPROPERTY()
+	TArray<AGridNodeActorBase*> PooledNodeActors;
+
+	/// cell index of each wall instance and the other way around, instances are removed by moving the last one
+	TArray<int32> WallInstanceCells;
+	TMap<int32, int32> WallInstanceByCell;
+
+	//// Edit fields
+	int32 GridEditDepth = 0;
+	/// inclusive box of the cells changed by the open edit, empty when the min is above the max
+	FIntPoint EditMinCell = FIntPoint(MAX_int32, MAX_int32);
+	FIntPoint EditMaxCell = FIntPoint(MIN_int32, MIN_int32);
+	/// walkability and costs of the cells changed by the open edit, written to the grid by the outermost commit
+	TMap<FIntPoint, FPendingCell> PendingCells;
+	bool bIsPathfindingUpdatePending = false;
 	
 	//// Pathfinding fields
+	FPathFinderContext PathFinderContext;
+	FBidirectionalContext BidirectionalContext;
+	FJumpPointTable JumpPointTable;
+	FHierarchicalGraph HierarchicalGraph;
+	FHierarchicalPath HierarchicalPath;
+	TArray<int32> HierarchicalCells;
+	TArray<int32> HierarchicalExploredCells;
+	FIncrementalPathFinder IncrementalPathFinder;
+	FFlowField FlowField;
+	TArray<int32> FlowFieldCells;
+	FConnectedComponents ConnectedComponents;
+	/// edits of more cells than NumCells / COMPONENTS_REBUILD_DIVISOR relabel the grid instead of patching each cell.
+	/// A build costs as much as patching 1/37 to 1/5 of the cells, measured with strokes of 32 cells on 128x128 to
+	/// 2048x2048 grids with 10-45% walls.
+	static constexpr int32 COMPONENTS_REBUILD_DIVISOR = 32;
+	FPathCache PathCache;
+	FPathRequestQueue PathRequestQueue;
+	FPathRequestHandle DisplayedPathRequest;
+	/// path and explored cells on display, the world arrays are the buffers of the solvers without a cell output
+	FPathResult DisplayedResult;
 	TArray<FVector> CurrentPath;
 	TArray<FVector> ExploredNodes;
+	FPathQueryMetrics LastQueryMetrics;
 
 	//////// METHODS ////////
 	///Grid methods
 	void Initialize();
 	void DrawGrid();
-	void ClearDebugLines();
 
 	/// Grid helper
 	int32 GetIndexFromXY(int32 X, int32 Y) const;
 	bool IsValidPos(int32 X, int32 Y) const;
-	FGridNode& GetNode(int32 X, int32 Y);
+	void SetNodeCrossable(int32 X, int32 Y, bool bIsCrossable);
+	/// walkability of the cell once the open edit is committed
+	bool IsNodeCrossable(int32 X, int32 Y) const;
+	/// cost of the cell once the open edit is committed
+	uint8 GetPendingCellCost(int32 X, int32 Y) const;
+	/// entry of the cell in PendingCells, started from the grid values
+	FPendingCell& FindOrAddPendingCell(int32 X, int32 Y);
 	bool IsNodeAlreadyHighlighted(int32 X, int32 Y) const;
 	void UpdateHighlightedCell(int32 X, int32 Y);
 	AGridNodeActorBase* GetNodeActorAtCell(int32 X, int32 Y) const;
 
 	//// Nodes methods
 	void RemoveExistingNodeActorAtCell(int32 X, int32 Y);
+	void RemoveAllNodeActors();
 	AGridNodeActorBase* SpawnNodeActor(TSubclassOf<AGridNodeActorBase> ActorClass, int32 X, int32 Y);
+	void ReleaseNodeActor(AGridNodeActorBase* NodeActor);
+
+	void AddWallInstance(int32 X, int32 Y);
+	void RemoveWallInstance(int32 X, int32 Y);
+	void RebuildWallInstances();
 
-	void SpawnPathNode(int32 X, int32 Y, bool bIsFinalPath);
 	void ClearPathNodes();
 
+	bool ToggleNodeActorAtCell(int32 GridX, int32 GridY);
+
+	//// Edit methods
+	void MarkCellEdited(int32 X, int32 Y);
+	void MarkGridEdited();
+	void ApplyPendingCells();
+	/// shortens the segment to its part over the grid, false when it misses the grid
+	bool ClipLineToGrid(FIntPoint& InOutFrom, FIntPoint& InOutTo) const;
+
 	//// Pathfinding methods
+	/** Runs UpdatePathfinding on the next tick, the requests of a frame share one search */
+	void RequestPathfindingUpdate();
 	void UpdatePathfinding();
+	void DisplayPath();
+	void DisplayPathResult();
+	void EnsureHierarchicalGraph();
+	bool EnsureFlowField();
+	bool ResolveReachableGoal(int32 StartX, int32 StartY, int32& InOutGoalX, int32& InOutGoalY);
+	FPathCacheKey MakePathCacheKey(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY, ESolverMode Mode) const;
+	bool FindCachedPath(const FPathCacheKey& Key, bool& bOutFoundPath, TArray<FVector>& OutPath);
+	void AppendCellPositions(const TArray<int32>& Cells, TArray<FVector>& OutPositions) const;
 };
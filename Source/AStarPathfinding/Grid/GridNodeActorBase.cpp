@@ -1,4 +1,6 @@
 #include "GridNodeActorBase.h"
+#include "GridNodeMaterialSubsystem.h"
+#include "Materials/MaterialInstanceDynamic.h"
 
 AGridNodeActorBase::AGridNodeActorBase()
 {
@@ -24,60 +26,44 @@ void AGridNodeActorBase::SetupNodeColor(EGridActorType Type, ENodeState State)
         return;
     }
 
-    if (UMaterial* Material = Cast<UMaterial>(StaticLoadObject(UMaterial::StaticClass(), nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial"))))
+    FLinearColor Color;
+    
+    if (State == ENodeState::Default)
     {
-        UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(Material, this);
-        
-        FLinearColor Color;
-        
-        if (State == ENodeState::Default)
-        {
-            switch(Type)
-            {
-            case EGridActorType::Start:
-                Color = FLinearColor(0.0f, 0.0f, 1.0f); // RoyalBlue
-                break;
-            case EGridActorType::Goal:
-                Color = FLinearColor(1.0f, 0.686f, 0.0f); // Gold
-                break;
-            case EGridActorType::Wall:
-                Color = FLinearColor(0.2f, 0.2f, 0.2f); // DarkGray
-                break;
-            default:
-                Color = FLinearColor::White;
-            }
-            bIsBaseColorSet = true;
-        }
-        else
-        {
-            switch(State)
-            {
-            case ENodeState::ToExplore:
-                Color = FLinearColor(0.941f, 0.502f, 0.502f); // Orange
-                break;
-            case ENodeState::Explored:
-                Color = FLinearColor(1.0f, 1.0f, 0.0f); // Yellow
-                break;
-            case ENodeState::Path:
-                Color = FLinearColor(0.565f, 0.933f, 0.565f); // LightGreen
-                break;
-            case ENodeState::Neighbor:
-                Color = FLinearColor(0.0f, 1.0f, 1.0f); // LightBlue
-                break;
-            default:
-                Color = FLinearColor::White;
-            }
-        }
-        
-        NodeState = State;
-        if (State == ENodeState::Default)
+        Color = GetNodeTypeColor(Type);
+    }
+    else
+    {
+        switch(State)
         {
-            NodeType = Type;
+        case ENodeState::ToExplore:
+            Color = FLinearColor(0.941f, 0.502f, 0.502f); // Orange
+            break;
+        case ENodeState::Explored:
+            Color = FLinearColor(1.0f, 1.0f, 0.0f); // Yellow
+            break;
+        case ENodeState::Path:
+            Color = FLinearColor(0.565f, 0.933f, 0.565f); // LightGreen
+            break;
+        case ENodeState::Neighbor:
+            Color = FLinearColor(0.0f, 1.0f, 1.0f); // LightBlue
+            break;
+        default:
+            Color = FLinearColor::White;
         }
-        
-        DynMaterial->SetVectorParameterValue(TEXT("Color"), Color);
-        MeshComponent->SetMaterial(0, DynMaterial);
     }
+    
+    if (!SetSharedMaterial(Color))
+    {
+        return;
+    }
+
+    if (State == ENodeState::Default)
+    {
+        bIsBaseColorSet = true;
+        NodeType = Type;
+    }
+    NodeState = State;
 }
 
 void AGridNodeActorBase::UpdatePathFindingNodeColor(ENodeState State)
@@ -87,48 +73,72 @@ void AGridNodeActorBase::UpdatePathFindingNodeColor(ENodeState State)
         return;
     }
 
-    if (UMaterialInstanceDynamic* DynMaterial = Cast<UMaterialInstanceDynamic>(MeshComponent->GetMaterial(0)))
+    // Only recolors nodes whose color was set up
+    if (!Cast<UMaterialInstanceDynamic>(MeshComponent->GetMaterial(0)))
     {
-        FLinearColor Color;
-        
-        if (NodeType == EGridActorType::Start || NodeType == EGridActorType::Goal)
-        {
-            switch(NodeType)
-            {
-            case EGridActorType::Start:
-                Color = FLinearColor(0.0f, 0.0f, 1.0f); // RoyalBlue
-                break;
-            case EGridActorType::Goal:
-                Color = FLinearColor(1.0f, 0.686f, 0.0f); // Gold
-                break;
-            }
-        }
-        else
+        return;
+    }
+
+    FLinearColor Color;
+    
+    if (NodeType == EGridActorType::Start || NodeType == EGridActorType::Goal)
+    {
+        Color = GetNodeTypeColor(NodeType);
+    }
+    else
+    {
+        switch(State)
         {
-            switch(State)
-            {
-            case ENodeState::ToExplore:
-                Color = FLinearColor(0.941f, 0.502f, 0.502f); // Orange
-                break;
-            case ENodeState::Explored:
-                Color = FLinearColor(1.0f, 0.0f, 0.0f); // Red
-                break;
-            case ENodeState::Path:
-                Color = FLinearColor(0.0f, 1.0f, 0.0f); // LightGreen
-                break;
-            case ENodeState::Neighbor:
-                Color = FLinearColor(0.0f, 1.0f, 1.0f); // LightBlue
-                break;
-            default:
-                Color = FLinearColor::White;
-            }
+        case ENodeState::ToExplore:
+            Color = FLinearColor(0.941f, 0.502f, 0.502f); // Orange
+            break;
+        case ENodeState::Explored:
+            Color = FLinearColor(1.0f, 0.0f, 0.0f); // Red
+            break;
+        case ENodeState::Path:
+            Color = FLinearColor(0.0f, 1.0f, 0.0f); // LightGreen
+            break;
+        case ENodeState::Neighbor:
+            Color = FLinearColor(0.0f, 1.0f, 1.0f); // LightBlue
+            break;
+        default:
+            Color = FLinearColor::White;
         }
+    }
+
+    NodeState = State;
+    SetSharedMaterial(Color);
+}
 
-        NodeState = State;
-        DynMaterial->SetVectorParameterValue(TEXT("Color"), Color);
+FLinearColor AGridNodeActorBase::GetNodeTypeColor(EGridActorType Type)
+{
+    switch(Type)
+    {
+    case EGridActorType::Start:
+        return FLinearColor(0.0f, 0.0f, 1.0f); // RoyalBlue
+    case EGridActorType::Goal:
+        return FLinearColor(1.0f, 0.686f, 0.0f); // Gold
+    case EGridActorType::Wall:
+        return FLinearColor(0.2f, 0.2f, 0.2f); // DarkGray
+    default:
+        return FLinearColor::White;
     }
 }
 
+bool AGridNodeActorBase::SetSharedMaterial(const FLinearColor& Color)
+{
+    UGridNodeMaterialSubsystem* MaterialSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UGridNodeMaterialSubsystem>()
+        : nullptr;
+    UMaterialInstanceDynamic* Material = MaterialSubsystem ? MaterialSubsystem->GetNodeMaterial(Color) : nullptr;
+    if (!Material)
+    {
+        return false;
+    }
+
+    MeshComponent->SetMaterial(0, Material);
+    return true;
+}
+
 void AGridNodeActorBase::BeginPlay()
 {
 	Super::BeginPlay();
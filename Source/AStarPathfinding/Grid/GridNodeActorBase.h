@@ -54,6 +54,9 @@ public:
 	void SetupNodeColor(EGridActorType Type, ENodeState State = ENodeState::Default);
 
 	void UpdatePathFindingNodeColor(ENodeState State);
+
+	/** Color of a node of this type in its default state */
+	static FLinearColor GetNodeTypeColor(EGridActorType Type);
 	
 protected:
 	//////// UNREAL LIFECYCLE ////////
@@ -66,4 +69,7 @@ private:
 
 	void LockBaseColor() { bIsBaseColorSet = true; }
 	bool IsBaseColorSet() const { return bIsBaseColorSet; }
+
+	/** Shows the material of the world shared by every node of this color */
+	bool SetSharedMaterial(const FLinearColor& Color);
 };
@@ -0,0 +1,32 @@
+#include "GridNodeMaterialSubsystem.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+UMaterialInstanceDynamic* UGridNodeMaterialSubsystem::GetNodeMaterial(const FLinearColor& Color)
+{
+	if (UMaterialInstanceDynamic* const* ExistingMaterial = MaterialByColor.Find(Color))
+	{
+		return *ExistingMaterial;
+	}
+
+	if (!BaseMaterial)
+	{
+		BaseMaterial = LoadObject<UMaterial>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
+		if (!BaseMaterial)
+		{
+			return nullptr;
+		}
+	}
+
+	UMaterialInstanceDynamic* Material = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+	Material->SetVectorParameterValue(TEXT("Color"), Color);
+	MaterialByColor.Add(Color, Material);
+	return Material;
+}
+
+void UGridNodeMaterialSubsystem::Deinitialize()
+{
+	MaterialByColor.Empty();
+	BaseMaterial = nullptr;
+	Super::Deinitialize();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GridNodeMaterialSubsystem.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Node materials shared by every node actor and instanced mesh of a world, one per color.
+ * The base material is loaded once, each color gets a single dynamic instance that must not be edited by its users.
+ */
+UCLASS()
+class ASTARPATHFINDING_API UGridNodeMaterialSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//////// METHODS ////////
+	/** Shared material of a color, nullptr when the base material cannot be loaded */
+	UMaterialInstanceDynamic* GetNodeMaterial(const FLinearColor& Color);
+
+	int32 GetNumMaterials() const { return MaterialByColor.Num(); }
+
+	//////// OVERRIDES ////////
+	virtual void Deinitialize() override;
+
+private:
+	//////// FIELDS ////////
+	UPROPERTY(Transient)
+	UMaterialInterface* BaseMaterial;
+	UPROPERTY(Transient)
+	TMap<FLinearColor, UMaterialInstanceDynamic*> MaterialByColor;
+};
@@ -0,0 +1,196 @@
+#include "SearchVisualizationComponent.h"
+#include "GridNodeMaterialSubsystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "AStarPathfinding/Solver/PathResult.h"
+#include "AStarPathfinding/Solver/PathFinderStats.h"
+
+USearchVisualizationComponent::USearchVisualizationComponent()
+	: ExploredColor(1.0f, 0.0f, 0.0f)
+	, PathColor(0.0f, 1.0f, 0.0f)
+	, InstanceScale(0.95f, 0.95f, 0.2f)
+{
+	ExploredInstances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("ExploredInstances"));
+	PathInstances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("PathInstances"));
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMeshAsset(TEXT("/Engine/BasicShapes/Cube"));
+	for (UHierarchicalInstancedStaticMeshComponent* Instances : { ExploredInstances, PathInstances })
+	{
+		Instances->SetupAttachment(this);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCastShadow(false);
+		Instances->SetCanEverAffectNavigation(false);
+		if (CubeMeshAsset.Succeeded())
+		{
+			Instances->SetStaticMesh(CubeMeshAsset.Object);
+		}
+	}
+}
+
+void USearchVisualizationComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UGridNodeMaterialSubsystem* MaterialSubsystem = GetWorld()->GetSubsystem<UGridNodeMaterialSubsystem>())
+	{
+		ExploredInstances->SetMaterial(0, MaterialSubsystem->GetNodeMaterial(ExploredColor));
+		PathInstances->SetMaterial(0, MaterialSubsystem->GetNodeMaterial(PathColor));
+	}
+}
+
+void USearchVisualizationComponent::ShowResult(const FPathResult& Result, const FVector& GridOrigin, float CellSize,
+	TConstArrayView<int32> HiddenCells)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USearchVisualizationComponent::ShowResult);
+
+	// Instances are placed for one layout, a new grid starts over
+	if (Result.GridSizeX != GridSizeX || Result.GridSizeY != GridSizeY || CellSize != ShownCellSize
+		|| GridOrigin != ShownGridOrigin)
+	{
+		ClearResult();
+		GridSizeX = Result.GridSizeX;
+		GridSizeY = Result.GridSizeY;
+		ShownCellSize = CellSize;
+		ShownGridOrigin = GridOrigin;
+	}
+
+	// New state of the cells to show, the path overrides the explored state
+	const auto MarkCell = [this](int32 Cell, ECellState State)
+	{
+		NewCellStates.Add(Cell, State);
+	};
+	Result.ForEachExploredCell([&MarkCell](int32 Cell)
+	{
+		MarkCell(Cell, ECellState::Explored);
+	});
+	for (const int32 Cell : Result.PathCells)
+	{
+		MarkCell(Cell, ECellState::Path);
+	}
+	for (const int32 Cell : HiddenCells)
+	{
+		NewCellStates.Remove(Cell);
+	}
+
+	// Cells shown by the previous update that leave their mesh free their instance
+	const auto ReleaseCells = [this](ECellState Shown, FStateInstances& State)
+	{
+		for (int32 Instance = 0; Instance < State.CellByInstance.Num(); ++Instance)
+		{
+			const int32 Cell = State.CellByInstance[Instance];
+			const ECellState* NewState = NewCellStates.Find(Cell);
+			if (!NewState || *NewState != Shown)
+			{
+				CellStates.Remove(Cell);
+				State.CellByInstance[Instance] = INDEX_NONE;
+				State.FreeInstances.Add(Instance);
+			}
+		}
+	};
+	ReleaseCells(ECellState::Explored, ExploredState);
+	ReleaseCells(ECellState::Path, PathState);
+
+	for (const TPair<int32, ECellState>& NewCell : NewCellStates)
+	{
+		ECellState& ShownState = CellStates.FindOrAdd(NewCell.Key, ECellState::None);
+		if (ShownState != NewCell.Value)
+		{
+			ShownState = NewCell.Value;
+			(NewCell.Value == ECellState::Path ? PathState : ExploredState).AddedCells.Add(NewCell.Key);
+		}
+	}
+	NewCellStates.Reset();
+
+	ApplyStateChanges(ExploredInstances, ExploredState);
+	ApplyStateChanges(PathInstances, PathState);
+}
+
+void USearchVisualizationComponent::ClearResult()
+{
+	ExploredInstances->ClearInstances();
+	PathInstances->ClearInstances();
+	ExploredState.CellByInstance.Reset();
+	PathState.CellByInstance.Reset();
+	CellStates.Reset();
+}
+
+int32 USearchVisualizationComponent::GetNumShownCells() const
+{
+	return ExploredState.CellByInstance.Num() + PathState.CellByInstance.Num();
+}
+
+FTransform USearchVisualizationComponent::GetCellTransform(int32 Cell) const
+{
+	const FVector Location = ShownGridOrigin
+		+ FVector((Cell % GridSizeX + 0.5f) * ShownCellSize, (Cell / GridSizeX + 0.5f) * ShownCellSize, 0.0f);
+	return FTransform(FQuat::Identity, Location, InstanceScale);
+}
+
+void USearchVisualizationComponent::ApplyStateChanges(UHierarchicalInstancedStaticMeshComponent* Instances,
+	FStateInstances& State)
+{
+	if (State.FreeInstances.Num() == 0 && State.AddedCells.Num() == 0)
+	{
+		return;
+	}
+
+	// Cells entering the mesh take the freed instances first
+	int32 AddedIndex = 0;
+	for (; AddedIndex < State.AddedCells.Num() && State.FreeInstances.Num() > 0; ++AddedIndex)
+	{
+		const int32 Cell = State.AddedCells[AddedIndex];
+		const int32 Instance = State.FreeInstances.Pop(EAllowShrinking::No);
+		Instances->UpdateInstanceTransform(Instance, GetCellTransform(Cell), true, false, true);
+		State.CellByInstance[Instance] = Cell;
+	}
+
+	if (AddedIndex < State.AddedCells.Num())
+	{
+		State.AddedTransforms.Reset();
+		for (int32 i = AddedIndex; i < State.AddedCells.Num(); ++i)
+		{
+			State.AddedTransforms.Add(GetCellTransform(State.AddedCells[i]));
+		}
+
+		const TArray<int32> AddedInstances = Instances->AddInstances(State.AddedTransforms, true, true);
+		State.CellByInstance.SetNum(FMath::Max(State.CellByInstance.Num(), Instances->GetInstanceCount()));
+		for (int32 i = 0; i < AddedInstances.Num(); ++i)
+		{
+			State.CellByInstance[AddedInstances[i]] = State.AddedCells[AddedIndex + i];
+		}
+	}
+	else if (State.FreeInstances.Num() > 0)
+	{
+		// Freed instances nobody took get the last shown cells, the end of the mesh is then removed in one call
+		State.FreeInstances.Sort();
+		const int32 NumKept = State.CellByInstance.Num() - State.FreeInstances.Num();
+		int32 LastInstance = State.CellByInstance.Num() - 1;
+		for (const int32 Instance : State.FreeInstances)
+		{
+			if (Instance >= NumKept)
+			{
+				break;
+			}
+
+			while (State.CellByInstance[LastInstance] == INDEX_NONE)
+			{
+				--LastInstance;
+			}
+			const int32 Cell = State.CellByInstance[LastInstance];
+			Instances->UpdateInstanceTransform(Instance, GetCellTransform(Cell), true, false, true);
+			State.CellByInstance[Instance] = Cell;
+			State.CellByInstance[LastInstance--] = INDEX_NONE;
+		}
+
+		State.FreeInstances.Reset();
+		for (int32 Instance = State.CellByInstance.Num() - 1; Instance >= NumKept; --Instance)
+		{
+			State.FreeInstances.Add(Instance);
+		}
+		Instances->RemoveInstances(State.FreeInstances);
+		State.CellByInstance.SetNum(NumKept, EAllowShrinking::No);
+	}
+
+	State.FreeInstances.Reset();
+	State.AddedCells.Reset();
+	Instances->MarkRenderStateDirty();
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "SearchVisualizationComponent.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+struct FPathResult;
+
+/**
+ * Explored and path cells of the last search, one instanced mesh per state so each one is drawn with the plain
+ * node material of its colour from UGridNodeMaterialSubsystem.
+ * Each update only walks the cells shown by the previous one and the cells of the new result: a cell leaving a mesh
+ * frees its instance for the cells entering it, freed instances nobody took are filled from the end of the mesh and
+ * removed, new instances are added in one batch. The state is kept per shown cell, not per grid cell.
+ */
+UCLASS(ClassGroup = (Grid), meta = (BlueprintSpawnableComponent))
+class ASTARPATHFINDING_API USearchVisualizationComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	//////// CONSTRUCTOR ////////
+	USearchVisualizationComponent();
+
+	//////// FIELDS ////////
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Visualization")
+	FLinearColor ExploredColor;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Visualization")
+	FLinearColor PathColor;
+
+	/** Scale of the mesh on each cell, the same as the node actors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid|Visualization")
+	FVector InstanceScale;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Grid|Visualization")
+	UHierarchicalInstancedStaticMeshComponent* ExploredInstances;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Grid|Visualization")
+	UHierarchicalInstancedStaticMeshComponent* PathInstances;
+
+	//////// METHODS ////////
+	/** Shows the explored and path cells of Result, the path drawn over the explored cells, HiddenCells are skipped */
+	void ShowResult(const FPathResult& Result, const FVector& GridOrigin, float CellSize,
+		TConstArrayView<int32> HiddenCells);
+
+	/** Removes every instance */
+	void ClearResult();
+
+	int32 GetNumShownCells() const;
+
+	//////// OVERRIDES ////////
+	virtual void BeginPlay() override;
+
+private:
+	//////// FIELDS ////////
+	enum class ECellState : uint8
+	{
+		None,
+		Explored,
+		Path
+	};
+
+	/// instances of one mesh, CellByInstance holds the cells shown by the previous update
+	struct FStateInstances
+	{
+		TArray<int32> CellByInstance;
+		/// scratch of ShowResult
+		TArray<int32> FreeInstances;
+		TArray<int32> AddedCells;
+		TArray<FTransform> AddedTransforms;
+	};
+
+	FStateInstances ExploredState;
+	FStateInstances PathState;
+
+	/// displayed state of the shown cells, by cell index, a search only shows a small part of the grid
+	TMap<int32, ECellState> CellStates;
+
+	/// layout the instances were placed for, a change clears them
+	int32 GridSizeX = 0;
+	int32 GridSizeY = 0;
+	float ShownCellSize = 0.0f;
+	FVector ShownGridOrigin = FVector::ZeroVector;
+
+	/// scratch of ShowResult, state of the cells of the new result, empty between calls
+	TMap<int32, ECellState> NewCellStates;
+
+	//////// METHODS ////////
+	FTransform GetCellTransform(int32 Cell) const;
+	void ApplyStateChanges(UHierarchicalInstancedStaticMeshComponent* Instances, FStateInstances& State);
+};
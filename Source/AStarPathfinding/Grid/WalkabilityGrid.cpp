@@ -0,0 +1,404 @@
+#include "WalkabilityGrid.h"
+
+FWalkabilityGrid::FWalkabilityGrid(const FWalkabilityGrid& Other)
+{
+	*this = Other;
+}
+
+FWalkabilityGrid::FWalkabilityGrid(FWalkabilityGrid&& Other)
+{
+	*this = MoveTemp(Other);
+}
+
+FWalkabilityGrid& FWalkabilityGrid::operator=(const FWalkabilityGrid& Other)
+{
+	if (this != &Other)
+	{
+		// Shared tiles are never written, copies read the same storage
+		TileWords = Other.TileWords;
+		TileSlots = Other.TileSlots;
+		FreeTiles = Other.FreeTiles;
+		SharedStorage = Other.SharedStorage;
+		GridSizeX = Other.GridSizeX;
+		GridSizeY = Other.GridSizeY;
+		TilesX = Other.TilesX;
+		TilesY = Other.TilesY;
+		ReadTileSlots = Other.ReadTileSlots;
+		ReadTileWords = Other.ReadTileWords;
+		CostTiles = Other.CostTiles;
+		CostTileSlots = Other.CostTileSlots;
+		CostTileCounts = Other.CostTileCounts;
+		FreeCostTiles = Other.FreeCostTiles;
+		CellCostCounts = Other.CellCostCounts;
+		MinCellCost = Other.MinCellCost;
+		UpdateReadViews();
+	}
+	return *this;
+}
+
+FWalkabilityGrid& FWalkabilityGrid::operator=(FWalkabilityGrid&& Other)
+{
+	if (this != &Other)
+	{
+		TileWords = MoveTemp(Other.TileWords);
+		TileSlots = MoveTemp(Other.TileSlots);
+		FreeTiles = MoveTemp(Other.FreeTiles);
+		SharedStorage = MoveTemp(Other.SharedStorage);
+		GridSizeX = Other.GridSizeX;
+		GridSizeY = Other.GridSizeY;
+		TilesX = Other.TilesX;
+		TilesY = Other.TilesY;
+		ReadTileSlots = Other.ReadTileSlots;
+		ReadTileWords = Other.ReadTileWords;
+		CostTiles = MoveTemp(Other.CostTiles);
+		CostTileSlots = MoveTemp(Other.CostTileSlots);
+		CostTileCounts = MoveTemp(Other.CostTileCounts);
+		FreeCostTiles = MoveTemp(Other.FreeCostTiles);
+		CellCostCounts = MoveTemp(Other.CellCostCounts);
+		MinCellCost = Other.MinCellCost;
+		UpdateReadViews();
+		Other.Empty();
+	}
+	return *this;
+}
+
+void FWalkabilityGrid::Init(int32 InGridSizeX, int32 InGridSizeY, bool bIsCrossable)
+{
+	check(IsValidSize(InGridSizeX, InGridSizeY));
+	GridSizeX = InGridSizeX;
+	GridSizeY = InGridSizeY;
+	TilesX = (GridSizeX + TILE_MASK) >> TILE_SHIFT;
+	TilesY = (GridSizeY + TILE_MASK) >> TILE_SHIFT;
+
+	TileWords.SetNumUninitialized(NUM_UNIFORM_TILES * TILE_SIZE);
+	for (int32 Row = 0; Row < TILE_SIZE; ++Row)
+	{
+		TileWords[BLOCKED_TILE * TILE_SIZE + Row] = 0;
+		TileWords[CROSSABLE_TILE * TILE_SIZE + Row] = ~uint64(0);
+	}
+
+	TileSlots.Init(bIsCrossable ? CROSSABLE_TILE : BLOCKED_TILE, TilesX * TilesY);
+	FreeTiles.Reset();
+	SharedStorage.Reset();
+	UpdateReadViews();
+	ResetCellCosts();
+}
+
+void FWalkabilityGrid::InitTiles(int32 InGridSizeX, int32 InGridSizeY,
+	TFunctionRef<void(int32 TileX, int32 TileY, uint64* OutRows)> FillTile)
+{
+	Init(InGridSizeX, InGridSizeY, false);
+
+	uint64 Rows[TILE_SIZE];
+	for (int32 TileY = 0; TileY < TilesY; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			FMemory::Memzero(Rows, sizeof(Rows));
+			FillTile(TileX, TileY, Rows);
+
+			int32& Slot = TileSlots[TileY * TilesX + TileX];
+			if (!IsUniformTile(Rows, TileX, TileY, Slot))
+			{
+				Slot = TileWords.Num() >> TILE_SHIFT;
+				TileWords.Append(Rows, TILE_SIZE);
+			}
+		}
+	}
+	UpdateReadViews();
+}
+
+void FWalkabilityGrid::InitShared(int32 InGridSizeX, int32 InGridSizeY, TConstArrayView<int32> InTileSlots,
+	TConstArrayView<uint64> InTileWords, const TSharedRef<FWalkabilityTileStorage>& Storage)
+{
+	check(IsValidSize(InGridSizeX, InGridSizeY));
+	GridSizeX = InGridSizeX;
+	GridSizeY = InGridSizeY;
+	TilesX = (GridSizeX + TILE_MASK) >> TILE_SHIFT;
+	TilesY = (GridSizeY + TILE_MASK) >> TILE_SHIFT;
+	check(InTileSlots.Num() == TilesX * TilesY && InTileWords.Num() >= NUM_UNIFORM_TILES * TILE_SIZE);
+
+	TileWords.Empty();
+	TileSlots.Empty();
+	FreeTiles.Empty();
+	SharedStorage = Storage;
+	ReadTileSlots = InTileSlots;
+	ReadTileWords = InTileWords;
+	ResetCellCosts();
+}
+
+void FWalkabilityGrid::Empty()
+{
+	TileWords.Empty();
+	TileSlots.Empty();
+	FreeTiles.Empty();
+	SharedStorage.Reset();
+	ReadTileSlots = {};
+	ReadTileWords = {};
+	ResetCellCosts();
+	GridSizeX = 0;
+	GridSizeY = 0;
+	TilesX = 0;
+	TilesY = 0;
+}
+
+void FWalkabilityGrid::SetCrossable(int32 X, int32 Y, bool bIsCrossable)
+{
+	const bool bWasCrossable = (GetRowWord(X, Y) >> (X & TILE_MASK)) & 1;
+	if (bWasCrossable == bIsCrossable)
+	{
+		return;
+	}
+
+	if (SharedStorage)
+	{
+		CopySharedTiles();
+	}
+
+	int32& Slot = TileSlots[(Y >> TILE_SHIFT) * TilesX + (X >> TILE_SHIFT)];
+	const uint64 Mask = uint64(1) << (X & TILE_MASK);
+	if (Slot < NUM_UNIFORM_TILES)
+	{
+		Slot = AllocateTile(Slot);
+	}
+	TileWords[(Slot << TILE_SHIFT) + (Y & TILE_MASK)] ^= Mask;
+
+	// A tile whose last wall was removed goes back to sharing, memory only grows with the tiles holding walls
+	int32 UniformSlot;
+	if (IsUniformTile(&TileWords[Slot << TILE_SHIFT], X >> TILE_SHIFT, Y >> TILE_SHIFT, UniformSlot))
+	{
+		FreeTiles.Add(Slot);
+		Slot = UniformSlot;
+	}
+}
+
+void FWalkabilityGrid::SetCellCost(int32 X, int32 Y, uint8 Cost)
+{
+	check(Cost > 0);
+	if (Cost == GetCellCost(X, Y))
+	{
+		return;
+	}
+
+	// Every tile starts on the shared default tile, memory follows the number of tiles holding other costs
+	if (HasUniformCosts())
+	{
+		CostTiles.Init(DEFAULT_CELL_COST, NUM_TILE_CELLS);
+		CostTileSlots.Init(DEFAULT_COST_TILE, TilesX * TilesY);
+		CostTileCounts.Init(0, 1);
+		CellCostCounts.SetNumZeroed(MAX_uint8 + 1);
+		CellCostCounts[DEFAULT_CELL_COST] = Num();
+	}
+
+	int32& Slot = CostTileSlots[(Y >> TILE_SHIFT) * TilesX + (X >> TILE_SHIFT)];
+	if (Slot == DEFAULT_COST_TILE)
+	{
+		Slot = AllocateCostTile();
+	}
+
+	uint8& CellCost = CostTiles[(Slot << COST_TILE_SHIFT) + ((Y & TILE_MASK) << TILE_SHIFT) + (X & TILE_MASK)];
+	CostTileCounts[Slot] += (Cost != DEFAULT_CELL_COST) - (CellCost != DEFAULT_CELL_COST);
+	--CellCostCounts[CellCost];
+	++CellCostCounts[Cost];
+	CellCost = Cost;
+
+	// A grid painted back to the default cost returns to the uniform solver path
+	if (CellCostCounts[DEFAULT_CELL_COST] == Num())
+	{
+		ResetCellCosts();
+		return;
+	}
+
+	if (CostTileCounts[Slot] == 0)
+	{
+		FreeCostTiles.Add(Slot);
+		Slot = DEFAULT_COST_TILE;
+	}
+	UpdateMinCellCost();
+}
+
+void FWalkabilityGrid::ResetCellCosts()
+{
+	CostTiles.Empty();
+	CostTileSlots.Empty();
+	CostTileCounts.Empty();
+	FreeCostTiles.Empty();
+	CellCostCounts.Empty();
+	MinCellCost = DEFAULT_CELL_COST;
+}
+
+bool FWalkabilityGrid::InitCostTiles(TConstArrayView<int32> InCostTileSlots, TConstArrayView<uint8> InCostTiles)
+{
+	ResetCellCosts();
+	const int32 NumSourceSlots = InCostTiles.Num() / NUM_TILE_CELLS;
+	if (InCostTileSlots.Num() != TilesX * TilesY || NumSourceSlots == 0)
+	{
+		return false;
+	}
+
+	CostTiles.Init(DEFAULT_CELL_COST, NUM_TILE_CELLS);
+	CostTileSlots.Init(DEFAULT_COST_TILE, TilesX * TilesY);
+	CostTileCounts.Init(0, 1);
+	CellCostCounts.SetNumZeroed(MAX_uint8 + 1);
+	CellCostCounts[DEFAULT_CELL_COST] = Num();
+
+	// Source tiles are copied cell by cell, cells past the grid keep the default cost of the new tiles
+	for (int32 TileY = 0; TileY < TilesY; ++TileY)
+	{
+		const int32 NumRows = FMath::Min(TILE_SIZE, GridSizeY - (TileY << TILE_SHIFT));
+		for (int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			const int32 SourceSlot = InCostTileSlots[TileY * TilesX + TileX];
+			if (SourceSlot == DEFAULT_COST_TILE)
+			{
+				continue;
+			}
+			if (static_cast<uint32>(SourceSlot) >= static_cast<uint32>(NumSourceSlots))
+			{
+				ResetCellCosts();
+				return false;
+			}
+
+			const int32 Slot = AllocateCostTile();
+			const int32 NumColumns = FMath::Min(TILE_SIZE, GridSizeX - (TileX << TILE_SHIFT));
+			for (int32 Row = 0; Row < NumRows; ++Row)
+			{
+				for (int32 Column = 0; Column < NumColumns; ++Column)
+				{
+					const int32 CellOffset = (Row << TILE_SHIFT) + Column;
+					const uint8 Cost = InCostTiles[(SourceSlot << COST_TILE_SHIFT) + CellOffset];
+					if (Cost == 0)
+					{
+						ResetCellCosts();
+						return false;
+					}
+
+					CostTiles[(Slot << COST_TILE_SHIFT) + CellOffset] = Cost;
+					if (Cost != DEFAULT_CELL_COST)
+					{
+						++CostTileCounts[Slot];
+						--CellCostCounts[DEFAULT_CELL_COST];
+						++CellCostCounts[Cost];
+					}
+				}
+			}
+
+			if (CostTileCounts[Slot] == 0)
+			{
+				FreeCostTiles.Add(Slot);
+			}
+			else
+			{
+				CostTileSlots[TileY * TilesX + TileX] = Slot;
+			}
+		}
+	}
+
+	if (CellCostCounts[DEFAULT_CELL_COST] == Num())
+	{
+		ResetCellCosts();
+	}
+	else
+	{
+		UpdateMinCellCost();
+	}
+	return true;
+}
+
+void FWalkabilityGrid::UpdateReadViews()
+{
+	if (!SharedStorage)
+	{
+		ReadTileSlots = TileSlots;
+		ReadTileWords = TileWords;
+	}
+}
+
+void FWalkabilityGrid::CopySharedTiles()
+{
+	TileSlots.Reset();
+	TileSlots.Append(ReadTileSlots.GetData(), ReadTileSlots.Num());
+	TileWords.Reset();
+	TileWords.Append(ReadTileWords.GetData(), ReadTileWords.Num());
+	FreeTiles.Reset();
+	SharedStorage.Reset();
+	UpdateReadViews();
+}
+
+uint32 FWalkabilityGrid::GetNeighborMaskAcrossTiles(int32 X, int32 Y) const
+{
+	return IsCrossable(X - 1, Y + 1)
+		| (IsCrossable(X, Y + 1) << 1)
+		| (IsCrossable(X + 1, Y + 1) << 2)
+		| (IsCrossable(X - 1, Y) << 3)
+		| (IsCrossable(X + 1, Y) << 4)
+		| (IsCrossable(X - 1, Y - 1) << 5)
+		| (IsCrossable(X, Y - 1) << 6)
+		| (IsCrossable(X + 1, Y - 1) << 7);
+}
+
+int32 FWalkabilityGrid::AllocateTile(int32 SourceSlot)
+{
+	int32 Slot;
+	if (FreeTiles.Num() > 0)
+	{
+		Slot = FreeTiles.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = TileWords.Num() >> TILE_SHIFT;
+		TileWords.AddUninitialized(TILE_SIZE);
+		UpdateReadViews();
+	}
+
+	FMemory::Memcpy(&TileWords[Slot << TILE_SHIFT], &TileWords[SourceSlot << TILE_SHIFT], TILE_SIZE * sizeof(uint64));
+	return Slot;
+}
+
+int32 FWalkabilityGrid::AllocateCostTile()
+{
+	// Released tiles are back at the default cost, they are reused as they are
+	if (FreeCostTiles.Num() > 0)
+	{
+		return FreeCostTiles.Pop(EAllowShrinking::No);
+	}
+
+	const int32 Slot = CostTileCounts.Add(0);
+	CostTiles.AddUninitialized(NUM_TILE_CELLS);
+	FMemory::Memset(&CostTiles[Slot << COST_TILE_SHIFT], DEFAULT_CELL_COST, NUM_TILE_CELLS);
+	return Slot;
+}
+
+void FWalkabilityGrid::UpdateMinCellCost()
+{
+	MinCellCost = 1;
+	while (CellCostCounts[MinCellCost] == 0)
+	{
+		++MinCellCost;
+	}
+}
+
+bool FWalkabilityGrid::IsUniformTile(const uint64* Rows, int32 TileX, int32 TileY, int32& OutUniformSlot) const
+{
+	// Tiles on the last row or column are cut by the grid, the cells past it are never read
+	const int32 NumColumns = FMath::Min(TILE_SIZE, GridSizeX - (TileX << TILE_SHIFT));
+	const int32 NumRows = FMath::Min(TILE_SIZE, GridSizeY - (TileY << TILE_SHIFT));
+	const uint64 ColumnMask = NumColumns == TILE_SIZE ? ~uint64(0) : (uint64(1) << NumColumns) - 1;
+
+	const uint64 First = Rows[0] & ColumnMask;
+	if (First != 0 && First != ColumnMask)
+	{
+		return false;
+	}
+
+	for (int32 Row = 1; Row < NumRows; ++Row)
+	{
+		if ((Rows[Row] & ColumnMask) != First)
+		{
+			return false;
+		}
+	}
+
+	OutUniformSlot = First == 0 ? BLOCKED_TILE : CROSSABLE_TILE;
+	return true;
+}
@@ -0,0 +1,291 @@
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+
+/** Memory holding the tiles of a grid that reads them in place, a mapped grid file, kept alive by every such grid */
+class FWalkabilityTileStorage
+{
+public:
+	virtual ~FWalkabilityTileStorage() = default;
+};
+
+/**
+ * Walkability of every grid cell, one bit per cell, stored in tiles of 64x64 cells.
+ * A tile is 64 words, one per row. Uniform tiles all share one of two tiles, fully blocked or fully crossable,
+ * and get their own words on the first edit: memory follows the number of tiles holding walls, not the grid area.
+ * Tiles are found through a flat table of tile slots, there is no hashing on the cell accessors.
+ * The table and the tiles can also be read in place from a FWalkabilityTileStorage, the first edit copies them.
+ * Cells outside the grid read as blocked.
+ * Beside the walkability, each cell has a traversal cost multiplying the moves entering it (mud, road, water).
+ * Costs are one byte per cell, in tiles of 64x64 cells like the walkability. Tiles at the default cost share one
+ * tile and get their own bytes on the first edit, the cost tiles are allocated by the first cost other than
+ * DEFAULT_CELL_COST.
+ * World positions are not stored, AGridManager derives them from its origin and cell size.
+ */
+struct ASTARPATHFINDING_API FWalkabilityGrid
+{
+	//////// FIELDS ////////
+	static constexpr int32 TILE_SHIFT = 6;
+	static constexpr int32 TILE_SIZE = 1 << TILE_SHIFT;
+	static constexpr int32 TILE_MASK = TILE_SIZE - 1;
+
+	/** Slots of the shared tiles at the start of the tile words */
+	static constexpr int32 BLOCKED_TILE = 0;
+	static constexpr int32 CROSSABLE_TILE = 1;
+	static constexpr int32 NUM_UNIFORM_TILES = 2;
+
+	/** Cost tiles hold one byte per cell, the shared tile at the default cost comes first */
+	static constexpr int32 COST_TILE_SHIFT = 2 * TILE_SHIFT;
+	static constexpr int32 NUM_TILE_CELLS = 1 << COST_TILE_SHIFT;
+	static constexpr int32 DEFAULT_COST_TILE = 0;
+
+	/** Cost of every cell of a grid without a cost layer, costs range from 1 to 255 */
+	static constexpr uint8 DEFAULT_CELL_COST = 1;
+
+	/** Largest grid area, solvers index cells with int32 and the JPS+ table holds 8 entries per cell */
+	static constexpr int64 MAX_NUM_CELLS = MAX_int32 / 8;
+	/** Longest grid side, keeps the octile estimates across the grid in int32 */
+	static constexpr int32 MAX_GRID_SIZE = 1 << 20;
+
+	//////// CONSTRUCTORS ////////
+	FWalkabilityGrid() = default;
+	FWalkabilityGrid(const FWalkabilityGrid& Other);
+	FWalkabilityGrid(FWalkabilityGrid&& Other);
+	FWalkabilityGrid& operator=(const FWalkabilityGrid& Other);
+	FWalkabilityGrid& operator=(FWalkabilityGrid&& Other);
+
+	//////// METHODS ////////
+	/// Grid methods
+	/** Whether a grid of this size can be built, callers reject or clamp the sizes that cannot */
+	static bool IsValidSize(int64 InGridSizeX, int64 InGridSizeY)
+	{
+		return InGridSizeX > 0 && InGridSizeY > 0 && InGridSizeX <= MAX_GRID_SIZE && InGridSizeY <= MAX_GRID_SIZE
+			&& InGridSizeX * InGridSizeY <= MAX_NUM_CELLS;
+	}
+
+	/** Resizes the grid and sets every cell, every tile starts shared */
+	void Init(int32 InGridSizeX, int32 InGridSizeY, bool bIsCrossable = true);
+	void Empty();
+
+	/**
+	 * Resizes the grid and builds each tile at once, for importers. FillTile receives TILE_SIZE zeroed rows of the
+	 * tile and sets the crossable cells, bit B of row R being the cell (TileX * TILE_SIZE + B, TileY * TILE_SIZE + R).
+	 * Tiles that come out uniform are shared.
+	 */
+	void InitTiles(int32 InGridSizeX, int32 InGridSizeY,
+		TFunctionRef<void(int32 TileX, int32 TileY, uint64* OutRows)> FillTile);
+
+	/**
+	 * Reads the tiles in place from Storage, in the layout of GetTileSlots and GetTileWords.
+	 * Slots must be below InTileWords.Num() / TILE_SIZE and the first tiles must be the uniform ones.
+	 */
+	void InitShared(int32 InGridSizeX, int32 InGridSizeY, TConstArrayView<int32> InTileSlots,
+		TConstArrayView<uint64> InTileWords, const TSharedRef<FWalkabilityTileStorage>& Storage);
+
+	int32 GetSizeX() const
+	{
+		return GridSizeX;
+	}
+
+	int32 GetSizeY() const
+	{
+		return GridSizeY;
+	}
+
+	int64 Num() const
+	{
+		return static_cast<int64>(GridSizeX) * GridSizeY;
+	}
+
+	int32 GetNumTilesX() const
+	{
+		return TilesX;
+	}
+
+	int32 GetNumTilesY() const
+	{
+		return TilesY;
+	}
+
+	/** Number of tiles with their own words, the others share a uniform tile */
+	int32 GetNumDenseTiles() const
+	{
+		return ReadTileWords.Num() / TILE_SIZE - NUM_UNIFORM_TILES - FreeTiles.Num();
+	}
+
+	/** Tiles read in place from a storage are not counted */
+	SIZE_T GetAllocatedSize() const
+	{
+		return TileWords.GetAllocatedSize() + TileSlots.GetAllocatedSize() + FreeTiles.GetAllocatedSize()
+			+ CostTiles.GetAllocatedSize() + CostTileSlots.GetAllocatedSize() + CostTileCounts.GetAllocatedSize()
+			+ FreeCostTiles.GetAllocatedSize() + CellCostCounts.GetAllocatedSize();
+	}
+
+	/// Tile methods
+	/** Slot of each tile row by row, a tile's words start at Slot * TILE_SIZE in GetTileWords */
+	TConstArrayView<int32> GetTileSlots() const
+	{
+		return ReadTileSlots;
+	}
+
+	/** TILE_SIZE words per slot, the uniform tiles first. Released slots hold stale words */
+	TConstArrayView<uint64> GetTileWords() const
+	{
+		return ReadTileWords;
+	}
+
+	/// Cell methods
+	/** X and Y range from -1 to GridSize */
+	FORCEINLINE bool IsCrossable(int32 X, int32 Y) const
+	{
+		if (static_cast<uint32>(X) >= static_cast<uint32>(GridSizeX)
+			|| static_cast<uint32>(Y) >= static_cast<uint32>(GridSizeY))
+		{
+			return false;
+		}
+		return (GetRowWord(X, Y) >> (X & TILE_MASK)) & 1;
+	}
+
+	/** Same test from a cell index Y * GridSizeX + X, prefer the coordinates in loops */
+	FORCEINLINE bool IsCrossable(int32 Index) const
+	{
+		return IsCrossable(Index % GridSizeX, Index / GridSizeX);
+	}
+
+	/** X and Y range from 0 to GridSize - 1. Writing to a shared tile gives it its own words first */
+	void SetCrossable(int32 X, int32 Y, bool bIsCrossable);
+
+	/**
+	 * Walkability of the 8 neighbors of a cell in 8 bits, X and Y range from 0 to GridSize - 1.
+	 * Bits follow the directions of FEightWayNeighborhood:
+	 *   0   1   2
+	 *   3  [C]  4
+	 *   5   6   7
+	 * with bits 0 to 2 on row Y + 1.
+	 */
+	FORCEINLINE uint32 GetNeighborMask(int32 X, int32 Y) const
+	{
+		// Most cells have their whole 3x3 block inside one tile and the grid, its 3 rows are consecutive words
+		const int32 LocalX = X & TILE_MASK;
+		const int32 LocalY = Y & TILE_MASK;
+		if (static_cast<uint32>(LocalX - 1) < TILE_SIZE - 2 && static_cast<uint32>(LocalY - 1) < TILE_SIZE - 2
+			&& X + 1 < GridSizeX && Y + 1 < GridSizeY)
+		{
+			const uint64* Rows = &GetRowWord(X, Y);
+			const int32 Shift = LocalX - 1;
+			const uint32 Above = static_cast<uint32>(Rows[1] >> Shift) & 7;
+			const uint32 Middle = static_cast<uint32>(Rows[0] >> Shift) & 7;
+			const uint32 Below = static_cast<uint32>(Rows[-1] >> Shift) & 7;
+			return Above | ((Middle & 1) << 3) | ((Middle >> 2) << 4) | (Below << 5);
+		}
+		return GetNeighborMaskAcrossTiles(X, Y);
+	}
+
+	/// Cost methods
+	/** Whether every cell costs DEFAULT_CELL_COST, solvers then skip the cost lookups */
+	FORCEINLINE bool HasUniformCosts() const
+	{
+		return CostTileSlots.Num() == 0;
+	}
+
+	/** Lowest cell cost, solvers scale their heuristic by it to keep it admissible */
+	FORCEINLINE uint8 GetMinCellCost() const
+	{
+		return MinCellCost;
+	}
+
+	/** X and Y range from 0 to GridSize - 1 */
+	FORCEINLINE uint8 GetCellCost(int32 X, int32 Y) const
+	{
+		return HasUniformCosts() ? DEFAULT_CELL_COST : GetLayerCellCost(X, Y);
+	}
+
+	/** Same cost read straight from the cost tiles, only while HasUniformCosts is false */
+	FORCEINLINE uint8 GetLayerCellCost(int32 X, int32 Y) const
+	{
+		const int32 Slot = CostTileSlots.GetData()[(Y >> TILE_SHIFT) * TilesX + (X >> TILE_SHIFT)];
+		return CostTiles.GetData()[(Slot << COST_TILE_SHIFT) + ((Y & TILE_MASK) << TILE_SHIFT) + (X & TILE_MASK)];
+	}
+
+	/** Cost tile slot of each tile row by row, DEFAULT_COST_TILE for tiles at the default cost, empty while uniform */
+	TConstArrayView<int32> GetCostTileSlots() const
+	{
+		return CostTileSlots;
+	}
+
+	/** NUM_TILE_CELLS costs per slot, row by row. Released slots and cells past the grid are at the default cost */
+	TConstArrayView<uint8> GetCostTiles() const
+	{
+		return CostTiles;
+	}
+
+	/**
+	 * X and Y range from 0 to GridSize - 1, Cost from 1 to 255.
+	 * The layer is released when every cell is back to DEFAULT_CELL_COST.
+	 */
+	void SetCellCost(int32 X, int32 Y, uint8 Cost);
+
+	/** Sets every cell back to DEFAULT_CELL_COST and releases the layer */
+	void ResetCellCosts();
+
+	/**
+	 * Copies the costs from tiles laid out like GetCostTileSlots and GetCostTiles, for loaders.
+	 * Fails and leaves the costs uniform when a slot is out of range or a cell costs 0.
+	 */
+	bool InitCostTiles(TConstArrayView<int32> InCostTileSlots, TConstArrayView<uint8> InCostTiles);
+
+	/// Word methods
+	/**
+	 * Row Y of the tile holding the cell X, bit B holds the cell (X & ~TILE_MASK) + B.
+	 * X and Y range from 0 to GridSize - 1, bits past the grid are undefined.
+	 */
+	FORCEINLINE const uint64& GetRowWord(int32 X, int32 Y) const
+	{
+		const int32 Slot = ReadTileSlots.GetData()[(Y >> TILE_SHIFT) * TilesX + (X >> TILE_SHIFT)];
+		return ReadTileWords.GetData()[(Slot << TILE_SHIFT) + (Y & TILE_MASK)];
+	}
+
+private:
+	//////// FIELDS ////////
+	/** TILE_SIZE words per tile slot, the uniform tiles first */
+	TArray<uint64> TileWords;
+	/** Slot of each tile, row by row */
+	TArray<int32> TileSlots;
+	/** Slots released by tiles that became uniform again */
+	TArray<int32> FreeTiles;
+	/** Set while the tiles are read in place, the arrays above are empty until the first edit */
+	TSharedPtr<FWalkabilityTileStorage> SharedStorage;
+	/** Tiles the accessors read, the arrays above or the shared storage */
+	TConstArrayView<int32> ReadTileSlots;
+	TConstArrayView<uint64> ReadTileWords;
+	/** NUM_TILE_CELLS costs per cost tile slot, the default tile first, empty while every cell costs the default */
+	TArray<uint8> CostTiles;
+	/** Cost tile slot of each tile, row by row */
+	TArray<int32> CostTileSlots;
+	/** Cells of each cost tile slot not at the default cost, a tile going back to 0 shares the default tile again */
+	TArray<int32> CostTileCounts;
+	/** Cost tile slots released by tiles back at the default cost */
+	TArray<int32> FreeCostTiles;
+	/** Number of cells of each cost while the layer is allocated, keeps MinCellCost without scanning the grid */
+	TArray<int64> CellCostCounts;
+	uint8 MinCellCost = DEFAULT_CELL_COST;
+	int32 GridSizeX = 0;
+	int32 GridSizeY = 0;
+	int32 TilesX = 0;
+	int32 TilesY = 0;
+
+	//////// METHODS ////////
+	/** Points the read views at the owned arrays, after they moved or reallocated */
+	void UpdateReadViews();
+	/** Copies the shared tiles into the owned arrays before an edit */
+	void CopySharedTiles();
+
+	/** Slower path of GetNeighborMask for cells on the edge of a tile or of the grid */
+	uint32 GetNeighborMaskAcrossTiles(int32 X, int32 Y) const;
+
+	int32 AllocateTile(int32 SourceSlot);
+	/** Slot of a new cost tile at the default cost */
+	int32 AllocateCostTile();
+	void UpdateMinCellCost();
+	bool IsUniformTile(const uint64* Rows, int32 TileX, int32 TileY, int32& OutUniformSlot) const;
+};
@@ -0,0 +1,20 @@
+// PathfindingCore.h
+#pragma once
+
+/**
+ * Engine types the grid and the solvers (everything in Solver/ but the UObject glue) are written against: containers,
+ * math, asserts, logging, stats and trace scopes. FPathRequestQueue also includes the lock, queue and task headers.
+ * The module gets them from the engine. The standalone build of the core (CMakeLists.txt at the root of the project)
+ * defines ASTARPATHFINDING_STANDALONE and gets standard library versions of the same subset, so its tests,
+ * benchmark and profiler runs execute the code that ships. The core only uses what both provide.
+ */
+#if defined(ASTARPATHFINDING_STANDALONE) && ASTARPATHFINDING_STANDALONE
+#include "PathfindingCoreStandalone.h"
+#else
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Templates/Function.h"
+#include "Templates/IntegerSequence.h"
+#endif
@@ -0,0 +1,304 @@
+#include "AnyAnglePathFinder.h"
+#include "PathFinderContext.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    using FCostTraits = TPathCostTraits<float>;
+    using FNeighborhood = FEightWayNeighborhood;
+
+    struct FAnyAngleQuery
+    {
+        const FWalkabilityGrid& Grid;
+        int32 GridSizeX;
+        int32 GridSizeY;
+        int32 GoalX;
+        int32 GoalY;
+    };
+
+    FORCEINLINE float GetDistance(int32 FromIndex, int32 ToIndex, int32 GridSizeX)
+    {
+        const float DeltaX = static_cast<float>(ToIndex % GridSizeX - FromIndex % GridSizeX);
+        const float DeltaY = static_cast<float>(ToIndex / GridSizeX - FromIndex / GridSizeX);
+        return FMath::Sqrt(DeltaX * DeltaX + DeltaY * DeltaY);
+    }
+
+    FORCEINLINE bool HasLineOfSight(const FAnyAngleQuery& Query, int32 FromIndex, int32 ToIndex)
+    {
+        return AnyAnglePathFinder::HasLineOfSight(Query.Grid, FromIndex % Query.GridSizeX,
+            FromIndex / Query.GridSizeX, ToIndex % Query.GridSizeX, ToIndex / Query.GridSizeX);
+    }
+
+    FORCEINLINE float GetCost(const FPathFinderContext& Context, int32 Index)
+    {
+        return FCostTraits::Unpack(Context.GetPackedCost(Index));
+    }
+
+    void ReconstructPathToStart(const FPathFinderContext& Context, int32 EndIndex, int32 StartIndex, float CellSize,
+        TArray<FVector>& OutPath)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AStar_Reconstruction);
+
+        const int32 GridSizeX = Context.GridSizeX;
+
+        int32 PathLength = 1;
+        for (int32 Index = EndIndex; Index != StartIndex; Index = Context.ParentIndices[Index])
+        {
+            ++PathLength;
+        }
+
+        // One waypoint per parent, filling the path from its end
+        OutPath.Reset();
+        OutPath.AddUninitialized(PathLength);
+
+        int32 Index = EndIndex;
+        for (int32 PathIndex = PathLength - 1; PathIndex >= 0; --PathIndex)
+        {
+            OutPath[PathIndex] = FVector((Index % GridSizeX + 0.5f) * CellSize, (Index / GridSizeX + 0.5f) * CellSize,
+                0.0f);
+            Index = Context.ParentIndices[Index];
+        }
+    }
+
+    /// Lazy Theta*: links a cell whose assumed parent is hidden to its best expanded neighbor instead
+    void SetVertex(FPathFinderContext& Context, const FAnyAngleQuery& Query, int32 Index, int32 X, int32 Y)
+    {
+        const int32 ParentIndex = Context.ParentIndices[Index];
+        if (HasLineOfSight(Query, ParentIndex, Index))
+        {
+            return;
+        }
+
+        float BestCost = MAX_flt;
+        for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+        {
+            const int32 NeighborX = X + FNeighborhood::OFFSET_X[Direction];
+            const int32 NeighborY = Y + FNeighborhood::OFFSET_Y[Direction];
+            if (static_cast<uint32>(NeighborX) >= static_cast<uint32>(Query.GridSizeX)
+                || static_cast<uint32>(NeighborY) >= static_cast<uint32>(Query.GridSizeY))
+            {
+                continue;
+            }
+
+            // The cell that reached this one is expanded, so there is always a candidate
+            const int32 NeighborIndex = NeighborY * Query.GridSizeX + NeighborX;
+            Context.TouchNode(NeighborIndex);
+            if (!Context.IsClosed(NeighborIndex))
+            {
+                continue;
+            }
+
+            const float Cost = GetCost(Context, NeighborIndex) + GetDistance(NeighborIndex, Index, Query.GridSizeX);
+            if (Cost < BestCost)
+            {
+                BestCost = Cost;
+                Context.ParentIndices[Index] = NeighborIndex;
+            }
+        }
+        Context.SetPackedCost(Index, FCostTraits::Pack(BestCost, 0));
+    }
+
+    template <typename OpenListType>
+    bool Search(FPathFinderContext& Context, const FAnyAngleQuery& Query, int32 StartX, int32 StartY, float CellSize,
+        bool bIsLazy, TArray<FVector>& OutPath, TArray<FVector>& OutExploredNodes)
+    {
+        const int32 GridSizeX = Query.GridSizeX;
+        const int32 GridSizeY = Query.GridSizeY;
+        const int32 StartIndex = StartY * GridSizeX + StartX;
+        const int32 GoalIndex = Query.GoalY * GridSizeX + Query.GoalX;
+
+        OpenListType& NodesToExplore = Context.GetOpenList<OpenListType>();
+        {
+            SCOPE_CYCLE_COUNTER(STAT_AStar_Init);
+
+            Context.BeginQuery(GridSizeX, GridSizeY);
+            Context.EnsureParentIndices();
+
+            NodesToExplore.Initialize(GridSizeX * GridSizeY);
+            NodesToExplore.Reset();
+
+            const uint32 StartKey = FCostTraits::ToKey(GetDistance(StartIndex, GoalIndex, GridSizeX));
+            Context.TouchNode(StartIndex);
+            Context.SetPackedCost(StartIndex, FCostTraits::Pack(0.0f, 0));
+            Context.ParentIndices[StartIndex] = StartIndex;
+            NodesToExplore.Push(StartIndex, StartKey, StartKey);
+        }
+
+        SCOPE_CYCLE_COUNTER(STAT_AStar_Search);
+
+        while (!NodesToExplore.IsEmpty())
+        {
+            const int32 CurrentIndex = NodesToExplore.Pop();
+            const int32 CurrentX = CurrentIndex % GridSizeX;
+            const int32 CurrentY = CurrentIndex / GridSizeX;
+
+            OutExploredNodes.Add(FVector((CurrentX + 0.5f) * CellSize, (CurrentY + 0.5f) * CellSize, 0.0f));
+
+            if (bIsLazy && CurrentIndex != StartIndex)
+            {
+                SetVertex(Context, Query, CurrentIndex, CurrentX, CurrentY);
+            }
+
+            if (CurrentIndex == GoalIndex)
+            {
+                ReconstructPathToStart(Context, GoalIndex, StartIndex, CellSize, OutPath);
+                return true;
+            }
+
+            Context.SetClosed(CurrentIndex);
+
+            const int32 ParentIndex = Context.ParentIndices[CurrentIndex];
+            const float CurrentCost = GetCost(Context, CurrentIndex);
+            const float ParentCost = GetCost(Context, ParentIndex);
+
+            for (uint32 Mask = Query.Grid.GetNeighborMask(CurrentX, CurrentY); Mask != 0; Mask &= Mask - 1)
+            {
+                const int32 Direction = FMath::CountTrailingZeros(Mask);
+                const int32 NeighborIndex = CurrentIndex + FNeighborhood::OFFSET_Y[Direction] * GridSizeX
+                    + FNeighborhood::OFFSET_X[Direction];
+
+                Context.TouchNode(NeighborIndex);
+                if (Context.IsClosed(NeighborIndex))
+                {
+                    continue;
+                }
+
+                // Path 2 goes straight from the parent, Lazy Theta* checks its line of sight on expansion
+                int32 NewParentIndex = CurrentIndex;
+                float NewCostFromStart = CurrentCost + GetDistance(CurrentIndex, NeighborIndex, GridSizeX);
+                if (ParentIndex != CurrentIndex && (bIsLazy || HasLineOfSight(Query, ParentIndex, NeighborIndex)))
+                {
+                    NewParentIndex = ParentIndex;
+                    NewCostFromStart = ParentCost + GetDistance(ParentIndex, NeighborIndex, GridSizeX);
+                }
+
+                const uint32 PackedCost = Context.GetPackedCost(NeighborIndex);
+                const bool IsInList = PackedCost != FPathFinderContext::UNREACHED;
+                if (IsInList && !(NewCostFromStart < FCostTraits::Unpack(PackedCost)))
+                {
+                    continue;
+                }
+
+                const float EstimatedCostToGoal = GetDistance(NeighborIndex, GoalIndex, GridSizeX);
+                const uint32 EstimateKey = FCostTraits::ToKey(EstimatedCostToGoal);
+                Context.SetPackedCost(NeighborIndex, FCostTraits::Pack(NewCostFromStart, 0));
+                Context.ParentIndices[NeighborIndex] = NewParentIndex;
+
+                if (IsInList)
+                {
+                    NodesToExplore.DecreaseKey(NeighborIndex,
+                        FCostTraits::ToKey(FCostTraits::Unpack(PackedCost) + EstimatedCostToGoal),
+                        FCostTraits::ToKey(NewCostFromStart + EstimatedCostToGoal), EstimateKey);
+                }
+                else
+                {
+                    NodesToExplore.Push(NeighborIndex, FCostTraits::ToKey(NewCostFromStart + EstimatedCostToGoal),
+                        EstimateKey);
+                }
+            }
+        }
+
+        return false;
+    }
+}
+
+bool AnyAnglePathFinder::Compute(FPathFinderContext& Context, const FWalkabilityGrid& Grid, int32 GridSizeX,
+    int32 GridSizeY, int32 StartX, int32 StartY, int32 GoalX, int32 GoalY, float CellSize, TArray<FVector>& OutPath,
+    TArray<FVector>& OutExploredNodes, bool bIsLazy, EOpenListType OpenListType)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AnyAnglePathFinder::Compute);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    // Reset keeps the allocations of the caller's buffers
+    OutPath.Reset();
+    OutExploredNodes.Reset();
+
+    if (static_cast<uint32>(StartX) >= static_cast<uint32>(GridSizeX)
+        || static_cast<uint32>(StartY) >= static_cast<uint32>(GridSizeY)
+        || static_cast<uint32>(GoalX) >= static_cast<uint32>(GridSizeX)
+        || static_cast<uint32>(GoalY) >= static_cast<uint32>(GridSizeY))
+    {
+        return false; // Invalid Start or Goal > Impossible path
+    }
+
+    const FAnyAngleQuery Query = { Grid, GridSizeX, GridSizeY, GoalX, GoalY };
+    switch (OpenListType)
+    {
+    case EOpenListType::LinearScan:
+        return Search<FLinearScanOpenList>(Context, Query, StartX, StartY, CellSize, bIsLazy, OutPath,
+            OutExploredNodes);
+    case EOpenListType::QuaternaryHeap:
+        return Search<FQuaternaryHeapOpenList>(Context, Query, StartX, StartY, CellSize, bIsLazy, OutPath,
+            OutExploredNodes);
+    case EOpenListType::BucketQueue:
+    case EOpenListType::BinaryHeap:
+    default:
+        return Search<FBinaryHeapOpenList>(Context, Query, StartX, StartY, CellSize, bIsLazy, OutPath,
+            OutExploredNodes);
+    }
+}
+
+bool AnyAnglePathFinder::HasLineOfSight(const FWalkabilityGrid& Grid, int32 FromX, int32 FromY, int32 ToX,
+    int32 ToY)
+{
+    const int64 DeltaX = FMath::Abs(ToX - FromX);
+    const int64 DeltaY = FMath::Abs(ToY - FromY);
+    const int32 StepX = ToX > FromX ? 1 : -1;
+    const int32 StepY = ToY > FromY ? 1 : -1;
+
+    // Sign of (1 + 2 * StepsX) * DeltaY - (1 + 2 * StepsY) * DeltaX tells which side of the current cell the
+    // segment leaves through: negative through a vertical side, positive through a horizontal one, 0 through a corner
+    int64 Decision = DeltaY - DeltaX;
+    int32 X = FromX;
+    int32 Y = FromY;
+    for (int64 RemainingSteps = DeltaX + DeltaY; RemainingSteps > 0;)
+    {
+        const int32 MoveX = Decision <= 0;
+        const int32 MoveY = Decision >= 0;
+        X += MoveX * StepX;
+        Y += MoveY * StepY;
+        Decision += 2 * (MoveX * DeltaY - MoveY * DeltaX);
+        RemainingSteps -= MoveX + MoveY;
+
+        if (!Grid.IsCrossable(X, Y))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AnyAnglePathFinder::SmoothPath(const FWalkabilityGrid& Grid, float CellSize, TArray<FVector>& InOutPath)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AnyAnglePathFinder::SmoothPath);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    if (InOutPath.Num() <= 2)
+    {
+        return;
+    }
+
+    auto GetCell = [CellSize](const FVector& Position, int32& OutX, int32& OutY)
+    {
+        OutX = FMath::FloorToInt(Position.X / CellSize);
+        OutY = FMath::FloorToInt(Position.Y / CellSize);
+    };
+
+    // The previous point is always visible from the anchor, it is kept once the next one is not
+    int32 AnchorX, AnchorY;
+    GetCell(InOutPath[0], AnchorX, AnchorY);
+    int32 NumKept = 1;
+    for (int32 PathIndex = 2; PathIndex < InOutPath.Num(); ++PathIndex)
+    {
+        int32 X, Y;
+        GetCell(InOutPath[PathIndex], X, Y);
+        if (!HasLineOfSight(Grid, AnchorX, AnchorY, X, Y))
+        {
+            InOutPath[NumKept++] = InOutPath[PathIndex - 1];
+            GetCell(InOutPath[PathIndex - 1], AnchorX, AnchorY);
+        }
+    }
+    InOutPath[NumKept++] = InOutPath.Last();
+    InOutPath.SetNum(NumKept, EAllowShrinking::No);
+}
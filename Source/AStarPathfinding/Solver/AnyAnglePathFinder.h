@@ -0,0 +1,53 @@
+// AnyAnglePathFinder.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "PathFinderTypes.h"
+
+struct FPathFinderContext;
+
+/**
+ * Any-angle paths on the 8-way grid: waypoints are only placed where the path turns around a wall.
+ * - Theta* > https://arxiv.org/abs/1401.3843 checks the line of sight to the parent of each expanded cell when
+ *   reaching a neighbor, and links the neighbor straight to that parent when it is visible.
+ * - Lazy Theta* > http://idm-lab.org/bib/abstracts/papers/aaai10b.pdf assumes the line of sight and only checks it
+ *   when the cell is expanded. It runs one check per expansion instead of one per neighbor, but its optimistic
+ *   costs expand more cells on cluttered grids.
+ * Costs are euclidean distances between cell centers. Paths are shorter than the ones of PathFinder on most queries
+ * and hold a fraction of their waypoints. OutPath holds the waypoints, from start to goal.
+ */
+class ASTARPATHFINDING_API AnyAnglePathFinder
+{
+public:
+    //////// METHODS ////////
+    /// Theta* or Lazy Theta*, bucket queues need integer costs and fall back to the binary heap
+    static bool Compute(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        float CellSize,
+        TArray<FVector>& OutPath,
+        TArray<FVector>& OutExploredNodes,
+        bool bIsLazy = false,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap
+    );
+
+    /**
+     * Whether the segment between the centers of two cells only crosses crossable cells, the first one excepted.
+     * Every cell the segment passes through is tested (supercover). A segment through the exact corner of two
+     * cells does not test them, like the diagonal moves of PathFinder which may cut corners.
+     */
+    static bool HasLineOfSight(const FWalkabilityGrid& Grid, int32 FromX, int32 FromY, int32 ToX, int32 ToY);
+
+    /**
+     * String pulling: drops every waypoint of a cell path that the previous kept waypoint can see past.
+     * Path points are cell centers as returned by the solvers, the first and last points are kept.
+     */
+    static void SmoothPath(const FWalkabilityGrid& Grid, float CellSize, TArray<FVector>& InOutPath);
+};
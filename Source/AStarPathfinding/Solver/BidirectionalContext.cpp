@@ -0,0 +1,64 @@
+#include "BidirectionalContext.h"
+
+void FBidirectionalContext::BeginQuery(int32 GridSizeX, int32 GridSizeY)
+{
+    ForwardContext.BeginQuery(GridSizeX, GridSizeY);
+    BackwardContext.BeginQuery(GridSizeX, GridSizeY);
+
+    const int32 NodeCount = GridSizeX * GridSizeY;
+    if (ForwardCosts.Num() != NodeCount)
+    {
+        ForwardCosts.SetNumUninitialized(NodeCount);
+        BackwardCosts.SetNumUninitialized(NodeCount);
+        QueryTag = 0;
+    }
+
+    // Tag 0 marks entries never written, a wrap forces one full sweep every 2^32 queries
+    if (++QueryTag == 0 || QueryTag == 1)
+    {
+        FMemory::Memzero(ForwardCosts.GetData(), ForwardCosts.Num() * sizeof(int64));
+        FMemory::Memzero(BackwardCosts.GetData(), BackwardCosts.Num() * sizeof(int64));
+        QueryTag = 1;
+    }
+
+    BestMeeting = MAX_int64;
+    bIsSearchDone = 0;
+    ForwardMinKey = 0;
+    BackwardMinKey = 0;
+}
+
+void FBidirectionalContext::OfferMeeting(int32 Cost, int32 NodeIndex)
+{
+    const int64 Meeting = (static_cast<int64>(Cost) << 32) | static_cast<uint32>(NodeIndex);
+    int64 Current = FPlatformAtomics::AtomicRead(&BestMeeting);
+    while (Meeting < Current)
+    {
+        const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(&BestMeeting, Meeting, Current);
+        if (Previous == Current)
+        {
+            return;
+        }
+        Current = Previous;
+    }
+}
+
+SIZE_T FBidirectionalContext::GetAllocatedSize() const
+{
+    return ForwardContext.GetAllocatedSize()
+        + BackwardContext.GetAllocatedSize()
+        + ForwardCosts.GetAllocatedSize()
+        + BackwardCosts.GetAllocatedSize();
+}
+
+void FBidirectionalContext::Empty()
+{
+    ForwardContext.Empty();
+    BackwardContext.Empty();
+    ForwardCosts.Empty();
+    BackwardCosts.Empty();
+    QueryTag = 0;
+    BestMeeting = MAX_int64;
+    bIsSearchDone = 0;
+    ForwardMinKey = 0;
+    BackwardMinKey = 0;
+}
@@ -0,0 +1,58 @@
+// BidirectionalContext.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "PathFinderContext.h"
+
+/**
+ * Search workspace reused across PathFinder::ComputeBidirectional calls.
+ * Each frontier owns a FPathFinderContext and publishes the costs it reaches in a shared array:
+ * - forward costs are costs from the start, backward costs are costs to the goal,
+ * - each entry is (QueryTag << 32) | Cost, read and written atomically, entries of older queries are unreached.
+ * The two frontiers may run on two threads, they only communicate through these arrays and the meeting state.
+ */
+struct ASTARPATHFINDING_API FBidirectionalContext
+{
+    //////// FIELDS ////////
+    /// frontiers
+    FPathFinderContext ForwardContext;
+    FPathFinderContext BackwardContext;
+
+    /// published costs
+    TArray<int64> ForwardCosts;
+    TArray<int64> BackwardCosts;
+    uint32 QueryTag = 0;
+
+    /// best meeting found so far, (Cost << 32) | NodeIndex, MAX_int64 when the frontiers have not met
+    volatile int64 BestMeeting = MAX_int64;
+    volatile int32 bIsSearchDone = 0;
+
+    /// lowest key left in each open list, the search is over once their sum reaches the cost of the best meeting
+    volatile int32 ForwardMinKey = 0;
+    volatile int32 BackwardMinKey = 0;
+
+    //////// METHODS ////////
+    /// Starts a new query, only sweeps the published costs when the grid size changed or the tag wrapped
+    void BeginQuery(int32 GridSizeX, int32 GridSizeY);
+
+    FORCEINLINE int64 MakeTaggedCost(int32 Cost) const
+    {
+        return (static_cast<int64>(QueryTag) << 32) | static_cast<uint32>(Cost);
+    }
+
+    /// Cost published for the current query, INDEX_NONE when the frontier did not reach the node
+    FORCEINLINE int32 ReadCost(const TArray<int64>& Costs, int32 Index) const
+    {
+        const int64 TaggedCost = FPlatformAtomics::AtomicRead(&Costs[Index]);
+        return static_cast<uint32>(TaggedCost >> 32) == QueryTag ? static_cast<int32>(TaggedCost & MAX_uint32) : INDEX_NONE;
+    }
+
+    /// Keeps the cheapest meeting, safe to call from both frontiers at once
+    void OfferMeeting(int32 Cost, int32 NodeIndex);
+
+    /// Bytes held by both frontiers and the published costs
+    SIZE_T GetAllocatedSize() const;
+
+    /// Releases all memory held by the context
+    void Empty();
+};
@@ -0,0 +1,393 @@
+#include "ConnectedComponents.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    using FNeighborhood = FEightWayNeighborhood;
+    using FCostTraits = TPathCostTraits<int32>;
+
+    /// Directions of FEightWayNeighborhood in order around the cell, the straight ones at odd positions
+    constexpr int32 RING_DIRECTIONS[] = { 0, 1, 2, 4, 7, 6, 5, 3 };
+
+    template <typename VisitorType>
+    FORCEINLINE void ForEachCrossableNeighbor(const FWalkabilityGrid& Grid, int32 GridSizeX, int32 Index,
+        VisitorType&& Visit)
+    {
+        const int32 X = Index % GridSizeX;
+        const int32 Y = Index / GridSizeX;
+        for (uint32 Mask = Grid.GetNeighborMask(X, Y); Mask != 0; Mask &= Mask - 1)
+        {
+            const int32 Direction = FMath::CountTrailingZeros(Mask);
+            Visit((Y + FNeighborhood::OFFSET_Y[Direction]) * GridSizeX + X + FNeighborhood::OFFSET_X[Direction]);
+        }
+    }
+}
+
+void FConnectedComponents::Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FConnectedComponents::Build);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    GridSizeX = InGridSizeX;
+    GridSizeY = InGridSizeY;
+    CellLabels.Init(INDEX_NONE, GridSizeX * GridSizeY);
+    LabelParents.Reset();
+    LabelRanks.Reset();
+
+    TArray<int32>& Stack = FloodFills[0].Cells;
+    for (int32 Y = 0; Y < GridSizeY; ++Y)
+    {
+        for (int32 X = 0; X < GridSizeX; ++X)
+        {
+            const int32 Index = Y * GridSizeX + X;
+            if (CellLabels[Index] != INDEX_NONE || !Grid.IsCrossable(X, Y))
+            {
+                continue;
+            }
+
+            const int32 Label = AddLabel();
+            CellLabels[Index] = Label;
+            Stack.Reset();
+            Stack.Add(Index);
+            while (Stack.Num() > 0)
+            {
+                ForEachCrossableNeighbor(Grid, GridSizeX, Stack.Pop(EAllowShrinking::No),
+                    [this, &Stack, Label](int32 NeighborIndex)
+                {
+                    if (CellLabels[NeighborIndex] == INDEX_NONE)
+                    {
+                        CellLabels[NeighborIndex] = Label;
+                        Stack.Add(NeighborIndex);
+                    }
+                });
+            }
+        }
+    }
+    Stack.Reset();
+}
+
+void FConnectedComponents::UpdateCell(const FWalkabilityGrid& Grid, int32 X, int32 Y)
+{
+    const int32 Index = Y * GridSizeX + X;
+    const bool bIsCrossable = Grid.IsCrossable(X, Y);
+    if (bIsCrossable == (CellLabels[Index] != INDEX_NONE))
+    {
+        return;
+    }
+
+    if (!bIsCrossable)
+    {
+        const int32 OldLabel = CellLabels[Index];
+        CellLabels[Index] = INDEX_NONE;
+        SplitAround(Grid, X, Y, OldLabel);
+        return;
+    }
+
+    // An opened cell joins every component around it
+    int32 Label = INDEX_NONE;
+    ForEachCrossableNeighbor(Grid, GridSizeX, Index, [this, &Label](int32 NeighborIndex)
+    {
+        if (Label == INDEX_NONE)
+        {
+            Label = CellLabels[NeighborIndex];
+        }
+        else
+        {
+            JoinLabels(Label, CellLabels[NeighborIndex]);
+        }
+    });
+    CellLabels[Index] = Label != INDEX_NONE ? Label : AddLabel();
+}
+
+bool FConnectedComponents::IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY) const
+{
+    return GridSizeX == InGridSizeX && GridSizeY == InGridSizeY && CellLabels.Num() == InGridSizeX * InGridSizeY;
+}
+
+bool FConnectedComponents::AreConnected(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY) const
+{
+    if (StartX == GoalX && StartY == GoalY)
+    {
+        return true;
+    }
+
+    const int32 GoalRoot = GetComponent(GoalX, GoalY);
+    if (GoalRoot == INDEX_NONE)
+    {
+        return false;
+    }
+
+    int32 StartRoots[8];
+    const int32 NumStartRoots = GetStartRoots(StartX, StartY, StartRoots);
+    for (int32 RootIndex = 0; RootIndex < NumStartRoots; ++RootIndex)
+    {
+        if (StartRoots[RootIndex] == GoalRoot)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FConnectedComponents::FindNearestReachableCell(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY,
+    int32& OutX, int32& OutY) const
+{
+    int32 StartRoots[8];
+    const int32 NumStartRoots = GetStartRoots(StartX, StartY, StartRoots);
+
+    int32 BestDistance = MAX_int32;
+    auto VisitCell = [&](int32 X, int32 Y)
+    {
+        if (static_cast<uint32>(X) >= static_cast<uint32>(GridSizeX)
+            || static_cast<uint32>(Y) >= static_cast<uint32>(GridSizeY))
+        {
+            return;
+        }
+
+        // The start is always reached, even blocked
+        bool bIsReachable = X == StartX && Y == StartY;
+        const int32 Root = GetComponent(X, Y);
+        for (int32 RootIndex = 0; RootIndex < NumStartRoots && Root != INDEX_NONE; ++RootIndex)
+        {
+            bIsReachable |= StartRoots[RootIndex] == Root;
+        }
+
+        const int32 Distance = FOctileHeuristic::Estimate<int32>(FMath::Abs(X - GoalX), FMath::Abs(Y - GoalY));
+        if (bIsReachable && Distance < BestDistance)
+        {
+            BestDistance = Distance;
+            OutX = X;
+            OutY = Y;
+        }
+    };
+
+    VisitCell(GoalX, GoalY);
+
+    // Square rings around the goal, until no farther ring can hold a closer cell
+    const int32 MaxRadius = FMath::Max(FMath::Max(GoalX, GridSizeX - 1 - GoalX), FMath::Max(GoalY, GridSizeY - 1 - GoalY));
+    for (int32 Radius = 1; Radius <= MaxRadius && Radius * FCostTraits::STRAIGHT_COST < BestDistance; ++Radius)
+    {
+        for (int32 X = GoalX - Radius; X <= GoalX + Radius; ++X)
+        {
+            VisitCell(X, GoalY - Radius);
+            VisitCell(X, GoalY + Radius);
+        }
+        for (int32 Y = GoalY - Radius + 1; Y < GoalY + Radius; ++Y)
+        {
+            VisitCell(GoalX - Radius, Y);
+            VisitCell(GoalX + Radius, Y);
+        }
+    }
+    return BestDistance != MAX_int32;
+}
+
+SIZE_T FConnectedComponents::GetAllocatedSize() const
+{
+    SIZE_T Size = CellLabels.GetAllocatedSize() + LabelParents.GetAllocatedSize() + LabelRanks.GetAllocatedSize();
+    for (const FFloodFill& FloodFill : FloodFills)
+    {
+        Size += FloodFill.Cells.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FConnectedComponents::Empty()
+{
+    CellLabels.Empty();
+    LabelParents.Empty();
+    LabelRanks.Empty();
+    for (FFloodFill& FloodFill : FloodFills)
+    {
+        FloodFill = FFloodFill();
+    }
+    GridSizeX = 0;
+    GridSizeY = 0;
+}
+
+int32 FConnectedComponents::FindRoot(int32 Label) const
+{
+    while (LabelParents[Label] != Label)
+    {
+        Label = LabelParents[Label];
+    }
+    return Label;
+}
+
+int32 FConnectedComponents::AddLabel()
+{
+    LabelRanks.Add(0);
+    return LabelParents.Add(LabelParents.Num());
+}
+
+void FConnectedComponents::JoinLabels(int32 LabelA, int32 LabelB)
+{
+    int32 RootA = FindRoot(LabelA);
+    int32 RootB = FindRoot(LabelB);
+    if (RootA == RootB)
+    {
+        return;
+    }
+
+    if (LabelRanks[RootA] < LabelRanks[RootB])
+    {
+        Swap(RootA, RootB);
+    }
+    LabelParents[RootB] = RootA;
+    if (LabelRanks[RootA] == LabelRanks[RootB])
+    {
+        ++LabelRanks[RootA];
+    }
+}
+
+int32 FConnectedComponents::GetStartRoots(int32 StartX, int32 StartY, int32 (&OutRoots)[8]) const
+{
+    const int32 StartRoot = GetComponent(StartX, StartY);
+    if (StartRoot != INDEX_NONE)
+    {
+        OutRoots[0] = StartRoot;
+        return 1;
+    }
+
+    int32 NumRoots = 0;
+    for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+    {
+        const int32 NeighborX = StartX + FNeighborhood::OFFSET_X[Direction];
+        const int32 NeighborY = StartY + FNeighborhood::OFFSET_Y[Direction];
+        if (static_cast<uint32>(NeighborX) < static_cast<uint32>(GridSizeX)
+            && static_cast<uint32>(NeighborY) < static_cast<uint32>(GridSizeY)
+            && CellLabels[NeighborY * GridSizeX + NeighborX] != INDEX_NONE)
+        {
+            OutRoots[NumRoots++] = GetComponent(NeighborX, NeighborY);
+        }
+    }
+    return NumRoots;
+}
+
+void FConnectedComponents::SplitAround(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 OldLabel)
+{
+    // Neighbors next to each other around the cell stay connected, so do two straight neighbors around a corner
+    const uint32 NeighborMask = Grid.GetNeighborMask(X, Y);
+    int32 RingGroups[8];
+    auto FindGroup = [&RingGroups](int32 Position)
+    {
+        while (RingGroups[Position] != Position)
+        {
+            Position = RingGroups[Position];
+        }
+        return Position;
+    };
+    auto IsRingCrossable = [NeighborMask](int32 Position)
+    {
+        return (NeighborMask >> RING_DIRECTIONS[Position & 7]) & 1;
+    };
+
+    for (int32 Position = 0; Position < 8; ++Position)
+    {
+        RingGroups[Position] = Position;
+    }
+    for (int32 Position = 0; Position < 8; ++Position)
+    {
+        const int32 LastOther = Position & 1 ? Position + 2 : Position + 1;
+        for (int32 Other = Position + 1; Other <= LastOther; ++Other)
+        {
+            if (IsRingCrossable(Position) && IsRingCrossable(Other) && FindGroup(Position) != FindGroup(Other & 7))
+            {
+                RingGroups[FindGroup(Other & 7)] = FindGroup(Position);
+            }
+        }
+    }
+
+    // One flood fill per group of neighbors, a cell is visited once it holds one of their new labels
+    int32 NumFloodFills = 0;
+    const int32 FirstFloodLabel = LabelParents.Num();
+    for (int32 Position = 0; Position < 8; ++Position)
+    {
+        if (IsRingCrossable(Position) && FindGroup(Position) == Position)
+        {
+            const int32 Direction = RING_DIRECTIONS[Position];
+            const int32 Index = (Y + FNeighborhood::OFFSET_Y[Direction]) * GridSizeX + X + FNeighborhood::OFFSET_X[Direction];
+            FFloodFill& FloodFill = FloodFills[NumFloodFills++];
+            FloodFill.Label = AddLabel();
+            FloodFill.Cells.Reset();
+            FloodFill.Cells.Add(Index);
+            FloodFill.Head = 0;
+            FloodFill.bIsClosed = false;
+            CellLabels[Index] = FloodFill.Label;
+        }
+    }
+
+    if (NumFloodFills <= 1)
+    {
+        // No split, the new label goes back into the component
+        if (NumFloodFills == 1)
+        {
+            JoinLabels(FloodFills[0].Label, OldLabel);
+            FloodFills[0].Cells.Reset();
+        }
+        return;
+    }
+
+    // Floods advance one cell each in turn, floods that meet are joined and the first to run out is cut off
+    int32 NumOpenComponents = NumFloodFills;
+    while (NumOpenComponents > 1)
+    {
+        for (int32 FloodIndex = 0; FloodIndex < NumFloodFills && NumOpenComponents > 1; ++FloodIndex)
+        {
+            FFloodFill& FloodFill = FloodFills[FloodIndex];
+            if (FloodFill.bIsClosed)
+            {
+                continue;
+            }
+
+            if (FloodFill.Head == FloodFill.Cells.Num())
+            {
+                // A component is closed once all the floods joined in it ran out of cells
+                const int32 Root = FindRoot(FloodFill.Label);
+                bool bIsComponentClosed = true;
+                for (int32 OtherIndex = 0; OtherIndex < NumFloodFills; ++OtherIndex)
+                {
+                    const FFloodFill& Other = FloodFills[OtherIndex];
+                    bIsComponentClosed &= FindRoot(Other.Label) != Root || Other.Head == Other.Cells.Num();
+                }
+
+                if (bIsComponentClosed)
+                {
+                    for (int32 OtherIndex = 0; OtherIndex < NumFloodFills; ++OtherIndex)
+                    {
+                        FloodFills[OtherIndex].bIsClosed |= FindRoot(FloodFills[OtherIndex].Label) == Root;
+                    }
+                    --NumOpenComponents;
+                }
+                continue;
+            }
+
+            const int32 Label = FloodFill.Label;
+            ForEachCrossableNeighbor(Grid, GridSizeX, FloodFill.Cells[FloodFill.Head++],
+                [this, &FloodFill, &NumOpenComponents, Label, FirstFloodLabel](int32 NeighborIndex)
+            {
+                const int32 NeighborLabel = CellLabels[NeighborIndex];
+                if (NeighborLabel < FirstFloodLabel)
+                {
+                    CellLabels[NeighborIndex] = Label;
+                    FloodFill.Cells.Add(NeighborIndex);
+                }
+                else if (FindRoot(NeighborLabel) != FindRoot(Label))
+                {
+                    JoinLabels(NeighborLabel, Label);
+                    --NumOpenComponents;
+                }
+            });
+        }
+    }
+
+    // The cells no flood reached belong to the one component left open, it takes the old label back
+    for (int32 FloodIndex = 0; FloodIndex < NumFloodFills; ++FloodIndex)
+    {
+        if (!FloodFills[FloodIndex].bIsClosed)
+        {
+            JoinLabels(FloodFills[FloodIndex].Label, OldLabel);
+        }
+        FloodFills[FloodIndex].Cells.Reset();
+    }
+}
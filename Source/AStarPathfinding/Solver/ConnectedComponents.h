@@ -0,0 +1,84 @@
+// ConnectedComponents.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+
+/**
+ * Connected components of the crossable cells, to reject the queries that cannot reach their goal without searching.
+ * Cells are 8-connected like the moves of PathFinder, where a move only needs the entered cell to be crossable.
+ * - Each crossable cell holds a label, labels of the same component are joined in a union-find.
+ * - Opening a cell joins the labels around it, no cell is relabelled.
+ * - Blocking a cell may split its component. When its crossable neighbors are not connected around it, one flood
+ *   fill per group of neighbors runs in lockstep and relabels what it visits. Floods that meet are joined, a flood
+ *   that runs out of cells is a new component. The search stops once a single flood is left open, so its cost
+ *   follows the parts cut off, not the size of the grid.
+ */
+struct ASTARPATHFINDING_API FConnectedComponents
+{
+    //////// METHODS ////////
+    /// Labels every cell of the grid with a flood fill
+    void Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY);
+
+    /// Updates the labels after a walkability change of the cell X, Y, Grid must already hold the new value
+    void UpdateCell(const FWalkabilityGrid& Grid, int32 X, int32 Y);
+
+    bool IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY) const;
+
+    /// Component of a crossable cell, INDEX_NONE for a blocked cell
+    FORCEINLINE int32 GetComponent(int32 X, int32 Y) const
+    {
+        const int32 Label = CellLabels[Y * GridSizeX + X];
+        return Label == INDEX_NONE ? INDEX_NONE : FindRoot(Label);
+    }
+
+    /// Whether PathFinder can find a path, a blocked start can still leave through its crossable neighbors
+    bool AreConnected(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY) const;
+
+    /// Cell reachable from the start closest to the goal in octile distance, the goal itself when it is reachable
+    bool FindNearestReachableCell(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY, int32& OutX, int32& OutY) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+    /// Releases the labels, the grid must be labelled again before the next query
+    void Empty();
+
+private:
+    //////// CONSTANTS ////////
+    /// crossable neighbors of a cell fall in at most 4 groups, when only its corners are crossable
+    static constexpr int32 MAX_FLOOD_FILLS = 4;
+
+    //////// STRUCTS ////////
+    struct FFloodFill
+    {
+        /// visited cells, the ones from Head on are still to expand
+        TArray<int32> Cells;
+        int32 Head = 0;
+        int32 Label = INDEX_NONE;
+        bool bIsClosed = false;
+    };
+
+    //////// FIELDS ////////
+    /// one label per cell, INDEX_NONE for blocked cells
+    TArray<int32> CellLabels;
+
+    /// union-find over the labels, union by rank keeps FindRoot logarithmic without path compression
+    TArray<int32> LabelParents;
+    TArray<uint8> LabelRanks;
+
+    int32 GridSizeX = 0;
+    int32 GridSizeY = 0;
+
+    FFloodFill FloodFills[MAX_FLOOD_FILLS];
+
+    //////// METHODS ////////
+    int32 FindRoot(int32 Label) const;
+    int32 AddLabel();
+    void JoinLabels(int32 LabelA, int32 LabelB);
+
+    /// Roots of the components the start can move into, at most one per crossable neighbor when it is blocked
+    int32 GetStartRoots(int32 StartX, int32 StartY, int32 (&OutRoots)[8]) const;
+
+    /// Relabels the component the blocked cell X, Y had the label OldLabel in if it split, see the class comment
+    void SplitAround(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 OldLabel);
+};
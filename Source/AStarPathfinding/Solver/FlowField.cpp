@@ -0,0 +1,308 @@
+#include "FlowField.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    using FNeighborhood = FEightWayNeighborhood;
+    using FCostTraits = TPathCostTraits<int32>;
+
+    constexpr uint32 MOVE_COSTS[FNeighborhood::NUM_DIRECTIONS] = {
+        FCostTraits::DIAGONAL_COST, FCostTraits::STRAIGHT_COST, FCostTraits::DIAGONAL_COST,
+        FCostTraits::STRAIGHT_COST, FCostTraits::STRAIGHT_COST,
+        FCostTraits::DIAGONAL_COST, FCostTraits::STRAIGHT_COST, FCostTraits::DIAGONAL_COST
+    };
+}
+
+void FFlowField::Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY, int32 InGoalX,
+    int32 InGoalY)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FFlowField::Build);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    GridSizeX = InGridSizeX;
+    GridSizeY = InGridSizeY;
+    GoalIndex = InGoalY * GridSizeX + InGoalX;
+    PaddedStride = GridSizeX + 2;
+    for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+    {
+        NeighborOffsets[Direction] = FNeighborhood::OFFSET_Y[Direction] * PaddedStride
+            + FNeighborhood::OFFSET_X[Direction];
+    }
+
+    const int32 PaddedCount = PaddedStride * (GridSizeY + 2);
+    IntegrationCosts.Init(UNREACHED, PaddedCount);
+    WalkableCells.Init(0, PaddedCount);
+    Flows.SetNumUninitialized(GridSizeX * GridSizeY);
+
+    for (int32 Y = 0; Y < GridSizeY; ++Y)
+    {
+        for (int32 X = 0; X < GridSizeX; ++X)
+        {
+            WalkableCells[GetPaddedIndex(X, Y)] = Grid.IsCrossable(X, Y);
+        }
+    }
+
+    // A blocked goal is never entered, so nothing reaches it
+    const int32 PaddedGoalIndex = GetPaddedIndex(InGoalX, InGoalY);
+    if (WalkableCells[PaddedGoalIndex])
+    {
+        SeedCost(PaddedGoalIndex, 0);
+    }
+    RunWavefront(false);
+
+    for (int32 Y = 0; Y < GridSizeY; ++Y)
+    {
+        ComputeFlowRow(Y);
+    }
+}
+
+void FFlowField::UpdateCell(const FWalkabilityGrid& Grid, int32 X, int32 Y)
+{
+    const int32 PaddedIndex = GetPaddedIndex(X, Y);
+    const uint8 bIsWalkable = Grid.IsCrossable(X, Y);
+    if (WalkableCells[PaddedIndex] == bIsWalkable)
+    {
+        return;
+    }
+    WalkableCells[PaddedIndex] = bIsWalkable;
+    ChangedCells.Reset();
+
+    if (bIsWalkable)
+    {
+        // Costs can only drop, the wavefront spreads from the opened cell
+        if (PaddedIndex == GetPaddedIndex(GoalIndex % GridSizeX, GoalIndex / GridSizeX))
+        {
+            SeedCost(PaddedIndex, 0);
+        }
+        for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+        {
+            const uint32 NeighborCost = IntegrationCosts[PaddedIndex + NeighborOffsets[Direction]];
+            if (NeighborCost != UNREACHED)
+            {
+                SeedCost(PaddedIndex, NeighborCost + MOVE_COSTS[Direction]);
+            }
+        }
+    }
+    else if (IntegrationCosts[PaddedIndex] != UNREACHED)
+    {
+        // Costs that may go through the blocked cell are dropped: a cell whose cost is exactly a neighbor's dropped
+        // cost plus the move may have used it. Every other cell keeps a cheapest path around the blocked cell.
+        InvalidatedCells.Reset();
+        InvalidatedCells.Emplace(PaddedIndex, IntegrationCosts[PaddedIndex]);
+        IntegrationCosts[PaddedIndex] = UNREACHED;
+        ChangedCells.Add(PaddedIndex);
+
+        for (int32 i = 0; i < InvalidatedCells.Num(); ++i)
+        {
+            const int32 Cell = InvalidatedCells[i].Key;
+            const uint32 Cost = InvalidatedCells[i].Value;
+            for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+            {
+                const int32 Neighbor = Cell + NeighborOffsets[Direction];
+                const uint32 NeighborCost = IntegrationCosts[Neighbor];
+                if (NeighborCost != UNREACHED && NeighborCost == Cost + MOVE_COSTS[Direction])
+                {
+                    InvalidatedCells.Emplace(Neighbor, NeighborCost);
+                    IntegrationCosts[Neighbor] = UNREACHED;
+                    ChangedCells.Add(Neighbor);
+                }
+            }
+        }
+
+        // The dropped cells are reached again from the kept costs around them
+        for (int32 i = 1; i < InvalidatedCells.Num(); ++i)
+        {
+            const int32 Cell = InvalidatedCells[i].Key;
+            for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+            {
+                const uint32 NeighborCost = IntegrationCosts[Cell + NeighborOffsets[Direction]];
+                if (NeighborCost != UNREACHED)
+                {
+                    SeedCost(Cell, NeighborCost + MOVE_COSTS[Direction]);
+                }
+            }
+        }
+    }
+
+    RunWavefront(true);
+
+    // A flow only reads the costs of its neighbors
+    for (const int32 Cell : ChangedCells)
+    {
+        const int32 CellX = Cell % PaddedStride - 1;
+        const int32 CellY = Cell / PaddedStride - 1;
+        for (int32 NeighborY = FMath::Max(CellY - 1, 0); NeighborY <= FMath::Min(CellY + 1, GridSizeY - 1); ++NeighborY)
+        {
+            for (int32 NeighborX = FMath::Max(CellX - 1, 0); NeighborX <= FMath::Min(CellX + 1, GridSizeX - 1); ++NeighborX)
+            {
+                ComputeFlow(NeighborX, NeighborY);
+            }
+        }
+    }
+}
+
+bool FFlowField::IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY, int32 InGoalX, int32 InGoalY) const
+{
+    return IsBuilt() && GridSizeX == InGridSizeX && GridSizeY == InGridSizeY
+        && GoalIndex == InGoalY * GridSizeX + InGoalX;
+}
+
+bool FFlowField::TracePath(int32 StartX, int32 StartY, TArray<int32>& OutCells) const
+{
+    OutCells.Reset();
+
+    int32 Index = StartY * GridSizeX + StartX;
+    if (GetCost(Index) >= UNREACHED)
+    {
+        return false;
+    }
+
+    // Each move lowers the cost, so the walk ends on the goal
+    OutCells.Add(Index);
+    while (Index != GoalIndex)
+    {
+        const int32 Direction = GetDirection(Index);
+        Index += FNeighborhood::OFFSET_Y[Direction] * GridSizeX + FNeighborhood::OFFSET_X[Direction];
+        OutCells.Add(Index);
+    }
+    return true;
+}
+
+SIZE_T FFlowField::GetAllocatedSize() const
+{
+    SIZE_T Size = IntegrationCosts.GetAllocatedSize()
+        + WalkableCells.GetAllocatedSize()
+        + Flows.GetAllocatedSize()
+        + Seeds.GetAllocatedSize()
+        + ChangedCells.GetAllocatedSize()
+        + InvalidatedCells.GetAllocatedSize();
+    for (const TArray<int32>& Bucket : Buckets)
+    {
+        Size += Bucket.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FFlowField::Empty()
+{
+    IntegrationCosts.Empty();
+    WalkableCells.Empty();
+    Flows.Empty();
+    for (TArray<int32>& Bucket : Buckets)
+    {
+        Bucket.Empty();
+    }
+    Seeds.Empty();
+    ChangedCells.Empty();
+    InvalidatedCells.Empty();
+    GridSizeX = 0;
+    GridSizeY = 0;
+    GoalIndex = INDEX_NONE;
+}
+
+void FFlowField::SeedCost(int32 PaddedIndex, uint32 Cost)
+{
+    if (Cost < IntegrationCosts[PaddedIndex])
+    {
+        IntegrationCosts[PaddedIndex] = Cost;
+        Seeds.Emplace(PaddedIndex, Cost);
+    }
+}
+
+void FFlowField::RunWavefront(bool bTrackChanges)
+{
+    static_assert(NUM_BUCKETS > FCostTraits::DIAGONAL_COST, "Live costs must fit in the bucket ring");
+
+    // Seeds may hold any cost, they join the ring when the wavefront reaches their cost
+    Seeds.Sort([](const TPair<int32, uint32>& A, const TPair<int32, uint32>& B)
+    {
+        return A.Value < B.Value;
+    });
+
+    int32 SeedCursor = 0;
+    int32 QueuedCount = 0;
+    uint32 Cost = 0;
+    while (QueuedCount > 0 || SeedCursor < Seeds.Num())
+    {
+        if (QueuedCount == 0)
+        {
+            Cost = Seeds[SeedCursor].Value;
+        }
+
+        TArray<int32>& Bucket = Buckets[Cost & (NUM_BUCKETS - 1)];
+        for (; SeedCursor < Seeds.Num() && Seeds[SeedCursor].Value == Cost; ++SeedCursor)
+        {
+            Bucket.Add(Seeds[SeedCursor].Key);
+            ++QueuedCount;
+        }
+
+        // Neighbors land in later buckets, this one only shrinks
+        while (Bucket.Num() > 0)
+        {
+            const int32 Cell = Bucket.Pop(EAllowShrinking::No);
+            --QueuedCount;
+            if (IntegrationCosts[Cell] != Cost)
+            {
+                continue; // Lowered after it was queued
+            }
+
+            if (bTrackChanges)
+            {
+                ChangedCells.Add(Cell);
+            }
+
+            for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+            {
+                const int32 Neighbor = Cell + NeighborOffsets[Direction];
+                const uint32 NeighborCost = Cost + MOVE_COSTS[Direction];
+                if (WalkableCells[Neighbor] && NeighborCost < IntegrationCosts[Neighbor])
+                {
+                    IntegrationCosts[Neighbor] = NeighborCost;
+                    Buckets[NeighborCost & (NUM_BUCKETS - 1)].Add(Neighbor);
+                    ++QueuedCount;
+                }
+            }
+        }
+        ++Cost;
+    }
+
+    Seeds.Reset();
+}
+
+void FFlowField::ComputeFlowRow(int32 Y)
+{
+    const uint32* RESTRICT Costs = IntegrationCosts.GetData() + GetPaddedIndex(0, Y);
+    uint32* RESTRICT RowFlows = Flows.GetData() + Y * GridSizeX;
+    const int32 Count = GridSizeX;
+
+    // One pass per direction keeps every loop a plain element-wise min over a shifted row
+    const int32 FirstOffset = NeighborOffsets[0];
+    for (int32 X = 0; X < Count; ++X)
+    {
+        RowFlows[X] = (Costs[X + FirstOffset] + MOVE_COSTS[0]) << DIRECTION_BITS;
+    }
+
+    for (int32 Direction = 1; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+    {
+        const int32 Offset = NeighborOffsets[Direction];
+        const uint32 MoveCost = MOVE_COSTS[Direction];
+        const uint32 DirectionBits = static_cast<uint32>(Direction);
+        for (int32 X = 0; X < Count; ++X)
+        {
+            RowFlows[X] = FMath::Min(RowFlows[X], ((Costs[X + Offset] + MoveCost) << DIRECTION_BITS) | DirectionBits);
+        }
+    }
+}
+
+void FFlowField::ComputeFlow(int32 X, int32 Y)
+{
+    const int32 PaddedIndex = GetPaddedIndex(X, Y);
+    uint32 Flow = MAX_uint32;
+    for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+    {
+        const uint32 NeighborCost = IntegrationCosts[PaddedIndex + NeighborOffsets[Direction]];
+        Flow = FMath::Min(Flow, ((NeighborCost + MOVE_COSTS[Direction]) << DIRECTION_BITS) | static_cast<uint32>(Direction));
+    }
+    Flows[Y * GridSizeX + X] = Flow;
+}
@@ -0,0 +1,99 @@
+// FlowField.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+
+/**
+ * Flow field toward a single goal, for many agents sharing it.
+ * - The integration field holds the cost from every crossable cell to the goal, computed by a Dijkstra wavefront.
+ * - The flow field holds, for every cell, the move toward the neighbor with the lowest cost to the goal.
+ * Agents read their next move in O(1). Moves and costs are the ones of PathFinder, so a followed flow has the
+ * cost of the A* path. Walkability changes repair the costs around the changed cell instead of rebuilding.
+ * Integration costs are stored in a grid padded with a blocked border, so neighbor reads never check bounds.
+ * Move costs are small integers, so the wavefront is a ring of one bucket per cost (Dial's algorithm).
+ */
+struct ASTARPATHFINDING_API FFlowField
+{
+    //////// CONSTANTS ////////
+    /// cost of blocked and unreachable cells, low enough to add a move cost and the direction bits without overflow
+    static constexpr uint32 UNREACHED = MAX_uint32 >> 4;
+    static constexpr int32 DIRECTION_BITS = 3;
+    static constexpr uint32 DIRECTION_MASK = (1u << DIRECTION_BITS) - 1;
+
+    //////// METHODS ////////
+    /// Computes the integration and flow fields of the whole grid
+    void Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY, int32 InGoalX, int32 InGoalY);
+
+    /// Repairs both fields after a walkability change of the cell X, Y, Grid must already hold the new value
+    void UpdateCell(const FWalkabilityGrid& Grid, int32 X, int32 Y);
+
+    bool IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY, int32 InGoalX, int32 InGoalY) const;
+
+    bool IsBuilt() const
+    {
+        return Flows.Num() > 0;
+    }
+
+    /// Direction of FEightWayNeighborhood to take from the cell, INDEX_NONE on the goal or when it cannot be reached
+    FORCEINLINE int32 GetDirection(int32 Index) const
+    {
+        return Index != GoalIndex && (Flows[Index] >> DIRECTION_BITS) < UNREACHED
+            ? static_cast<int32>(Flows[Index] & DIRECTION_MASK)
+            : INDEX_NONE;
+    }
+
+    /// Cost of the path from the cell to the goal, UNREACHED when there is none
+    FORCEINLINE uint32 GetCost(int32 Index) const
+    {
+        return Index == GoalIndex ? 0 : FMath::Min(Flows[Index] >> DIRECTION_BITS, UNREACHED);
+    }
+
+    /// Follows the flow from the start, OutCells holds every cell from start to goal
+    bool TracePath(int32 StartX, int32 StartY, TArray<int32>& OutCells) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+    /// Releases both fields, the next query builds them again
+    void Empty();
+
+private:
+    //////// FIELDS ////////
+    /// padded grids, (Y + 1) * PaddedStride + X + 1
+    TArray<uint32> IntegrationCosts;
+    TArray<uint8> WalkableCells;
+    int32 PaddedStride = 0;
+    int32 NeighborOffsets[8] = {};
+
+    /// one (Cost << DIRECTION_BITS) | Direction per cell, indexed by Y * GridSizeX + X
+    TArray<uint32> Flows;
+
+    int32 GridSizeX = 0;
+    int32 GridSizeY = 0;
+    int32 GoalIndex = INDEX_NONE;
+
+    /// wavefront state, kept between repairs. A cell may sit in several buckets, only the one of its cost is live.
+    static constexpr int32 NUM_BUCKETS = 16;
+    TArray<int32> Buckets[NUM_BUCKETS];
+    TArray<TPair<int32, uint32>> Seeds;
+    TArray<int32> ChangedCells;
+    TArray<TPair<int32, uint32>> InvalidatedCells;
+
+    //////// METHODS ////////
+    FORCEINLINE int32 GetPaddedIndex(int32 X, int32 Y) const
+    {
+        return (Y + 1) * PaddedStride + X + 1;
+    }
+
+    /// Lowers the cost of a padded cell and records it as a start of the next wavefront
+    void SeedCost(int32 PaddedIndex, uint32 Cost);
+
+    /// Spreads the seeds in cost order until every cost is final, bTrackChanges records the cells in ChangedCells
+    void RunWavefront(bool bTrackChanges);
+
+    /// Flows of a whole row, the loop is branch free so the compiler vectorizes it
+    void ComputeFlowRow(int32 Y);
+
+    /// Flow of a single cell, used by repairs
+    void ComputeFlow(int32 X, int32 Y);
+};
@@ -0,0 +1,699 @@
+#include "HierarchicalGraph.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    using FCostTraits = TPathCostTraits<int32>;
+    using FNeighborhood = FEightWayNeighborhood;
+
+    // Runs at least this long get an entrance at each end instead of one in the middle
+    constexpr int32 SPLIT_RUN_LENGTH = 6;
+
+    FORCEINLINE int32 EstimateCost(int32 FromCell, int32 ToCell, int32 GridSizeX)
+    {
+        return FOctileHeuristic::Estimate<int32>(FMath::Abs(FromCell % GridSizeX - ToCell % GridSizeX),
+            FMath::Abs(FromCell / GridSizeX - ToCell / GridSizeX));
+    }
+}
+
+void FHierarchicalGraph::Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY,
+    int32 InClusterSize)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FHierarchicalGraph::Build);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    GridSizeX = InGridSizeX;
+    GridSizeY = InGridSizeY;
+    ClusterSize = FMath::Max(InClusterSize, 2);
+    NumClustersX = FMath::DivideAndRoundUp(GridSizeX, ClusterSize);
+    NumClustersY = FMath::DivideAndRoundUp(GridSizeY, ClusterSize);
+
+    const int32 NumClusters = NumClustersX * NumClustersY;
+    Clusters.Reset();
+    Clusters.SetNum(NumClusters);
+    DirtyFlags.Init(1, NumClusters);
+    DirtyClusters.Reset(NumClusters);
+    for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+    {
+        DirtyClusters.Add(Cluster);
+    }
+
+    // One wall cell around the cluster replaces the bound checks of in-cluster searches
+    LocalStride = ClusterSize + 2;
+    const int32 LocalCount = LocalStride * LocalStride;
+    LocalWalkable.SetNumUninitialized(LocalCount);
+    LocalCosts.SetNumUninitialized(LocalCount);
+    LocalDirections.SetNumUninitialized(LocalCount);
+    LocalClosed.SetNumUninitialized(LocalCount);
+    StartLocalCosts.SetNumUninitialized(LocalCount);
+    GoalLocalCosts.SetNumUninitialized(LocalCount);
+    ClusterOpenList.Initialize(LocalCount);
+
+    RebuildDirtyClusters(Grid);
+}
+
+bool FHierarchicalGraph::IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY, int32 InClusterSize) const
+{
+    return Clusters.Num() > 0 && GridSizeX == InGridSizeX && GridSizeY == InGridSizeY
+        && ClusterSize == FMath::Max(InClusterSize, 2);
+}
+
+void FHierarchicalGraph::MarkCellDirty(int32 X, int32 Y)
+{
+    // Entrances of a border depend on the cells on both sides of it, so every cluster touching the 3x3 block is flagged
+    for (int32 CellY = FMath::Max(Y - 1, 0); CellY <= FMath::Min(Y + 1, GridSizeY - 1); ++CellY)
+    {
+        for (int32 CellX = FMath::Max(X - 1, 0); CellX <= FMath::Min(X + 1, GridSizeX - 1); ++CellX)
+        {
+            const int32 Cluster = GetClusterIndex(CellY * GridSizeX + CellX);
+            if (!DirtyFlags[Cluster])
+            {
+                DirtyFlags[Cluster] = 1;
+                DirtyClusters.Add(Cluster);
+            }
+        }
+    }
+}
+
+void FHierarchicalGraph::RebuildDirtyClusters(const FWalkabilityGrid& Grid)
+{
+    if (DirtyClusters.Num() == 0)
+    {
+        return;
+    }
+
+    for (const int32 Cluster : DirtyClusters)
+    {
+        RebuildCluster(Grid, Cluster);
+        DirtyFlags[Cluster] = 0;
+    }
+    DirtyClusters.Reset();
+    RefreshNodeIds();
+}
+
+bool FHierarchicalGraph::FindAbstractPath(const FWalkabilityGrid& Grid, int32 StartX, int32 StartY, int32 GoalX,
+    int32 GoalY, FHierarchicalPath& OutPath, TArray<int32>* OutExploredCells)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FHierarchicalGraph::FindAbstractPath);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    OutPath.Waypoints.Reset();
+    OutPath.Cost = 0;
+    if (OutExploredCells)
+    {
+        OutExploredCells->Reset();
+    }
+
+    if (static_cast<uint32>(StartX) >= static_cast<uint32>(GridSizeX) || static_cast<uint32>(StartY) >= static_cast<uint32>(GridSizeY)
+        || static_cast<uint32>(GoalX) >= static_cast<uint32>(GridSizeX) || static_cast<uint32>(GoalY) >= static_cast<uint32>(GridSizeY))
+    {
+        return false; // Invalid Start or Goal > Impossible path
+    }
+
+    // Clusters touched by grid edits are only rebuilt when a query needs the graph
+    RebuildDirtyClusters(Grid);
+
+    const int32 StartCell = StartY * GridSizeX + StartX;
+    const int32 GoalCell = GoalY * GridSizeX + GoalX;
+    const int32 StartCluster = GetClusterIndex(StartCell);
+    const int32 GoalCluster = GetClusterIndex(GoalCell);
+
+    // Start and goal are linked to their cluster by searches that never check their own cell
+    if (!Grid.IsCrossable(StartX, StartY) || !Grid.IsCrossable(GoalX, GoalY))
+    {
+        return false;
+    }
+
+    // Start and goal are linked to the entrances of their own cluster for this query only
+    SearchCluster(Grid, StartCluster, StartCell, INDEX_NONE);
+    Swap(StartLocalCosts, LocalCosts);
+    SearchCluster(Grid, GoalCluster, GoalCell, INDEX_NONE);
+    Swap(GoalLocalCosts, LocalCosts);
+
+    // Start and goal reuse their entrance id, otherwise they take the two ids after the entrances
+    const int32 NumEntranceNodes = NodeCells.Num();
+    int32 StartNode = FindNodeId(StartCell);
+    if (StartNode == INDEX_NONE)
+    {
+        StartNode = NumEntranceNodes;
+    }
+    int32 GoalNode = StartCell == GoalCell ? StartNode : FindNodeId(GoalCell);
+    if (GoalNode == INDEX_NONE)
+    {
+        GoalNode = NumEntranceNodes + 1;
+    }
+
+    auto GetNodeCell = [this, NumEntranceNodes, StartCell, GoalCell](int32 Node)
+    {
+        if (Node < NumEntranceNodes)
+        {
+            return NodeCells[Node];
+        }
+        return Node == NumEntranceNodes ? StartCell : GoalCell;
+    };
+
+    // Generation stamps stand for a full reset of the abstract node state
+    if (++AbstractGeneration == 0)
+    {
+        FMemory::Memzero(AbstractGenerations.GetData(), AbstractGenerations.Num() * sizeof(uint32));
+        AbstractGeneration = 1;
+    }
+    AbstractOpenList.Reset();
+
+    const int32 StartEstimate = EstimateCost(StartCell, GoalCell, GridSizeX);
+    AbstractCosts[StartNode] = 0;
+    AbstractParents[StartNode] = INDEX_NONE;
+    AbstractGenerations[StartNode] = AbstractGeneration;
+    AbstractClosed[StartNode] = 0;
+    AbstractOpenList.Push(StartNode, StartEstimate, StartEstimate);
+
+    while (!AbstractOpenList.IsEmpty())
+    {
+        const int32 CurrentNode = AbstractOpenList.Pop();
+        AbstractClosed[CurrentNode] = 1;
+
+        const int32 CurrentCell = GetNodeCell(CurrentNode);
+        if (OutExploredCells)
+        {
+            OutExploredCells->Add(CurrentCell);
+        }
+
+        if (CurrentNode == GoalNode)
+        {
+            int32 PathLength = 0;
+            for (int32 Node = GoalNode; Node != INDEX_NONE; Node = AbstractParents[Node])
+            {
+                ++PathLength;
+            }
+
+            OutPath.Waypoints.AddUninitialized(PathLength);
+            int32 WaypointIndex = PathLength;
+            for (int32 Node = GoalNode; Node != INDEX_NONE; Node = AbstractParents[Node])
+            {
+                OutPath.Waypoints[--WaypointIndex] = GetNodeCell(Node);
+            }
+            OutPath.Cost = AbstractCosts[GoalNode];
+            return true;
+        }
+
+        const int32 CurrentCost = AbstractCosts[CurrentNode];
+        auto Relax = [this, &GetNodeCell, CurrentNode, CurrentCost, GoalCell](int32 TargetNode, int32 EdgeCost)
+        {
+            const int32 NewCost = CurrentCost + EdgeCost;
+            const bool bIsReached = AbstractGenerations[TargetNode] == AbstractGeneration;
+            if (bIsReached && (AbstractClosed[TargetNode] || AbstractCosts[TargetNode] <= NewCost))
+            {
+                return;
+            }
+
+            const int32 EstimatedCostToGoal = EstimateCost(GetNodeCell(TargetNode), GoalCell, GridSizeX);
+            if (bIsReached)
+            {
+                AbstractOpenList.DecreaseKey(TargetNode, AbstractCosts[TargetNode] + EstimatedCostToGoal,
+                    NewCost + EstimatedCostToGoal, EstimatedCostToGoal);
+            }
+            else
+            {
+                AbstractGenerations[TargetNode] = AbstractGeneration;
+                AbstractClosed[TargetNode] = 0;
+                AbstractOpenList.Push(TargetNode, NewCost + EstimatedCostToGoal, EstimatedCostToGoal);
+            }
+            AbstractCosts[TargetNode] = NewCost;
+            AbstractParents[TargetNode] = CurrentNode;
+        };
+
+        const int32 Cluster = GetClusterIndex(CurrentCell);
+        const FCluster& CurrentCluster = Clusters[Cluster];
+
+        if (Cluster == GoalCluster)
+        {
+            const int32 CostToGoal = GoalLocalCosts[GetLocalIndex(Cluster, CurrentCell)];
+            if (CostToGoal != UNREACHABLE)
+            {
+                Relax(GoalNode, CostToGoal);
+            }
+        }
+
+        const int32 NumEntrances = CurrentCluster.Entrances.Num();
+        if (CurrentNode == StartNode)
+        {
+            for (int32 OtherIndex = 0; OtherIndex < NumEntrances; ++OtherIndex)
+            {
+                const int32 EntranceCell = CurrentCluster.Entrances[OtherIndex];
+                const int32 CostToEntrance = StartLocalCosts[GetLocalIndex(Cluster, EntranceCell)];
+                if (CostToEntrance != UNREACHABLE && EntranceCell != CurrentCell)
+                {
+                    Relax(NodeOffsets[Cluster] + OtherIndex, CostToEntrance);
+                }
+            }
+        }
+
+        if (CurrentNode >= NumEntranceNodes)
+        {
+            continue;
+        }
+
+        const int32 EntranceIndex = CurrentNode - NodeOffsets[Cluster];
+        for (int32 OtherIndex = 0; OtherIndex < NumEntrances; ++OtherIndex)
+        {
+            const int32 Distance = CurrentCluster.Distances[EntranceIndex * NumEntrances + OtherIndex];
+            if (OtherIndex != EntranceIndex && Distance != UNREACHABLE)
+            {
+                Relax(NodeOffsets[Cluster] + OtherIndex, Distance);
+            }
+        }
+
+        for (const FTransition& Transition : CurrentCluster.Transitions)
+        {
+            if (Transition.Entrance == EntranceIndex)
+            {
+                Relax(FindNodeId(Transition.TargetCell), Transition.Cost);
+            }
+        }
+    }
+
+    return false;
+}
+
+bool FHierarchicalGraph::RefineSegment(const FWalkabilityGrid& Grid, const FHierarchicalPath& Path,
+    int32 SegmentIndex, TArray<int32>& OutCells)
+{
+    if (SegmentIndex < 0 || SegmentIndex >= Path.GetNumSegments())
+    {
+        return false;
+    }
+
+    const int32 FromCell = Path.Waypoints[SegmentIndex];
+    const int32 ToCell = Path.Waypoints[SegmentIndex + 1];
+    const int32 Cluster = GetClusterIndex(FromCell);
+
+    // Transitions link adjacent cells of two clusters
+    if (GetClusterIndex(ToCell) != Cluster)
+    {
+        OutCells.Add(ToCell);
+        return true;
+    }
+
+    if (!SearchCluster(Grid, Cluster, FromCell, ToCell))
+    {
+        return false;
+    }
+
+    // Follow parent directions back to the first waypoint, then append in path order
+    const int32 FromLocal = GetLocalIndex(Cluster, FromCell);
+    SegmentCells.Reset();
+    for (int32 LocalIndex = GetLocalIndex(Cluster, ToCell); LocalIndex != FromLocal; )
+    {
+        SegmentCells.Add(GetCellFromLocalIndex(Cluster, LocalIndex));
+        const int32 Direction = LocalDirections[LocalIndex];
+        LocalIndex -= FNeighborhood::OFFSET_Y[Direction] * LocalStride + FNeighborhood::OFFSET_X[Direction];
+        check(LocalWalkable[LocalIndex]);
+    }
+
+    for (int32 Index = SegmentCells.Num() - 1; Index >= 0; --Index)
+    {
+        OutCells.Add(SegmentCells[Index]);
+    }
+    return true;
+}
+
+bool FHierarchicalGraph::RefinePath(const FWalkabilityGrid& Grid, const FHierarchicalPath& Path,
+    TArray<int32>& OutCells)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FHierarchicalGraph::RefinePath);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    OutCells.Reset();
+    if (Path.Waypoints.Num() == 0)
+    {
+        return false;
+    }
+
+    OutCells.Add(Path.Waypoints[0]);
+    for (int32 SegmentIndex = 0; SegmentIndex < Path.GetNumSegments(); ++SegmentIndex)
+    {
+        if (!RefineSegment(Grid, Path, SegmentIndex, OutCells))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+SIZE_T FHierarchicalGraph::GetAllocatedSize() const
+{
+    SIZE_T Size = Clusters.GetAllocatedSize()
+        + DirtyClusters.GetAllocatedSize()
+        + DirtyFlags.GetAllocatedSize()
+        + NodeOffsets.GetAllocatedSize()
+        + NodeCells.GetAllocatedSize()
+        + LocalWalkable.GetAllocatedSize()
+        + LocalCosts.GetAllocatedSize()
+        + LocalDirections.GetAllocatedSize()
+        + LocalClosed.GetAllocatedSize()
+        + StartLocalCosts.GetAllocatedSize()
+        + GoalLocalCosts.GetAllocatedSize()
+        + SegmentCells.GetAllocatedSize()
+        + ClusterOpenList.GetAllocatedSize()
+        + AbstractCosts.GetAllocatedSize()
+        + AbstractParents.GetAllocatedSize()
+        + AbstractGenerations.GetAllocatedSize()
+        + AbstractClosed.GetAllocatedSize()
+        + AbstractOpenList.GetAllocatedSize();
+
+    for (const FCluster& Cluster : Clusters)
+    {
+        Size += Cluster.Entrances.GetAllocatedSize()
+            + Cluster.Distances.GetAllocatedSize()
+            + Cluster.Transitions.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FHierarchicalGraph::Empty()
+{
+    Clusters.Empty();
+    DirtyClusters.Empty();
+    DirtyFlags.Empty();
+    NodeOffsets.Empty();
+    NodeCells.Empty();
+    LocalWalkable.Empty();
+    LocalCosts.Empty();
+    LocalDirections.Empty();
+    LocalClosed.Empty();
+    StartLocalCosts.Empty();
+    GoalLocalCosts.Empty();
+    SegmentCells.Empty();
+    ClusterOpenList = {};
+    AbstractCosts.Empty();
+    AbstractParents.Empty();
+    AbstractGenerations.Empty();
+    AbstractClosed.Empty();
+    AbstractGeneration = 0;
+    AbstractOpenList = {};
+    GridSizeX = 0;
+    GridSizeY = 0;
+    ClusterSize = 0;
+    NumClustersX = 0;
+    NumClustersY = 0;
+    LocalStride = 0;
+}
+
+int32 FHierarchicalGraph::GetClusterIndex(int32 Cell) const
+{
+    return (Cell / GridSizeX / ClusterSize) * NumClustersX + (Cell % GridSizeX) / ClusterSize;
+}
+
+FIntRect FHierarchicalGraph::GetClusterRect(int32 Cluster) const
+{
+    const int32 MinX = (Cluster % NumClustersX) * ClusterSize;
+    const int32 MinY = (Cluster / NumClustersX) * ClusterSize;
+    return FIntRect(MinX, MinY, FMath::Min(MinX + ClusterSize, GridSizeX), FMath::Min(MinY + ClusterSize, GridSizeY));
+}
+
+int32 FHierarchicalGraph::GetLocalIndex(int32 Cluster, int32 Cell) const
+{
+    const int32 LocalX = Cell % GridSizeX - (Cluster % NumClustersX) * ClusterSize;
+    const int32 LocalY = Cell / GridSizeX - (Cluster / NumClustersX) * ClusterSize;
+    return (LocalY + 1) * LocalStride + LocalX + 1;
+}
+
+int32 FHierarchicalGraph::GetCellFromLocalIndex(int32 Cluster, int32 LocalIndex) const
+{
+    const int32 X = (Cluster % NumClustersX) * ClusterSize + LocalIndex % LocalStride - 1;
+    const int32 Y = (Cluster / NumClustersX) * ClusterSize + LocalIndex / LocalStride - 1;
+    return Y * GridSizeX + X;
+}
+
+bool FHierarchicalGraph::IsCrossable(const FWalkabilityGrid& Grid, int32 X, int32 Y) const
+{
+    // Cells one step outside the grid read as blocked
+    return Grid.IsCrossable(X, Y);
+}
+
+void FHierarchicalGraph::RefreshNodeIds()
+{
+    const int32 NumClusters = Clusters.Num();
+    NodeOffsets.SetNumUninitialized(NumClusters);
+    NodeCells.Reset();
+    for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+    {
+        NodeOffsets[Cluster] = NodeCells.Num();
+        NodeCells.Append(Clusters[Cluster].Entrances);
+    }
+
+    // Two more ids for a start and a goal that are not entrances
+    const int32 NumNodes = NodeCells.Num() + 2;
+    if (AbstractCosts.Num() != NumNodes)
+    {
+        AbstractCosts.SetNumUninitialized(NumNodes);
+        AbstractParents.SetNumUninitialized(NumNodes);
+        AbstractClosed.SetNumUninitialized(NumNodes);
+        AbstractGenerations.Init(0, NumNodes);
+        AbstractGeneration = 0;
+        AbstractOpenList.Initialize(NumNodes);
+    }
+}
+
+int32 FHierarchicalGraph::FindNodeId(int32 Cell) const
+{
+    const int32 Cluster = GetClusterIndex(Cell);
+    const int32 EntranceIndex = Clusters[Cluster].Entrances.Find(Cell);
+    return EntranceIndex == INDEX_NONE ? INDEX_NONE : NodeOffsets[Cluster] + EntranceIndex;
+}
+
+void FHierarchicalGraph::RebuildCluster(const FWalkabilityGrid& Grid, int32 Cluster)
+{
+    FCluster& CurrentCluster = Clusters[Cluster];
+    CurrentCluster.Entrances.Reset();
+    CurrentCluster.Transitions.Reset();
+
+    // Each cluster only keeps its own side of the transitions, both sides are computed the same way
+    const FIntRect Rect = GetClusterRect(Cluster);
+    const int32 MaxX = Rect.Max.X - 1;
+    const int32 MaxY = Rect.Max.Y - 1;
+
+    auto AddOwnSide = [this, Cluster, &Rect](int32 CellA, int32 CellB, int32 Cost)
+    {
+        if (Rect.Contains(FIntPoint(CellA % GridSizeX, CellA / GridSizeX)))
+        {
+            AddTransition(Cluster, CellA, CellB, Cost);
+        }
+        else
+        {
+            AddTransition(Cluster, CellB, CellA, Cost);
+        }
+    };
+
+    if (Rect.Min.X > 0)
+    {
+        ForEachBorderTransition(Grid, true, Rect.Min.X - 1, Rect.Min.Y, Rect.Max.Y, AddOwnSide);
+    }
+    if (Rect.Max.X < GridSizeX)
+    {
+        ForEachBorderTransition(Grid, true, MaxX, Rect.Min.Y, Rect.Max.Y, AddOwnSide);
+    }
+    if (Rect.Min.Y > 0)
+    {
+        ForEachBorderTransition(Grid, false, Rect.Min.Y - 1, Rect.Min.X, Rect.Max.X, AddOwnSide);
+    }
+    if (Rect.Max.Y < GridSizeY)
+    {
+        ForEachBorderTransition(Grid, false, MaxY, Rect.Min.X, Rect.Max.X, AddOwnSide);
+    }
+
+    // Diagonal moves through a cluster corner, when neither straight cell around it is free
+    const FIntPoint Corners[] = { { Rect.Min.X, Rect.Min.Y }, { MaxX, Rect.Min.Y }, { Rect.Min.X, MaxY }, { MaxX, MaxY } };
+    const FIntPoint CornerOffsets[] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+    for (int32 CornerIndex = 0; CornerIndex < UE_ARRAY_COUNT(Corners); ++CornerIndex)
+    {
+        const FIntPoint& Corner = Corners[CornerIndex];
+        const FIntPoint& Offset = CornerOffsets[CornerIndex];
+        if (IsCrossable(Grid, Corner.X, Corner.Y) && IsCrossable(Grid, Corner.X + Offset.X, Corner.Y + Offset.Y)
+            && !IsCrossable(Grid, Corner.X + Offset.X, Corner.Y) && !IsCrossable(Grid, Corner.X, Corner.Y + Offset.Y))
+        {
+            AddTransition(Cluster, Corner.Y * GridSizeX + Corner.X,
+                (Corner.Y + Offset.Y) * GridSizeX + Corner.X + Offset.X, FCostTraits::DIAGONAL_COST);
+        }
+    }
+
+    // Cached in-cluster costs between every pair of entrances
+    const int32 NumEntrances = CurrentCluster.Entrances.Num();
+    CurrentCluster.Distances.SetNumUninitialized(NumEntrances * NumEntrances);
+    for (int32 EntranceIndex = 0; EntranceIndex < NumEntrances; ++EntranceIndex)
+    {
+        CurrentCluster.Distances[EntranceIndex * NumEntrances + EntranceIndex] = 0;
+        if (EntranceIndex == NumEntrances - 1)
+        {
+            break;
+        }
+
+        SearchCluster(Grid, Cluster, CurrentCluster.Entrances[EntranceIndex], INDEX_NONE);
+        for (int32 OtherIndex = EntranceIndex + 1; OtherIndex < NumEntrances; ++OtherIndex)
+        {
+            const int32 Distance = LocalCosts[GetLocalIndex(Cluster, CurrentCluster.Entrances[OtherIndex])];
+            CurrentCluster.Distances[EntranceIndex * NumEntrances + OtherIndex] = Distance;
+            CurrentCluster.Distances[OtherIndex * NumEntrances + EntranceIndex] = Distance;
+        }
+    }
+}
+
+void FHierarchicalGraph::AddTransition(int32 Cluster, int32 Cell, int32 TargetCell, int32 Cost)
+{
+    FCluster& CurrentCluster = Clusters[Cluster];
+    const int32 Entrance = CurrentCluster.Entrances.AddUnique(Cell);
+    CurrentCluster.Transitions.Add({ Entrance, TargetCell, Cost });
+}
+
+template <typename VisitorType>
+void FHierarchicalGraph::ForEachBorderTransition(const FWalkabilityGrid& Grid, bool bIsVertical, int32 Line,
+    int32 Begin, int32 End, VisitorType&& Visit) const
+{
+    // Side A lies on Line, side B on Line + 1. Position runs along the border.
+    auto GetCell = [this, bIsVertical](int32 Across, int32 Position)
+    {
+        return bIsVertical ? Position * GridSizeX + Across : Across * GridSizeX + Position;
+    };
+    auto IsFree = [this, &Grid, bIsVertical](int32 Across, int32 Position)
+    {
+        return bIsVertical ? IsCrossable(Grid, Across, Position) : IsCrossable(Grid, Position, Across);
+    };
+
+    // Straight transitions, one per short run, one at each end of long runs
+    int32 RunBegin = INDEX_NONE;
+    for (int32 Position = Begin; Position <= End; ++Position)
+    {
+        const bool bIsOpen = Position < End && IsFree(Line, Position) && IsFree(Line + 1, Position);
+        if (bIsOpen && RunBegin == INDEX_NONE)
+        {
+            RunBegin = Position;
+        }
+        else if (!bIsOpen && RunBegin != INDEX_NONE)
+        {
+            const int32 RunEnd = Position - 1;
+            if (RunEnd - RunBegin + 1 >= SPLIT_RUN_LENGTH)
+            {
+                Visit(GetCell(Line, RunBegin), GetCell(Line + 1, RunBegin), FCostTraits::STRAIGHT_COST);
+                Visit(GetCell(Line, RunEnd), GetCell(Line + 1, RunEnd), FCostTraits::STRAIGHT_COST);
+            }
+            else
+            {
+                const int32 Middle = (RunBegin + RunEnd) / 2;
+                Visit(GetCell(Line, Middle), GetCell(Line + 1, Middle), FCostTraits::STRAIGHT_COST);
+            }
+            RunBegin = INDEX_NONE;
+        }
+    }
+
+    // Diagonal transitions that no straight run covers, both straight cells around them are walls
+    for (int32 Position = Begin; Position + 1 < End; ++Position)
+    {
+        const bool bIsLowFreeA = IsFree(Line, Position);
+        const bool bIsLowFreeB = IsFree(Line + 1, Position);
+        const bool bIsHighFreeA = IsFree(Line, Position + 1);
+        const bool bIsHighFreeB = IsFree(Line + 1, Position + 1);
+
+        if (bIsLowFreeA && bIsHighFreeB && !bIsLowFreeB && !bIsHighFreeA)
+        {
+            Visit(GetCell(Line, Position), GetCell(Line + 1, Position + 1), FCostTraits::DIAGONAL_COST);
+        }
+        if (bIsHighFreeA && bIsLowFreeB && !bIsLowFreeA && !bIsHighFreeB)
+        {
+            Visit(GetCell(Line, Position + 1), GetCell(Line + 1, Position), FCostTraits::DIAGONAL_COST);
+        }
+    }
+}
+
+void FHierarchicalGraph::LoadClusterWalkability(const FWalkabilityGrid& Grid, int32 Cluster)
+{
+    const FIntRect Rect = GetClusterRect(Cluster);
+    FMemory::Memzero(LocalWalkable.GetData(), LocalWalkable.Num());
+    for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+    {
+        uint8* LocalRow = &LocalWalkable[(Y - Rect.Min.Y + 1) * LocalStride + 1];
+        uint64 GridRow = Grid.GetRowWord(Rect.Min.X, Y);
+        for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+        {
+            // A new row word starts with every tile
+            const int32 Bit = X & FWalkabilityGrid::TILE_MASK;
+            if (Bit == 0)
+            {
+                GridRow = Grid.GetRowWord(X, Y);
+            }
+            LocalRow[X - Rect.Min.X] = (GridRow >> Bit) & 1;
+        }
+    }
+}
+
+bool FHierarchicalGraph::SearchCluster(const FWalkabilityGrid& Grid, int32 Cluster, int32 SourceCell,
+    int32 TargetCell)
+{
+    LoadClusterWalkability(Grid, Cluster);
+    const int32 LocalCount = LocalStride * LocalStride;
+    for (int32 LocalIndex = 0; LocalIndex < LocalCount; ++LocalIndex)
+    {
+        LocalCosts[LocalIndex] = UNREACHABLE;
+        LocalClosed[LocalIndex] = 0;
+    }
+
+    // Estimates only need local coordinates, the offset of the cluster cancels out
+    const int32 TargetLocal = TargetCell == INDEX_NONE ? INDEX_NONE : GetLocalIndex(Cluster, TargetCell);
+    auto Estimate = [this, TargetLocal](int32 LocalIndex)
+    {
+        return TargetLocal == INDEX_NONE ? 0 : FOctileHeuristic::Estimate<int32>(
+            FMath::Abs(LocalIndex % LocalStride - TargetLocal % LocalStride),
+            FMath::Abs(LocalIndex / LocalStride - TargetLocal / LocalStride));
+    };
+
+    const int32 SourceLocal = GetLocalIndex(Cluster, SourceCell);
+    LocalCosts[SourceLocal] = 0;
+    ClusterOpenList.Reset();
+    ClusterOpenList.Push(SourceLocal, Estimate(SourceLocal), Estimate(SourceLocal));
+
+    while (!ClusterOpenList.IsEmpty())
+    {
+        const int32 CurrentLocal = ClusterOpenList.Pop();
+        if (CurrentLocal == TargetLocal)
+        {
+            return true;
+        }
+        LocalClosed[CurrentLocal] = 1;
+
+        const int32 CurrentCost = LocalCosts[CurrentLocal];
+        for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+        {
+            // Cells outside the cluster are walls of the padding
+            const int32 NeighborLocal = CurrentLocal + FNeighborhood::OFFSET_Y[Direction] * LocalStride
+                + FNeighborhood::OFFSET_X[Direction];
+            if (!LocalWalkable[NeighborLocal] || LocalClosed[NeighborLocal])
+            {
+                continue;
+            }
+
+            const bool IsDiagonal = FNeighborhood::OFFSET_X[Direction] != 0 && FNeighborhood::OFFSET_Y[Direction] != 0;
+            const int32 NewCost = CurrentCost + (IsDiagonal ? FCostTraits::DIAGONAL_COST : FCostTraits::STRAIGHT_COST);
+            const int32 PreviousCost = LocalCosts[NeighborLocal];
+            if (NewCost >= PreviousCost)
+            {
+                continue;
+            }
+
+            const int32 EstimatedCostToGoal = Estimate(NeighborLocal);
+            LocalCosts[NeighborLocal] = NewCost;
+            LocalDirections[NeighborLocal] = static_cast<uint8>(Direction);
+
+            if (PreviousCost != UNREACHABLE)
+            {
+                ClusterOpenList.DecreaseKey(NeighborLocal, PreviousCost + EstimatedCostToGoal,
+                    NewCost + EstimatedCostToGoal, EstimatedCostToGoal);
+            }
+            else
+            {
+                ClusterOpenList.Push(NeighborLocal, NewCost + EstimatedCostToGoal, EstimatedCostToGoal);
+            }
+        }
+    }
+
+    return TargetLocal == INDEX_NONE;
+}
@@ -0,0 +1,147 @@
+// HierarchicalGraph.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "OpenList.h"
+
+/** Abstract path found by FHierarchicalGraph, segments are refined into grid cells on demand */
+struct ASTARPATHFINDING_API FHierarchicalPath
+{
+    //////// FIELDS ////////
+    /// cell indices of the start, the cluster entrances crossed and the goal
+    TArray<int32> Waypoints;
+    int32 Cost = 0;
+
+    //////// METHODS ////////
+    int32 GetNumSegments() const
+    {
+        return FMath::Max(Waypoints.Num() - 1, 0);
+    }
+};
+
+/**
+ * HPA* abstraction of a grid > https://webdocs.cs.ualberta.ca/~mmueller/ps/hpastar.pdf
+ * The grid is cut into square clusters. Each walkable run along a cluster border gets one or two entrances,
+ * connected to the other entrances of the cluster by cached in-cluster distances.
+ * Queries search the entrance graph first, then refine segments inside single clusters when asked to.
+ * Moves and costs are the ones of PathFinder. Paths are close to optimal, not guaranteed optimal.
+ */
+struct ASTARPATHFINDING_API FHierarchicalGraph
+{
+    //////// CONSTANTS ////////
+    static constexpr int32 DEFAULT_CLUSTER_SIZE = 16;
+    static constexpr int32 UNREACHABLE = MAX_int32;
+
+    //////// METHODS ////////
+    /// Cuts the grid into clusters and builds every one of them
+    void Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY, int32 InClusterSize);
+    bool IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY, int32 InClusterSize) const;
+
+    /// Flags the clusters whose entrances or distances depend on the cell X, Y, they are rebuilt by the next query
+    void MarkCellDirty(int32 X, int32 Y);
+    void RebuildDirtyClusters(const FWalkabilityGrid& Grid);
+
+    /// Searches the entrance graph, OutExploredCells receives the expanded waypoints when set
+    bool FindAbstractPath(
+        const FWalkabilityGrid& Grid,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        FHierarchicalPath& OutPath,
+        TArray<int32>* OutExploredCells = nullptr
+    );
+
+    /// Appends the cells of one segment to OutCells, excluding its first waypoint
+    bool RefineSegment(const FWalkabilityGrid& Grid, const FHierarchicalPath& Path, int32 SegmentIndex,
+        TArray<int32>& OutCells);
+
+    /// Every cell of the path, from start to goal
+    bool RefinePath(const FWalkabilityGrid& Grid, const FHierarchicalPath& Path, TArray<int32>& OutCells);
+
+    int32 GetNumClusters() const
+    {
+        return Clusters.Num();
+    }
+
+    SIZE_T GetAllocatedSize() const;
+
+    /// Releases the graph, it must be built again before the next query
+    void Empty();
+
+private:
+    //////// STRUCTS ////////
+    /// Edge leaving a cluster, from one of its entrances to the adjacent cell of a neighbor cluster
+    struct FTransition
+    {
+        int32 Entrance;
+        int32 TargetCell;
+        int32 Cost;
+    };
+
+    struct FCluster
+    {
+        TArray<int32> Entrances;
+        /// Entrances.Num() squared in-cluster costs, UNREACHABLE when the cluster does not connect them
+        TArray<int32> Distances;
+        TArray<FTransition> Transitions;
+    };
+
+    //////// FIELDS ////////
+    /// graph
+    TArray<FCluster> Clusters;
+    TArray<int32> DirtyClusters;
+    TArray<uint8> DirtyFlags;
+    int32 GridSizeX = 0;
+    int32 GridSizeY = 0;
+    int32 ClusterSize = 0;
+    int32 NumClustersX = 0;
+    int32 NumClustersY = 0;
+
+    /// abstract nodes are numbered cluster by cluster, the numbering is refreshed after each rebuild
+    TArray<int32> NodeOffsets;
+    TArray<int32> NodeCells;
+
+    /// in-cluster search, indexed by (LocalY + 1) * LocalStride + LocalX + 1 around a border of walls
+    int32 LocalStride = 0;
+    TArray<uint8> LocalWalkable;
+    TArray<int32> LocalCosts;
+    TArray<uint8> LocalDirections;
+    TArray<uint8> LocalClosed;
+    TArray<int32> StartLocalCosts;
+    TArray<int32> GoalLocalCosts;
+    TArray<int32> SegmentCells;
+    FBucketOpenList ClusterOpenList;
+
+    /// abstract search, start and goal get the two ids after the entrances when they are not entrances
+    TArray<int32> AbstractCosts;
+    TArray<int32> AbstractParents;
+    TArray<uint32> AbstractGenerations;
+    TArray<uint8> AbstractClosed;
+    uint32 AbstractGeneration = 0;
+    FBinaryHeapOpenList AbstractOpenList;
+
+    //////// METHODS ////////
+    /// Cluster helpers
+    int32 GetClusterIndex(int32 Cell) const;
+    FIntRect GetClusterRect(int32 Cluster) const;
+    int32 GetLocalIndex(int32 Cluster, int32 Cell) const;
+    int32 GetCellFromLocalIndex(int32 Cluster, int32 LocalIndex) const;
+    bool IsCrossable(const FWalkabilityGrid& Grid, int32 X, int32 Y) const;
+
+    /// Abstract node helpers
+    void RefreshNodeIds();
+    int32 FindNodeId(int32 Cell) const;
+
+    /// Build methods
+    void RebuildCluster(const FWalkabilityGrid& Grid, int32 Cluster);
+    void AddTransition(int32 Cluster, int32 Cell, int32 TargetCell, int32 Cost);
+    template <typename VisitorType>
+    void ForEachBorderTransition(const FWalkabilityGrid& Grid, bool bIsVertical, int32 Line, int32 Begin,
+        int32 End, VisitorType&& Visit) const;
+
+    /// Dijkstra inside one cluster, or A* when TargetCell is set. Fills LocalCosts and LocalDirections.
+    void LoadClusterWalkability(const FWalkabilityGrid& Grid, int32 Cluster);
+    bool SearchCluster(const FWalkabilityGrid& Grid, int32 Cluster, int32 SourceCell, int32 TargetCell);
+};
@@ -0,0 +1,309 @@
+#include "IncrementalPathFinder.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    using FCostTraits = TPathCostTraits<int32>;
+    using FNeighborhood = FEightWayNeighborhood;
+
+    FORCEINLINE int32 AddCost(int32 Cost, int32 MovementCost)
+    {
+        return Cost == FIncrementalPathFinder::UNREACHABLE ? Cost : Cost + MovementCost;
+    }
+}
+
+void FIncrementalPathFinder::Initialize(int32 InGridSizeX, int32 InGridSizeY, int32 StartX, int32 StartY,
+    int32 GoalX, int32 GoalY)
+{
+    GridSizeX = InGridSizeX;
+    GridSizeY = InGridSizeY;
+
+    const int32 NodeCount = GridSizeX * GridSizeY;
+    G.Init(UNREACHABLE, NodeCount);
+    Rhs.Init(UNREACHABLE, NodeCount);
+    OpenFlags.Init(0, NodeCount);
+    OpenList.Initialize(NodeCount);
+    OpenList.Reset();
+    ChangedCells.Reset();
+
+    StartIndex = StartY * GridSizeX + StartX;
+    GoalIndex = GoalY * GridSizeX + GoalX;
+    LastStartIndex = StartIndex;
+    KeyModifier = 0;
+
+    // The goal is the only node with a known cost, the first ComputePath spreads it back to the start
+    Rhs[GoalIndex] = 0;
+    UpdateNode(GoalIndex);
+}
+
+bool FIncrementalPathFinder::IsInitializedFor(int32 InGridSizeX, int32 InGridSizeY, int32 GoalX, int32 GoalY) const
+{
+    return G.Num() > 0 && GridSizeX == InGridSizeX && GridSizeY == InGridSizeY
+        && GoalIndex == GoalY * GridSizeX + GoalX;
+}
+
+void FIncrementalPathFinder::MoveStart(int32 StartX, int32 StartY)
+{
+    StartIndex = StartY * GridSizeX + StartX;
+}
+
+void FIncrementalPathFinder::NotifyCellChanged(int32 X, int32 Y)
+{
+    ChangedCells.Add(Y * GridSizeX + X);
+}
+
+bool FIncrementalPathFinder::ComputePath(const FWalkabilityGrid& Grid, float CellSize, TArray<FVector>& OutPath,
+    TArray<FVector>& OutExploredNodes)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FIncrementalPathFinder::ComputePath);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    OutPath.Reset();
+    OutExploredNodes.Reset();
+
+    // Keys already queued were computed from the previous start, the modifier keeps them below the new keys
+    if (StartIndex != LastStartIndex)
+    {
+        KeyModifier += Estimate(LastStartIndex, StartIndex);
+        LastStartIndex = StartIndex;
+    }
+
+    ApplyChangedCells(Grid);
+    ComputeShortestPath(Grid, CellSize, OutExploredNodes);
+
+    // The search may stop with the start still overconsistent, its rhs is already the cost of the path
+    if (Rhs[StartIndex] == UNREACHABLE)
+    {
+        return false;
+    }
+
+    // Each step goes to the neighbor with the lowest movement cost plus cost to the goal
+    const int32 MaxSteps = GridSizeX * GridSizeY;
+    for (int32 Index = StartIndex; ; )
+    {
+        OutPath.Add(FVector((Index % GridSizeX + 0.5f) * CellSize, (Index / GridSizeX + 0.5f) * CellSize, 0.0f));
+        if (Index == GoalIndex)
+        {
+            return true;
+        }
+
+        int32 BestIndex = INDEX_NONE;
+        int32 BestCost = UNREACHABLE;
+        ForEachNeighbor(Index, [this, &Grid, &BestIndex, &BestCost](int32 NeighborIndex, int32 MovementCost)
+        {
+            const int32 Cost = AddCost(G[NeighborIndex], MovementCost);
+            if (Grid.IsCrossable(NeighborIndex) && Cost < BestCost)
+            {
+                BestIndex = NeighborIndex;
+                BestCost = Cost;
+            }
+        });
+
+        if (BestIndex == INDEX_NONE || OutPath.Num() > MaxSteps)
+        {
+            OutPath.Reset();
+            return false;
+        }
+        Index = BestIndex;
+    }
+}
+
+SIZE_T FIncrementalPathFinder::GetAllocatedSize() const
+{
+    return G.GetAllocatedSize()
+        + Rhs.GetAllocatedSize()
+        + OpenFlags.GetAllocatedSize()
+        + OpenList.GetAllocatedSize()
+        + ChangedCells.GetAllocatedSize();
+}
+
+void FIncrementalPathFinder::Empty()
+{
+    G.Empty();
+    Rhs.Empty();
+    OpenFlags.Empty();
+    OpenList = {};
+    ChangedCells.Empty();
+    GridSizeX = 0;
+    GridSizeY = 0;
+    StartIndex = INDEX_NONE;
+    GoalIndex = INDEX_NONE;
+    LastStartIndex = INDEX_NONE;
+    KeyModifier = 0;
+}
+
+int32 FIncrementalPathFinder::Estimate(int32 FromIndex, int32 ToIndex) const
+{
+    return FOctileHeuristic::Estimate<int32>(FMath::Abs(FromIndex % GridSizeX - ToIndex % GridSizeX),
+        FMath::Abs(FromIndex / GridSizeX - ToIndex / GridSizeX));
+}
+
+void FIncrementalPathFinder::CalculateKey(int32 Index, uint32& OutTotalCost, uint32& OutCostToGoal) const
+{
+    const int32 CostToGoal = FMath::Min(G[Index], Rhs[Index]);
+    OutCostToGoal = FCostTraits::ToKey(CostToGoal);
+    OutTotalCost = CostToGoal == UNREACHABLE
+        ? MAX_uint32
+        : FCostTraits::ToKey(CostToGoal + Estimate(StartIndex, Index) + KeyModifier);
+}
+
+void FIncrementalPathFinder::UpdateNode(int32 Index)
+{
+    const bool bIsConsistent = G[Index] == Rhs[Index];
+    if (bIsConsistent)
+    {
+        if (OpenFlags[Index])
+        {
+            OpenList.Remove(Index);
+            OpenFlags[Index] = 0;
+        }
+        return;
+    }
+
+    uint32 TotalCost, CostToGoal;
+    CalculateKey(Index, TotalCost, CostToGoal);
+    if (OpenFlags[Index])
+    {
+        OpenList.UpdateKey(Index, TotalCost, CostToGoal);
+    }
+    else
+    {
+        OpenList.Push(Index, TotalCost, CostToGoal);
+        OpenFlags[Index] = 1;
+    }
+}
+
+int32 FIncrementalPathFinder::ComputeRhs(const FWalkabilityGrid& Grid, int32 Index) const
+{
+    if (Index == GoalIndex)
+    {
+        return 0;
+    }
+
+    // Like PathFinder, a move only needs the cell it enters to be crossable
+    int32 BestCost = UNREACHABLE;
+    ForEachNeighbor(Index, [this, &Grid, &BestCost](int32 NeighborIndex, int32 MovementCost)
+    {
+        if (Grid.IsCrossable(NeighborIndex))
+        {
+            BestCost = FMath::Min(BestCost, AddCost(G[NeighborIndex], MovementCost));
+        }
+    });
+    return BestCost;
+}
+
+void FIncrementalPathFinder::ApplyChangedCells(const FWalkabilityGrid& Grid)
+{
+    // A cell only changes the cost of the moves entering it, so only its neighbors need a new rhs
+    for (const int32 ChangedIndex : ChangedCells)
+    {
+        ForEachNeighbor(ChangedIndex, [this, &Grid](int32 NeighborIndex, int32 MovementCost)
+        {
+            Rhs[NeighborIndex] = ComputeRhs(Grid, NeighborIndex);
+            UpdateNode(NeighborIndex);
+        });
+    }
+    ChangedCells.Reset();
+}
+
+void FIncrementalPathFinder::ComputeShortestPath(const FWalkabilityGrid& Grid, float CellSize,
+    TArray<FVector>& OutExploredNodes)
+{
+    auto IsBefore = [](uint32 TotalCostA, uint32 CostToGoalA, uint32 TotalCostB, uint32 CostToGoalB)
+    {
+        return TotalCostA < TotalCostB || (TotalCostA == TotalCostB && CostToGoalA < CostToGoalB);
+    };
+
+    while (!OpenList.IsEmpty())
+    {
+        uint32 StartTotalCost, StartCostToGoal;
+        CalculateKey(StartIndex, StartTotalCost, StartCostToGoal);
+
+        uint32 TopTotalCost, TopCostToGoal;
+        const int32 CurrentIndex = OpenList.Top(TopTotalCost, TopCostToGoal);
+        if (!IsBefore(TopTotalCost, TopCostToGoal, StartTotalCost, StartCostToGoal)
+            && Rhs[StartIndex] <= G[StartIndex])
+        {
+            break;
+        }
+
+        // Keys computed before the start moved are too low, the node is queued again with its current key
+        uint32 TotalCost, CostToGoal;
+        CalculateKey(CurrentIndex, TotalCost, CostToGoal);
+        if (IsBefore(TopTotalCost, TopCostToGoal, TotalCost, CostToGoal))
+        {
+            OpenList.UpdateKey(CurrentIndex, TotalCost, CostToGoal);
+            continue;
+        }
+
+        OutExploredNodes.Add(FVector((CurrentIndex % GridSizeX + 0.5f) * CellSize,
+            (CurrentIndex / GridSizeX + 0.5f) * CellSize, 0.0f));
+
+        const bool bIsEnterable = Grid.IsCrossable(CurrentIndex);
+        if (G[CurrentIndex] > Rhs[CurrentIndex])
+        {
+            // Cost lowered, neighbors may now reach the goal through this node
+            G[CurrentIndex] = Rhs[CurrentIndex];
+            OpenList.Remove(CurrentIndex);
+            OpenFlags[CurrentIndex] = 0;
+
+            if (!bIsEnterable)
+            {
+                continue;
+            }
+
+            const int32 CurrentCost = G[CurrentIndex];
+            ForEachNeighbor(CurrentIndex, [this, CurrentCost](int32 NeighborIndex, int32 MovementCost)
+            {
+                if (NeighborIndex != GoalIndex && CurrentCost + MovementCost < Rhs[NeighborIndex])
+                {
+                    Rhs[NeighborIndex] = CurrentCost + MovementCost;
+                    UpdateNode(NeighborIndex);
+                }
+            });
+        }
+        else
+        {
+            // Cost raised, the node and the neighbors that went through it look for a new best neighbor
+            const int32 PreviousCost = G[CurrentIndex];
+            G[CurrentIndex] = UNREACHABLE;
+
+            if (bIsEnterable)
+            {
+                ForEachNeighbor(CurrentIndex,
+                    [this, &Grid, PreviousCost](int32 NeighborIndex, int32 MovementCost)
+                {
+                    if (Rhs[NeighborIndex] == AddCost(PreviousCost, MovementCost))
+                    {
+                        Rhs[NeighborIndex] = ComputeRhs(Grid, NeighborIndex);
+                        UpdateNode(NeighborIndex);
+                    }
+                });
+            }
+
+            Rhs[CurrentIndex] = ComputeRhs(Grid, CurrentIndex);
+            UpdateNode(CurrentIndex);
+        }
+    }
+}
+
+template <typename VisitorType>
+void FIncrementalPathFinder::ForEachNeighbor(int32 Index, VisitorType&& Visit) const
+{
+    const int32 X = Index % GridSizeX;
+    const int32 Y = Index / GridSizeX;
+    for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+    {
+        const int32 NeighborX = X + FNeighborhood::OFFSET_X[Direction];
+        const int32 NeighborY = Y + FNeighborhood::OFFSET_Y[Direction];
+        if (static_cast<uint32>(NeighborX) >= static_cast<uint32>(GridSizeX)
+            || static_cast<uint32>(NeighborY) >= static_cast<uint32>(GridSizeY))
+        {
+            continue;
+        }
+
+        const bool IsDiagonal = FNeighborhood::OFFSET_X[Direction] != 0 && FNeighborhood::OFFSET_Y[Direction] != 0;
+        Visit(NeighborY * GridSizeX + NeighborX, IsDiagonal ? FCostTraits::DIAGONAL_COST : FCostTraits::STRAIGHT_COST);
+    }
+}
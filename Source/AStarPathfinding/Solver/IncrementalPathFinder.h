@@ -0,0 +1,74 @@
+// IncrementalPathFinder.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "OpenList.h"
+
+/**
+ * D* Lite > http://idm-lab.org/bib/abstracts/papers/aaai02b.pdf
+ * Searches backward from the goal and keeps its costs between queries. After walls change, only the nodes whose
+ * cost to the goal became inconsistent are expanded again. The start can move freely between queries.
+ * Moves, costs and heuristic are the ones of PathFinder, so paths have the same cost.
+ * OutExploredNodes holds the nodes expanded by the last repair, OutPath every cell of the path.
+ */
+struct ASTARPATHFINDING_API FIncrementalPathFinder
+{
+    //////// CONSTANTS ////////
+    static constexpr int32 UNREACHABLE = MAX_int32;
+
+    //////// METHODS ////////
+    /// Drops the previous state and starts a new search toward the goal
+    void Initialize(int32 InGridSizeX, int32 InGridSizeY, int32 StartX, int32 StartY, int32 GoalX, int32 GoalY);
+    bool IsInitializedFor(int32 InGridSizeX, int32 InGridSizeY, int32 GoalX, int32 GoalY) const;
+
+    bool IsInitialized() const
+    {
+        return G.Num() > 0;
+    }
+
+    /// Keeps the search state, the key modifier makes up for the heuristic change
+    void MoveStart(int32 StartX, int32 StartY);
+
+    /// Records a walkability change of the cell X, Y, the repair runs in the next ComputePath
+    void NotifyCellChanged(int32 X, int32 Y);
+
+    /// Repairs the search state, then follows the costs from the start to the goal
+    bool ComputePath(const FWalkabilityGrid& Grid, float CellSize, TArray<FVector>& OutPath,
+        TArray<FVector>& OutExploredNodes);
+
+    SIZE_T GetAllocatedSize() const;
+
+    /// Releases the search state, Initialize must run before the next query
+    void Empty();
+
+private:
+    //////// FIELDS ////////
+    /// node state indexed by Y * GridSizeX + X, G and Rhs hold costs to the goal
+    TArray<int32> G;
+    TArray<int32> Rhs;
+    TArray<uint8> OpenFlags;
+    FBinaryHeapOpenList OpenList;
+    TArray<int32> ChangedCells;
+
+    int32 GridSizeX = 0;
+    int32 GridSizeY = 0;
+    int32 StartIndex = INDEX_NONE;
+    int32 GoalIndex = INDEX_NONE;
+    int32 LastStartIndex = INDEX_NONE;
+    int32 KeyModifier = 0;
+
+    //////// METHODS ////////
+    int32 Estimate(int32 FromIndex, int32 ToIndex) const;
+
+    /// Keys are compared first on the estimated total cost, then on the cost to the goal
+    void CalculateKey(int32 Index, uint32& OutTotalCost, uint32& OutCostToGoal) const;
+    void UpdateNode(int32 Index);
+    int32 ComputeRhs(const FWalkabilityGrid& Grid, int32 Index) const;
+    void ApplyChangedCells(const FWalkabilityGrid& Grid);
+    void ComputeShortestPath(const FWalkabilityGrid& Grid, float CellSize, TArray<FVector>& OutExploredNodes);
+
+    /// Calls Visit(NeighborIndex, MovementCost) for each neighbor of the cell inside the grid
+    template <typename VisitorType>
+    void ForEachNeighbor(int32 Index, VisitorType&& Visit) const;
+};
@@ -0,0 +1,382 @@
+#include "JumpPointFinder.h"
+#include "JumpPointTable.h"
+#include "PathFinderContext.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    using FCostTraits = TPathCostTraits<int32>;
+    using FNeighborhood = FEightWayNeighborhood;
+
+    struct FJumpQuery
+    {
+        const FWalkabilityGrid& Grid;
+        int32 GridSizeX;
+        int32 GridSizeY;
+        int32 GoalX;
+        int32 GoalY;
+
+        /// Scans move one cell at a time, so they never read past the blocked border of the grid
+        FORCEINLINE bool IsCrossable(int32 X, int32 Y) const
+        {
+            return Grid.IsCrossable(X, Y);
+        }
+    };
+
+    /// JPS, scans the grid until a jump point, the goal or a wall
+    struct FGridJumps
+    {
+        const FJumpQuery& Query;
+
+        /// Number of steps to the next jump point, 0 if there is none
+        int32 Jump(int32 X, int32 Y, int32 Direction) const
+        {
+            const int32 OffsetX = FNeighborhood::OFFSET_X[Direction];
+            const int32 OffsetY = FNeighborhood::OFFSET_Y[Direction];
+
+            for (int32 Steps = 1; ; ++Steps)
+            {
+                X += OffsetX;
+                Y += OffsetY;
+
+                if (!Query.IsCrossable(X, Y))
+                {
+                    return 0;
+                }
+
+                if (X == Query.GoalX && Y == Query.GoalY)
+                {
+                    return Steps;
+                }
+
+                if (OffsetX != 0 && OffsetY != 0)
+                {
+                    // Forced neighbors, or a straight jump point reachable from here
+                    if ((Query.IsCrossable(X - OffsetX, Y + OffsetY) && !Query.IsCrossable(X - OffsetX, Y))
+                        || (Query.IsCrossable(X + OffsetX, Y - OffsetY) && !Query.IsCrossable(X, Y - OffsetY))
+                        || Jump(X, Y, FNeighborhood::GetDirection(OffsetX, 0)) > 0
+                        || Jump(X, Y, FNeighborhood::GetDirection(0, OffsetY)) > 0)
+                    {
+                        return Steps;
+                    }
+                }
+                else if (OffsetX != 0)
+                {
+                    if ((Query.IsCrossable(X + OffsetX, Y + 1) && !Query.IsCrossable(X, Y + 1))
+                        || (Query.IsCrossable(X + OffsetX, Y - 1) && !Query.IsCrossable(X, Y - 1)))
+                    {
+                        return Steps;
+                    }
+                }
+                else if ((Query.IsCrossable(X + 1, Y + OffsetY) && !Query.IsCrossable(X + 1, Y))
+                    || (Query.IsCrossable(X - 1, Y + OffsetY) && !Query.IsCrossable(X - 1, Y)))
+                {
+                    return Steps;
+                }
+            }
+        }
+    };
+
+    /// JPS+, reads jump distances and stops on the goal when it lies within them
+    struct FTableJumps
+    {
+        const FJumpQuery& Query;
+        const FJumpPointTable& Table;
+
+        int32 Jump(int32 X, int32 Y, int32 Direction) const
+        {
+            const int32 OffsetX = FNeighborhood::OFFSET_X[Direction];
+            const int32 OffsetY = FNeighborhood::OFFSET_Y[Direction];
+            const int32 Distance = Table.GetDistance(Y * Query.GridSizeX + X, Direction);
+            const int32 GoalDeltaX = Query.GoalX - X;
+            const int32 GoalDeltaY = Query.GoalY - Y;
+
+            int32 GoalSteps = 0;
+            if (OffsetX != 0 && OffsetY != 0)
+            {
+                // Goal in this quadrant > stop on its row or column, whichever comes first
+                if (GoalDeltaX * OffsetX > 0 && GoalDeltaY * OffsetY > 0)
+                {
+                    GoalSteps = FMath::Min(FMath::Abs(GoalDeltaX), FMath::Abs(GoalDeltaY));
+                }
+            }
+            else if (OffsetX != 0 ? GoalDeltaY == 0 && GoalDeltaX * OffsetX > 0 : GoalDeltaX == 0 && GoalDeltaY * OffsetY > 0)
+            {
+                GoalSteps = FMath::Abs(GoalDeltaX + GoalDeltaY);
+            }
+
+            if (GoalSteps > 0 && GoalSteps <= FMath::Abs(Distance))
+            {
+                return GoalSteps;
+            }
+
+            return FMath::Max(Distance, 0);
+        }
+    };
+
+    /// Calls Visit for the natural and forced neighbors of a node reached through TravelDirection
+    template <typename VisitorType>
+    FORCEINLINE void ForEachPrunedDirection(const FJumpQuery& Query, int32 X, int32 Y, int32 TravelDirection,
+        VisitorType&& Visit)
+    {
+        if (TravelDirection == INDEX_NONE)
+        {
+            for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+            {
+                Visit(Direction);
+            }
+            return;
+        }
+
+        const int32 OffsetX = FNeighborhood::OFFSET_X[TravelDirection];
+        const int32 OffsetY = FNeighborhood::OFFSET_Y[TravelDirection];
+
+        if (OffsetX != 0 && OffsetY != 0)
+        {
+            Visit(FNeighborhood::GetDirection(OffsetX, 0));
+            Visit(FNeighborhood::GetDirection(0, OffsetY));
+            Visit(TravelDirection);
+            if (!Query.IsCrossable(X - OffsetX, Y))
+            {
+                Visit(FNeighborhood::GetDirection(-OffsetX, OffsetY));
+            }
+            if (!Query.IsCrossable(X, Y - OffsetY))
+            {
+                Visit(FNeighborhood::GetDirection(OffsetX, -OffsetY));
+            }
+        }
+        else if (OffsetX != 0)
+        {
+            Visit(TravelDirection);
+            if (!Query.IsCrossable(X, Y + 1))
+            {
+                Visit(FNeighborhood::GetDirection(OffsetX, 1));
+            }
+            if (!Query.IsCrossable(X, Y - 1))
+            {
+                Visit(FNeighborhood::GetDirection(OffsetX, -1));
+            }
+        }
+        else
+        {
+            Visit(TravelDirection);
+            if (!Query.IsCrossable(X + 1, Y))
+            {
+                Visit(FNeighborhood::GetDirection(1, OffsetY));
+            }
+            if (!Query.IsCrossable(X - 1, Y))
+            {
+                Visit(FNeighborhood::GetDirection(-1, OffsetY));
+            }
+        }
+    }
+
+    void ReconstructPathToStart(const FPathFinderContext& Context, int32 EndIndex, int32 StartIndex, float CellSize,
+        TArray<FVector>& OutPath)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AStar_Reconstruction);
+
+        const int32 GridSizeX = Context.GridSizeX;
+
+        int32 PathLength = 1;
+        for (int32 Index = EndIndex; Index != StartIndex; Index = Context.ParentIndices[Index])
+        {
+            const int32 ParentIndex = Context.ParentIndices[Index];
+            PathLength += FMath::Max(FMath::Abs(Index % GridSizeX - ParentIndex % GridSizeX),
+                FMath::Abs(Index / GridSizeX - ParentIndex / GridSizeX));
+        }
+
+        // Walk each jump back to its parent, filling the path from its end
+        OutPath.Reset();
+        OutPath.AddUninitialized(PathLength);
+
+        int32 X = EndIndex % GridSizeX;
+        int32 Y = EndIndex / GridSizeX;
+        int32 PathIndex = PathLength - 1;
+        OutPath[PathIndex] = FVector((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize, 0.0f);
+
+        for (int32 Index = EndIndex; Index != StartIndex; Index = Context.ParentIndices[Index])
+        {
+            const int32 ParentIndex = Context.ParentIndices[Index];
+            const int32 ParentX = ParentIndex % GridSizeX;
+            const int32 ParentY = ParentIndex / GridSizeX;
+            const int32 StepX = FMath::Sign(ParentX - X);
+            const int32 StepY = FMath::Sign(ParentY - Y);
+
+            while (X != ParentX || Y != ParentY)
+            {
+                X += StepX;
+                Y += StepY;
+                OutPath[--PathIndex] = FVector((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize, 0.0f);
+            }
+        }
+    }
+
+    template <typename JumpsType, typename OpenListType>
+    bool Search(FPathFinderContext& Context, const JumpsType& Jumps, const FJumpQuery& Query, int32 StartX,
+        int32 StartY, float CellSize, TArray<FVector>& OutPath, TArray<FVector>& OutExploredNodes)
+    {
+        const int32 GridSizeX = Query.GridSizeX;
+        const int32 GridSizeY = Query.GridSizeY;
+        const int32 StartIndex = StartY * GridSizeX + StartX;
+        const int32 GoalIndex = Query.GoalY * GridSizeX + Query.GoalX;
+
+        OpenListType& NodesToExplore = Context.GetOpenList<OpenListType>();
+        {
+            SCOPE_CYCLE_COUNTER(STAT_AStar_Init);
+
+            Context.BeginQuery(GridSizeX, GridSizeY);
+            Context.EnsureParentIndices();
+
+            NodesToExplore.Initialize(GridSizeX * GridSizeY);
+            NodesToExplore.Reset();
+
+            const int32 StartEstimate = FOctileHeuristic::Estimate<int32>(FMath::Abs(Query.GoalX - StartX),
+                FMath::Abs(Query.GoalY - StartY));
+            Context.TouchNode(StartIndex);
+            Context.SetPackedCost(StartIndex, FCostTraits::Pack(0, 0));
+            Context.ParentIndices[StartIndex] = StartIndex;
+            NodesToExplore.Push(StartIndex, StartEstimate, StartEstimate);
+        }
+
+        SCOPE_CYCLE_COUNTER(STAT_AStar_Search);
+
+        while (!NodesToExplore.IsEmpty())
+        {
+            const int32 CurrentIndex = NodesToExplore.Pop();
+            const int32 CurrentX = CurrentIndex % GridSizeX;
+            const int32 CurrentY = CurrentIndex / GridSizeX;
+
+            OutExploredNodes.Add(FVector((CurrentX + 0.5f) * CellSize, (CurrentY + 0.5f) * CellSize, 0.0f));
+
+            if (CurrentIndex == GoalIndex)
+            {
+                ReconstructPathToStart(Context, GoalIndex, StartIndex, CellSize, OutPath);
+                return true;
+            }
+
+            Context.SetClosed(CurrentIndex);
+
+            const int32 CurrentCost = FCostTraits::Unpack(Context.GetPackedCost(CurrentIndex));
+            const int32 TravelDirection = CurrentIndex == StartIndex ? INDEX_NONE : Context.GetParentDirection(CurrentIndex);
+
+            ForEachPrunedDirection(Query, CurrentX, CurrentY, TravelDirection, [&](int32 Direction)
+            {
+                const int32 Steps = Jumps.Jump(CurrentX, CurrentY, Direction);
+                if (Steps == 0)
+                {
+                    return;
+                }
+
+                const int32 OffsetX = FNeighborhood::OFFSET_X[Direction];
+                const int32 OffsetY = FNeighborhood::OFFSET_Y[Direction];
+                const int32 JumpX = CurrentX + OffsetX * Steps;
+                const int32 JumpY = CurrentY + OffsetY * Steps;
+                const int32 JumpIndex = JumpY * GridSizeX + JumpX;
+
+                Context.TouchNode(JumpIndex);
+                if (Context.IsClosed(JumpIndex))
+                {
+                    return;
+                }
+
+                const int32 MovementCost = OffsetX != 0 && OffsetY != 0 ? FCostTraits::DIAGONAL_COST : FCostTraits::STRAIGHT_COST;
+                const int32 NewCostFromStart = CurrentCost + MovementCost * Steps;
+                const uint32 PackedCost = Context.GetPackedCost(JumpIndex);
+                const bool IsInList = PackedCost != FPathFinderContext::UNREACHED;
+                if (IsInList && NewCostFromStart >= FCostTraits::Unpack(PackedCost))
+                {
+                    return;
+                }
+
+                const int32 EstimatedCostToGoal = FOctileHeuristic::Estimate<int32>(FMath::Abs(Query.GoalX - JumpX),
+                    FMath::Abs(Query.GoalY - JumpY));
+                Context.SetPackedCost(JumpIndex, FCostTraits::Pack(NewCostFromStart, Direction));
+                Context.ParentIndices[JumpIndex] = CurrentIndex;
+
+                if (IsInList)
+                {
+                    NodesToExplore.DecreaseKey(JumpIndex, FCostTraits::Unpack(PackedCost) + EstimatedCostToGoal,
+                        NewCostFromStart + EstimatedCostToGoal, EstimatedCostToGoal);
+                }
+                else
+                {
+                    NodesToExplore.Push(JumpIndex, NewCostFromStart + EstimatedCostToGoal, EstimatedCostToGoal);
+                }
+            });
+        }
+
+        return false;
+    }
+
+    template <typename JumpsType>
+    bool SearchWithOpenList(FPathFinderContext& Context, const JumpsType& Jumps, const FJumpQuery& Query, int32 StartX,
+        int32 StartY, float CellSize, TArray<FVector>& OutPath, TArray<FVector>& OutExploredNodes,
+        EOpenListType OpenListType)
+    {
+        // Reset keeps the allocations of the caller's buffers
+        OutPath.Reset();
+        OutExploredNodes.Reset();
+
+        if (static_cast<uint32>(StartX) >= static_cast<uint32>(Query.GridSizeX)
+            || static_cast<uint32>(StartY) >= static_cast<uint32>(Query.GridSizeY)
+            || static_cast<uint32>(Query.GoalX) >= static_cast<uint32>(Query.GridSizeX)
+            || static_cast<uint32>(Query.GoalY) >= static_cast<uint32>(Query.GridSizeY))
+        {
+            return false; // Invalid Start or Goal > Impossible path
+        }
+
+        switch (OpenListType)
+        {
+        case EOpenListType::LinearScan:
+            return Search<JumpsType, FLinearScanOpenList>(Context, Jumps, Query, StartX, StartY, CellSize,
+                OutPath, OutExploredNodes);
+        case EOpenListType::QuaternaryHeap:
+            return Search<JumpsType, FQuaternaryHeapOpenList>(Context, Jumps, Query, StartX, StartY, CellSize,
+                OutPath, OutExploredNodes);
+        case EOpenListType::BucketQueue:
+            return Search<JumpsType, FBucketOpenList>(Context, Jumps, Query, StartX, StartY, CellSize,
+                OutPath, OutExploredNodes);
+        case EOpenListType::BinaryHeap:
+        default:
+            return Search<JumpsType, FBinaryHeapOpenList>(Context, Jumps, Query, StartX, StartY, CellSize,
+                OutPath, OutExploredNodes);
+        }
+    }
+}
+
+bool JumpPointFinder::Compute(FPathFinderContext& Context, const FWalkabilityGrid& Grid, int32 GridSizeX,
+    int32 GridSizeY, int32 StartX, int32 StartY, int32 GoalX, int32 GoalY, float CellSize, TArray<FVector>& OutPath,
+    TArray<FVector>& OutExploredNodes, EOpenListType OpenListType)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(JumpPointFinder::Compute);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    const FJumpQuery Query = { Grid, GridSizeX, GridSizeY, GoalX, GoalY };
+    const FGridJumps Jumps = { Query };
+    return SearchWithOpenList(Context, Jumps, Query, StartX, StartY, CellSize, OutPath, OutExploredNodes,
+        OpenListType);
+}
+
+bool JumpPointFinder::Compute(FPathFinderContext& Context, const FJumpPointTable& Table,
+    const FWalkabilityGrid& Grid, int32 GridSizeX, int32 GridSizeY, int32 StartX, int32 StartY, int32 GoalX,
+    int32 GoalY, float CellSize, TArray<FVector>& OutPath, TArray<FVector>& OutExploredNodes,
+    EOpenListType OpenListType)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(JumpPointFinder::Compute);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    if (!Table.IsBuiltFor(GridSizeX, GridSizeY))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("JumpPointFinder : Jump point table was not built for this grid"));
+        OutPath.Reset();
+        OutExploredNodes.Reset();
+        return false;
+    }
+
+    const FJumpQuery Query = { Grid, GridSizeX, GridSizeY, GoalX, GoalY };
+    const FTableJumps Jumps = { Query, Table };
+    return SearchWithOpenList(Context, Jumps, Query, StartX, StartY, CellSize, OutPath, OutExploredNodes,
+        OpenListType);
+}
@@ -0,0 +1,52 @@
+// JumpPointFinder.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "PathFinderTypes.h"
+
+struct FPathFinderContext;
+struct FJumpPointTable;
+
+/**
+ * Jump Point Search on the uniform cost 8-way grid > https://en.wikipedia.org/wiki/Jump_point_search
+ * Moves, costs and heuristic are the ones of PathFinder, so paths have the same cost, but only jump points
+ * enter the open list. OutExploredNodes holds the expanded jump points, OutPath every cell of the path.
+ */
+class ASTARPATHFINDING_API JumpPointFinder
+{
+public:
+    //////// METHODS ////////
+    /// JPS, jumps are scanned on the grid during the search
+    static bool Compute(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        float CellSize,
+        TArray<FVector>& OutPath,
+        TArray<FVector>& OutExploredNodes,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap
+    );
+
+    /// JPS+, jumps are read from a table built on the same grid
+    static bool Compute(
+        FPathFinderContext& Context,
+        const FJumpPointTable& Table,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        float CellSize,
+        TArray<FVector>& OutPath,
+        TArray<FVector>& OutExploredNodes,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap
+    );
+};
@@ -0,0 +1,194 @@
+#include "JumpPointTable.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    // Straight distances are computed first, diagonal jump points depend on them
+    constexpr int32 STRAIGHT_DIRECTIONS[] = { 1, 3, 4, 6 };
+    constexpr int32 DIAGONAL_DIRECTIONS[] = { 0, 2, 5, 7 };
+}
+
+void FJumpPointTable::Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FJumpPointTable::Build);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    GridSizeX = InGridSizeX;
+    GridSizeY = InGridSizeY;
+    Distances.SetNumUninitialized(GridSizeX * GridSizeY * NUM_DIRECTIONS);
+
+    auto BuildDirection = [this, &Grid](int32 Direction)
+    {
+        // Scan against the direction so the next cell is always computed first
+        const int32 OffsetX = FEightWayNeighborhood::OFFSET_X[Direction];
+        const int32 OffsetY = FEightWayNeighborhood::OFFSET_Y[Direction];
+        const int32 FirstX = OffsetX > 0 ? GridSizeX - 1 : 0;
+        const int32 FirstY = OffsetY > 0 ? GridSizeY - 1 : 0;
+        const int32 StepX = OffsetX > 0 ? -1 : 1;
+        const int32 StepY = OffsetY > 0 ? -1 : 1;
+
+        for (int32 Y = FirstY; Y >= 0 && Y < GridSizeY; Y += StepY)
+        {
+            for (int32 X = FirstX; X >= 0 && X < GridSizeX; X += StepX)
+            {
+                Distances[(Y * GridSizeX + X) * NUM_DIRECTIONS + Direction] = ComputeDistance(Grid, X, Y, Direction);
+            }
+        }
+    };
+
+    for (const int32 Direction : STRAIGHT_DIRECTIONS)
+    {
+        BuildDirection(Direction);
+    }
+    for (const int32 Direction : DIAGONAL_DIRECTIONS)
+    {
+        BuildDirection(Direction);
+    }
+}
+
+void FJumpPointTable::UpdateCell(const FWalkabilityGrid& Grid, int32 X, int32 Y)
+{
+    ChangedCells.Reset();
+
+    // A cell only changes the jump points of its 3x3 block, every other change comes from the rays crossing them
+    for (int32 CellY = Y - 1; CellY <= Y + 1; ++CellY)
+    {
+        for (int32 CellX = X - 1; CellX <= X + 1; ++CellX)
+        {
+            for (const int32 Direction : STRAIGHT_DIRECTIONS)
+            {
+                PropagateDistance(Grid, CellX - FEightWayNeighborhood::OFFSET_X[Direction],
+                    CellY - FEightWayNeighborhood::OFFSET_Y[Direction], Direction, true);
+            }
+        }
+    }
+
+    for (int32 CellY = Y - 1; CellY <= Y + 1; ++CellY)
+    {
+        for (int32 CellX = X - 1; CellX <= X + 1; ++CellX)
+        {
+            for (const int32 Direction : DIAGONAL_DIRECTIONS)
+            {
+                PropagateDistance(Grid, CellX - FEightWayNeighborhood::OFFSET_X[Direction],
+                    CellY - FEightWayNeighborhood::OFFSET_Y[Direction], Direction, false);
+            }
+        }
+    }
+
+    // Straight distances that changed sign turn diagonal jump points on or off
+    for (const int32 Index : ChangedCells)
+    {
+        const int32 CellX = Index % GridSizeX;
+        const int32 CellY = Index / GridSizeX;
+        for (const int32 Direction : DIAGONAL_DIRECTIONS)
+        {
+            PropagateDistance(Grid, CellX - FEightWayNeighborhood::OFFSET_X[Direction],
+                CellY - FEightWayNeighborhood::OFFSET_Y[Direction], Direction, false);
+        }
+    }
+}
+
+bool FJumpPointTable::IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY) const
+{
+    return GridSizeX == InGridSizeX && GridSizeY == InGridSizeY
+        && Distances.Num() == InGridSizeX * InGridSizeY * NUM_DIRECTIONS;
+}
+
+SIZE_T FJumpPointTable::GetAllocatedSize() const
+{
+    return Distances.GetAllocatedSize() + ChangedCells.GetAllocatedSize();
+}
+
+void FJumpPointTable::Empty()
+{
+    Distances.Empty();
+    ChangedCells.Empty();
+    GridSizeX = 0;
+    GridSizeY = 0;
+}
+
+bool FJumpPointTable::IsCrossable(const FWalkabilityGrid& Grid, int32 X, int32 Y) const
+{
+    // Cells one step outside the grid read as blocked
+    return Grid.IsCrossable(X, Y);
+}
+
+bool FJumpPointTable::IsStraightJumpPoint(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 OffsetX,
+    int32 OffsetY) const
+{
+    // A wall beside the move opens a diagonal that the previous cell could not take
+    if (OffsetX != 0)
+    {
+        return (IsCrossable(Grid, X + OffsetX, Y + 1) && !IsCrossable(Grid, X, Y + 1))
+            || (IsCrossable(Grid, X + OffsetX, Y - 1) && !IsCrossable(Grid, X, Y - 1));
+    }
+
+    return (IsCrossable(Grid, X + 1, Y + OffsetY) && !IsCrossable(Grid, X + 1, Y))
+        || (IsCrossable(Grid, X - 1, Y + OffsetY) && !IsCrossable(Grid, X - 1, Y));
+}
+
+bool FJumpPointTable::IsDiagonalJumpPoint(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 OffsetX,
+    int32 OffsetY) const
+{
+    const bool bHasForcedNeighbor = (IsCrossable(Grid, X - OffsetX, Y + OffsetY) && !IsCrossable(Grid, X - OffsetX, Y))
+        || (IsCrossable(Grid, X + OffsetX, Y - OffsetY) && !IsCrossable(Grid, X, Y - OffsetY));
+
+    // Straight distances of this cell are up to date, they are always updated before the diagonal ones
+    const int32 Index = Y * GridSizeX + X;
+    return bHasForcedNeighbor
+        || GetDistance(Index, FEightWayNeighborhood::GetDirection(OffsetX, 0)) > 0
+        || GetDistance(Index, FEightWayNeighborhood::GetDirection(0, OffsetY)) > 0;
+}
+
+int32 FJumpPointTable::ComputeDistance(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 Direction) const
+{
+    const int32 OffsetX = FEightWayNeighborhood::OFFSET_X[Direction];
+    const int32 OffsetY = FEightWayNeighborhood::OFFSET_Y[Direction];
+    const int32 NextX = X + OffsetX;
+    const int32 NextY = Y + OffsetY;
+
+    if (!IsCrossable(Grid, NextX, NextY))
+    {
+        return 0;
+    }
+
+    const bool bIsJumpPoint = OffsetX != 0 && OffsetY != 0
+        ? IsDiagonalJumpPoint(Grid, NextX, NextY, OffsetX, OffsetY)
+        : IsStraightJumpPoint(Grid, NextX, NextY, OffsetX, OffsetY);
+    if (bIsJumpPoint)
+    {
+        return 1;
+    }
+
+    const int32 NextDistance = GetDistance(NextY * GridSizeX + NextX, Direction);
+    return NextDistance > 0 ? NextDistance + 1 : NextDistance - 1;
+}
+
+void FJumpPointTable::PropagateDistance(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 Direction,
+    bool bTrackChanges)
+{
+    const int32 OffsetX = FEightWayNeighborhood::OFFSET_X[Direction];
+    const int32 OffsetY = FEightWayNeighborhood::OFFSET_Y[Direction];
+
+    // Each distance only depends on the next cell, an unchanged distance leaves the rest of the ray valid
+    while (static_cast<uint32>(X) < static_cast<uint32>(GridSizeX) && static_cast<uint32>(Y) < static_cast<uint32>(GridSizeY))
+    {
+        const int32 Index = Y * GridSizeX + X;
+        int32& Distance = Distances[Index * NUM_DIRECTIONS + Direction];
+        const int32 NewDistance = ComputeDistance(Grid, X, Y, Direction);
+        if (NewDistance == Distance)
+        {
+            return;
+        }
+
+        if (bTrackChanges && (NewDistance > 0) != (Distance > 0))
+        {
+            ChangedCells.Add(Index);
+        }
+
+        Distance = NewDistance;
+        X -= OffsetX;
+        Y -= OffsetY;
+    }
+}
@@ -0,0 +1,55 @@
+// JumpPointTable.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+
+/**
+ * Jump distances precomputed for JPS+ > "JPS+: An Extreme A* Speed Optimization for Static Uniform Cost Grids", Game AI Pro 2
+ * One distance per cell and per direction of FEightWayNeighborhood:
+ * - a positive distance is the number of steps to the next jump point in that direction,
+ * - zero or a negative distance is minus the number of free steps before a wall or the grid border.
+ * Jump points follow the rules of JumpPointFinder, where diagonal moves may cut corners.
+ */
+struct ASTARPATHFINDING_API FJumpPointTable
+{
+    //////// CONSTANTS ////////
+    static constexpr int32 NUM_DIRECTIONS = 8;
+
+    //////// METHODS ////////
+    /// Computes every distance of the grid
+    void Build(const FWalkabilityGrid& Grid, int32 InGridSizeX, int32 InGridSizeY);
+
+    /// Updates the distances affected by a walkability change of the cell X, Y, Grid must already hold the new value
+    void UpdateCell(const FWalkabilityGrid& Grid, int32 X, int32 Y);
+
+    bool IsBuiltFor(int32 InGridSizeX, int32 InGridSizeY) const;
+
+    FORCEINLINE int32 GetDistance(int32 Index, int32 Direction) const
+    {
+        return Distances[Index * NUM_DIRECTIONS + Direction];
+    }
+
+    SIZE_T GetAllocatedSize() const;
+
+    /// Releases the table, it must be built again before the next query
+    void Empty();
+
+private:
+    //////// FIELDS ////////
+    TArray<int32> Distances;
+    int32 GridSizeX = 0;
+    int32 GridSizeY = 0;
+
+    /// cells whose straight distances switched between jump point and wall during an update
+    TArray<int32> ChangedCells;
+
+    //////// METHODS ////////
+    bool IsCrossable(const FWalkabilityGrid& Grid, int32 X, int32 Y) const;
+    bool IsStraightJumpPoint(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 OffsetX, int32 OffsetY) const;
+    bool IsDiagonalJumpPoint(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 OffsetX, int32 OffsetY) const;
+    int32 ComputeDistance(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 Direction) const;
+
+    /// Recomputes the distances of X, Y and of the cells behind it, until one keeps its value
+    void PropagateDistance(const FWalkabilityGrid& Grid, int32 X, int32 Y, int32 Direction, bool bTrackChanges);
+};
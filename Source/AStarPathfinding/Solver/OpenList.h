@@ -0,0 +1,481 @@
+// OpenList.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+
+// Open list implementations used by PathFinder.
+// Nodes are identified by their grid index and carry two keys: the total cost used for ordering and the
+// estimated cost to goal used to break ties, so the search goes deep first on equal F. The bucket queue ignores the
+// estimate and breaks ties last in, first out.
+// The open lists only keep the state of the nodes they hold, membership is tracked by the search itself.
+
+/// Operations since the last ResetCounters, read into FPathQueryMetrics by FPathFinderContext
+struct FOpenListCounters
+{
+    int32 Pushes = 0;
+    int32 Pops = 0;
+    int32 DecreaseKeys = 0;
+    int32 PeakNum = 0;
+};
+
+//////// LINEAR SCAN ////////
+/// Reference implementation > O(n) pop and O(n) decrease-key, same order and tie-break as the heaps
+class FLinearScanOpenList
+{
+public:
+    void Initialize(int32 NodeCount)
+    {
+    }
+
+    void Reset()
+    {
+        Count = 0;
+    }
+
+    bool IsEmpty() const
+    {
+        return Count == 0;
+    }
+
+    int32 Num() const
+    {
+        return Count;
+    }
+
+    const FOpenListCounters& GetCounters() const
+    {
+        return Counters;
+    }
+
+    void ResetCounters()
+    {
+        Counters = FOpenListCounters();
+    }
+
+    void Push(int32 Node, uint32 TotalCost, uint32 EstimatedCostToGoal)
+    {
+        if (Count == Entries.Num())
+        {
+            Entries.AddUninitialized(FMath::Max(Count, 64));
+        }
+        Entries[Count++] = { TotalCost, EstimatedCostToGoal, Node };
+        ++Counters.Pushes;
+        Counters.PeakNum = FMath::Max(Counters.PeakNum, Count);
+    }
+
+    void DecreaseKey(int32 Node, uint32 PreviousTotalCost, uint32 TotalCost, uint32 EstimatedCostToGoal)
+    {
+        ++Counters.DecreaseKeys;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            if (Entries[i].Node == Node)
+            {
+                Entries[i].TotalCost = TotalCost;
+                Entries[i].EstimatedCostToGoal = EstimatedCostToGoal;
+                return;
+            }
+        }
+    }
+
+    int32 Pop()
+    {
+        int32 CurrentIndex = 0;
+        for (int32 i = 1; i < Count; ++i)
+        {
+            if (IsBefore(Entries[i], Entries[CurrentIndex]))
+            {
+                CurrentIndex = i;
+            }
+        }
+
+        const int32 Node = Entries[CurrentIndex].Node;
+        Entries[CurrentIndex] = Entries[--Count];
+        ++Counters.Pops;
+        return Node;
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return Entries.GetAllocatedSize();
+    }
+
+private:
+    struct FEntry
+    {
+        uint32 TotalCost;
+        uint32 EstimatedCostToGoal;
+        int32 Node;
+    };
+
+    // Slots past Count are stale, the array only grows so steady state searches never reallocate
+    TArray<FEntry> Entries;
+    int32 Count = 0;
+    FOpenListCounters Counters;
+
+    static bool IsBefore(const FEntry& A, const FEntry& B)
+    {
+        return A.TotalCost < B.TotalCost
+            || (A.TotalCost == B.TotalCost && A.EstimatedCostToGoal < B.EstimatedCostToGoal);
+    }
+};
+
+//////// INDEXED D-ARY HEAP ////////
+/// O(log n) push, pop and decrease-key. The heap slot of every node is stored in a per-node index array.
+template <int32 Arity = 2>
+class TIndexedHeapOpenList
+{
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+
+public:
+    void Initialize(int32 NodeCount)
+    {
+        // Only read for nodes that are in the heap, stale values never need clearing
+        if (Slots.Num() < NodeCount)
+        {
+            Slots.SetNumUninitialized(NodeCount);
+        }
+    }
+
+    void Reset()
+    {
+        Count = 0;
+    }
+
+    bool IsEmpty() const
+    {
+        return Count == 0;
+    }
+
+    int32 Num() const
+    {
+        return Count;
+    }
+
+    const FOpenListCounters& GetCounters() const
+    {
+        return Counters;
+    }
+
+    void ResetCounters()
+    {
+        Counters = FOpenListCounters();
+    }
+
+    void Push(int32 Node, uint32 TotalCost, uint32 EstimatedCostToGoal)
+    {
+        if (Count == Heap.Num())
+        {
+            Heap.AddUninitialized(FMath::Max(Count, 64));
+        }
+
+        Heap[Count] = { TotalCost, EstimatedCostToGoal, Node };
+        SiftUp(Count++);
+        ++Counters.Pushes;
+        Counters.PeakNum = FMath::Max(Counters.PeakNum, Count);
+    }
+
+    void DecreaseKey(int32 Node, uint32 PreviousTotalCost, uint32 TotalCost, uint32 EstimatedCostToGoal)
+    {
+        ++Counters.DecreaseKeys;
+        const int32 Slot = Slots[Node];
+        Heap[Slot].TotalCost = TotalCost;
+        Heap[Slot].EstimatedCostToGoal = EstimatedCostToGoal;
+        SiftUp(Slot);
+    }
+
+    int32 Pop()
+    {
+        const int32 Node = Heap[0].Node;
+        if (--Count > 0)
+        {
+            Heap[0] = Heap[Count];
+            SiftDown(0);
+        }
+        ++Counters.Pops;
+        return Node;
+    }
+
+    /// Incremental searches also raise keys, remove nodes and compare the first key before popping
+    int32 Top(uint32& OutTotalCost, uint32& OutEstimatedCostToGoal) const
+    {
+        OutTotalCost = Heap[0].TotalCost;
+        OutEstimatedCostToGoal = Heap[0].EstimatedCostToGoal;
+        return Heap[0].Node;
+    }
+
+    void UpdateKey(int32 Node, uint32 TotalCost, uint32 EstimatedCostToGoal)
+    {
+        const int32 Slot = Slots[Node];
+        Heap[Slot].TotalCost = TotalCost;
+        Heap[Slot].EstimatedCostToGoal = EstimatedCostToGoal;
+        SiftUp(Slot);
+        SiftDown(Slots[Node]);
+    }
+
+    void Remove(int32 Node)
+    {
+        const int32 Slot = Slots[Node];
+        if (Slot == --Count)
+        {
+            return;
+        }
+
+        // The last entry fills the hole and may have to move either way
+        const int32 MovedNode = Heap[Count].Node;
+        Place(Heap[Count], Slot);
+        SiftUp(Slot);
+        SiftDown(Slots[MovedNode]);
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return Heap.GetAllocatedSize() + Slots.GetAllocatedSize();
+    }
+
+private:
+    struct FEntry
+    {
+        uint32 TotalCost;
+        uint32 EstimatedCostToGoal;
+        int32 Node;
+    };
+
+    // Slots past Count are stale, the array only grows so steady state searches never reallocate
+    TArray<FEntry> Heap;
+    TArray<int32> Slots;
+    int32 Count = 0;
+    FOpenListCounters Counters;
+
+    static bool IsBefore(const FEntry& A, const FEntry& B)
+    {
+        return A.TotalCost < B.TotalCost
+            || (A.TotalCost == B.TotalCost && A.EstimatedCostToGoal < B.EstimatedCostToGoal);
+    }
+
+    void Place(const FEntry& Entry, int32 Slot)
+    {
+        Heap[Slot] = Entry;
+        Slots[Entry.Node] = Slot;
+    }
+
+    void SiftUp(int32 Slot)
+    {
+        const FEntry Entry = Heap[Slot];
+        while (Slot > 0)
+        {
+            const int32 Parent = (Slot - 1) / Arity;
+            if (!IsBefore(Entry, Heap[Parent]))
+            {
+                break;
+            }
+            Place(Heap[Parent], Slot);
+            Slot = Parent;
+        }
+        Place(Entry, Slot);
+    }
+
+    void SiftDown(int32 Slot)
+    {
+        const FEntry Entry = Heap[Slot];
+        while (true)
+        {
+            const int32 FirstChild = Slot * Arity + 1;
+            if (FirstChild >= Count)
+            {
+                break;
+            }
+
+            int32 BestChild = FirstChild;
+            const int32 LastChild = FMath::Min(FirstChild + Arity, Count);
+            for (int32 Child = FirstChild + 1; Child < LastChild; ++Child)
+            {
+                if (IsBefore(Heap[Child], Heap[BestChild]))
+                {
+                    BestChild = Child;
+                }
+            }
+
+            if (!IsBefore(Heap[BestChild], Entry))
+            {
+                break;
+            }
+            Place(Heap[BestChild], Slot);
+            Slot = BestChild;
+        }
+        Place(Entry, Slot);
+    }
+};
+
+using FBinaryHeapOpenList = TIndexedHeapOpenList<2>;
+using FQuaternaryHeapOpenList = TIndexedHeapOpenList<4>;
+
+//////// BUCKET QUEUE ////////
+/// One bucket per integer total cost, stored in a ring that covers the live cost range.
+/// Push, decrease-key and pop are O(1). Ties on total cost pop last in, first out instead of on the estimate:
+/// the last pushed nodes are mostly the successors of the last pop, so the search still dives toward the goal.
+/// Built for the integer STRAIGHT_COST / DIAGONAL_COST costs, where live costs stay in a narrow window.
+class FBucketOpenList
+{
+public:
+    void Initialize(int32 NodeCount)
+    {
+        if (Slots.Num() < NodeCount)
+        {
+            Slots.SetNumUninitialized(NodeCount);
+        }
+    }
+
+    void Reset()
+    {
+        for (FBucket& Bucket : Buckets)
+        {
+            Bucket.Count = 0;
+        }
+        Count = 0;
+    }
+
+    bool IsEmpty() const
+    {
+        return Count == 0;
+    }
+
+    int32 Num() const
+    {
+        return Count;
+    }
+
+    const FOpenListCounters& GetCounters() const
+    {
+        return Counters;
+    }
+
+    void ResetCounters()
+    {
+        Counters = FOpenListCounters();
+    }
+
+    void Push(int32 Node, uint32 TotalCost, uint32 /*EstimatedCostToGoal*/)
+    {
+        Insert(Node, TotalCost);
+        ++Counters.Pushes;
+        Counters.PeakNum = FMath::Max(Counters.PeakNum, Count);
+    }
+
+    void DecreaseKey(int32 Node, uint32 PreviousTotalCost, uint32 TotalCost, uint32 /*EstimatedCostToGoal*/)
+    {
+        RemoveFromBucket(GetBucket(PreviousTotalCost), Slots[Node]);
+        --Count;
+        Insert(Node, TotalCost);
+        ++Counters.DecreaseKeys;
+    }
+
+    int32 Pop()
+    {
+        while (GetBucket(LowestCost).Count == 0)
+        {
+            ++LowestCost;
+        }
+
+        FBucket& Bucket = GetBucket(LowestCost);
+        const int32 Node = Bucket.Entries[--Bucket.Count].Node;
+        --Count;
+        ++Counters.Pops;
+        return Node;
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Size = Buckets.GetAllocatedSize() + Slots.GetAllocatedSize();
+        for (const FBucket& Bucket : Buckets)
+        {
+            Size += Bucket.Entries.GetAllocatedSize();
+        }
+        return Size;
+    }
+
+private:
+    static constexpr int32 INITIAL_BUCKET_COUNT = 64;
+
+    struct FEntry
+    {
+        uint32 TotalCost;
+        int32 Node;
+    };
+
+    struct FBucket
+    {
+        // Slots past Count are stale, buckets never shrink
+        TArray<FEntry> Entries;
+        int32 Count = 0;
+    };
+
+    TArray<FBucket> Buckets;
+    TArray<int32> Slots;
+    uint32 LowestCost = 0;
+    uint32 HighestCost = 0;
+    int32 Count = 0;
+    FOpenListCounters Counters;
+
+    void Insert(int32 Node, uint32 TotalCost)
+    {
+        if (Count == 0)
+        {
+            LowestCost = TotalCost;
+            HighestCost = TotalCost;
+        }
+        else
+        {
+            LowestCost = FMath::Min(LowestCost, TotalCost);
+            HighestCost = FMath::Max(HighestCost, TotalCost);
+        }
+
+        if (static_cast<uint32>(Buckets.Num()) <= HighestCost - LowestCost)
+        {
+            Grow(HighestCost - LowestCost + 1);
+        }
+
+        AddToBucket(GetBucket(TotalCost), { TotalCost, Node });
+        ++Count;
+    }
+
+    FBucket& GetBucket(uint32 Cost)
+    {
+        // Bucket count is a power of two, the mask wraps costs into the ring
+        return Buckets[Cost & (Buckets.Num() - 1)];
+    }
+
+    void AddToBucket(FBucket& Bucket, const FEntry& Entry)
+    {
+        if (Bucket.Count == Bucket.Entries.Num())
+        {
+            Bucket.Entries.AddUninitialized(FMath::Max(Bucket.Count, 8));
+        }
+        Slots[Entry.Node] = Bucket.Count;
+        Bucket.Entries[Bucket.Count++] = Entry;
+    }
+
+    void RemoveFromBucket(FBucket& Bucket, int32 Slot)
+    {
+        if (Slot != --Bucket.Count)
+        {
+            Bucket.Entries[Slot] = Bucket.Entries[Bucket.Count];
+            Slots[Bucket.Entries[Slot].Node] = Slot;
+        }
+    }
+
+    void Grow(uint32 MinBucketCount)
+    {
+        const int32 NewBucketCount = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(MinBucketCount, INITIAL_BUCKET_COUNT));
+
+        TArray<FBucket> OldBuckets = MoveTemp(Buckets);
+        Buckets.SetNum(NewBucketCount);
+
+        for (const FBucket& OldBucket : OldBuckets)
+        {
+            for (int32 i = 0; i < OldBucket.Count; ++i)
+            {
+                AddToBucket(GetBucket(OldBucket.Entries[i].TotalCost), OldBucket.Entries[i]);
+            }
+        }
+    }
+};
@@ -0,0 +1,248 @@
+#include "PathCache.h"
+
+void FPathCache::SetBudget(SIZE_T InBudgetBytes)
+{
+    BudgetBytes = InBudgetBytes;
+    while (Tail != INDEX_NONE && UsedBytes > BudgetBytes)
+    {
+        RemoveEntry(Tail);
+        ++Evictions;
+    }
+}
+
+bool FPathCache::Find(const FPathCacheKey& Key, bool& bOutFoundPath, TArray<FVector>& OutPath)
+{
+    if (!IsEnabled())
+    {
+        return false;
+    }
+
+    const int32* EntryIndex = EntryByKey.Find(Key);
+    if (!EntryIndex)
+    {
+        ++Misses;
+        return false;
+    }
+
+    ++Hits;
+    Unlink(*EntryIndex);
+    LinkAtHead(*EntryIndex);
+
+    const FEntry& Entry = Entries[*EntryIndex];
+    bOutFoundPath = Entry.bFoundPath;
+    OutPath = Entry.Path;
+    return true;
+}
+
+void FPathCache::Add(const FPathCacheKey& Key, uint32 QueryVersion, bool bFoundPath, const TArray<FVector>& Path,
+    const FWalkabilityGrid& Grid, float CellSize)
+{
+    // The grid changed while the query ran, the result may already be out of date
+    if (!IsEnabled() || QueryVersion != Version)
+    {
+        return;
+    }
+
+    if (const int32* ExistingIndex = EntryByKey.Find(Key))
+    {
+        RemoveEntry(*ExistingIndex);
+    }
+
+    FEntry NewEntry;
+    NewEntry.Key = Key;
+    NewEntry.Path = Path;
+    NewEntry.bFoundPath = bFoundPath;
+
+    if (bFoundPath && Path.Num() > 0)
+    {
+        // Length in moves through the cheapest cell, a path leaving the box of start and goal by more than half the
+        // length it has to spare is longer even if every cell it crosses costs the minimum
+        const float InvCellSize = 1.0f / CellSize;
+        const float MinCellCost = Grid.GetMinCellCost();
+        double Length = 0.0;
+        int32 PreviousX = INDEX_NONE;
+        int32 PreviousY = INDEX_NONE;
+        for (const FVector& Position : Path)
+        {
+            const int32 X = FMath::FloorToInt(Position.X * InvCellSize);
+            const int32 Y = FMath::FloorToInt(Position.Y * InvCellSize);
+            NewEntry.PathBounds.MinX = FMath::Min(NewEntry.PathBounds.MinX, X);
+            NewEntry.PathBounds.MinY = FMath::Min(NewEntry.PathBounds.MinY, Y);
+            NewEntry.PathBounds.MaxX = FMath::Max(NewEntry.PathBounds.MaxX, X);
+            NewEntry.PathBounds.MaxY = FMath::Max(NewEntry.PathBounds.MaxY, Y);
+
+            // Only A* runs on grids with cell costs, its moves enter a single cell
+            if (PreviousX != INDEX_NONE)
+            {
+                Length += FMath::Sqrt(static_cast<double>(FMath::Square(X - PreviousX) + FMath::Square(Y - PreviousY)))
+                    * (Grid.GetCellCost(X, Y) / MinCellCost);
+            }
+            PreviousX = X;
+            PreviousY = Y;
+        }
+
+        // Path ends are the start and goal cells, the extra cell covers any-angle paths cutting through cell sides
+        const int32 StartX = FMath::FloorToInt(Path[0].X * InvCellSize);
+        const int32 StartY = FMath::FloorToInt(Path[0].Y * InvCellSize);
+        const int32 DeltaX = FMath::Abs(PreviousX - StartX);
+        const int32 DeltaY = FMath::Abs(PreviousY - StartY);
+        const int32 MarginX = FMath::FloorToInt((Length - DeltaX + 1.0) * 0.5) + 1;
+        const int32 MarginY = FMath::FloorToInt((Length - DeltaY + 1.0) * 0.5) + 1;
+        NewEntry.ImprovementBounds.MinX = FMath::Min(StartX, PreviousX) - MarginX;
+        NewEntry.ImprovementBounds.MinY = FMath::Min(StartY, PreviousY) - MarginY;
+        NewEntry.ImprovementBounds.MaxX = FMath::Max(StartX, PreviousX) + MarginX;
+        NewEntry.ImprovementBounds.MaxY = FMath::Max(StartY, PreviousY) + MarginY;
+    }
+    else
+    {
+        // Blocking a cell never connects a failed query, opening any cell may
+        NewEntry.ImprovementBounds.MinX = MIN_int32;
+        NewEntry.ImprovementBounds.MinY = MIN_int32;
+        NewEntry.ImprovementBounds.MaxX = MAX_int32;
+        NewEntry.ImprovementBounds.MaxY = MAX_int32;
+    }
+
+    NewEntry.Bytes = sizeof(FEntry) + sizeof(TPair<FPathCacheKey, int32>) + NewEntry.Path.GetAllocatedSize();
+    if (NewEntry.Bytes > BudgetBytes)
+    {
+        return;
+    }
+
+    while (UsedBytes + NewEntry.Bytes > BudgetBytes)
+    {
+        RemoveEntry(Tail);
+        ++Evictions;
+    }
+
+    const int32 EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+    UsedBytes += NewEntry.Bytes;
+    Entries[EntryIndex] = MoveTemp(NewEntry);
+    EntryByKey.Add(Key, EntryIndex);
+    LinkAtHead(EntryIndex);
+}
+
+void FPathCache::InvalidateWorsenedCell(int32 X, int32 Y)
+{
+    InvalidateEntries([X, Y](const FEntry& Entry)
+    {
+        return Entry.PathBounds.Contains(X, Y);
+    });
+}
+
+void FPathCache::InvalidateImprovedCell(int32 X, int32 Y)
+{
+    InvalidateEntries([X, Y](const FEntry& Entry)
+    {
+        return Entry.ImprovementBounds.Contains(X, Y);
+    });
+}
+
+void FPathCache::Reset()
+{
+    ++Version;
+    Invalidations += EntryByKey.Num();
+    Entries.Reset();
+    FreeEntries.Reset();
+    EntryByKey.Reset();
+    Head = INDEX_NONE;
+    Tail = INDEX_NONE;
+    UsedBytes = 0;
+}
+
+FPathCacheStats FPathCache::GetStats() const
+{
+    FPathCacheStats Stats;
+    Stats.Hits = Hits;
+    Stats.Misses = Misses;
+    Stats.Evictions = Evictions;
+    Stats.Invalidations = Invalidations;
+    Stats.NumEntries = EntryByKey.Num();
+    Stats.UsedBytes = static_cast<int64>(UsedBytes);
+    return Stats;
+}
+
+SIZE_T FPathCache::GetAllocatedSize() const
+{
+    SIZE_T PathBytes = 0;
+    for (const FEntry& Entry : Entries)
+    {
+        PathBytes += Entry.Path.GetAllocatedSize();
+    }
+    return Entries.GetAllocatedSize() + FreeEntries.GetAllocatedSize() + EntryByKey.GetAllocatedSize() + PathBytes;
+}
+
+void FPathCache::Empty()
+{
+    Reset();
+    Entries.Empty();
+    FreeEntries.Empty();
+    EntryByKey.Empty();
+}
+
+void FPathCache::LinkAtHead(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.Previous = INDEX_NONE;
+    Entry.Next = Head;
+    if (Head != INDEX_NONE)
+    {
+        Entries[Head].Previous = EntryIndex;
+    }
+    else
+    {
+        Tail = EntryIndex;
+    }
+    Head = EntryIndex;
+}
+
+void FPathCache::Unlink(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    if (Entry.Previous != INDEX_NONE)
+    {
+        Entries[Entry.Previous].Next = Entry.Next;
+    }
+    else
+    {
+        Head = Entry.Next;
+    }
+
+    if (Entry.Next != INDEX_NONE)
+    {
+        Entries[Entry.Next].Previous = Entry.Previous;
+    }
+    else
+    {
+        Tail = Entry.Previous;
+    }
+}
+
+void FPathCache::RemoveEntry(int32 EntryIndex)
+{
+    Unlink(EntryIndex);
+
+    FEntry& Entry = Entries[EntryIndex];
+    EntryByKey.Remove(Entry.Key);
+    UsedBytes -= Entry.Bytes;
+    Entry.Path.Empty();
+    Entry.Bytes = 0;
+    FreeEntries.Add(EntryIndex);
+}
+
+template <typename PredicateType>
+void FPathCache::InvalidateEntries(PredicateType&& ShouldRemove)
+{
+    // Queries in flight started before this change, their results are not stored
+    ++Version;
+
+    for (int32 EntryIndex = Head; EntryIndex != INDEX_NONE;)
+    {
+        const int32 NextIndex = Entries[EntryIndex].Next;
+        if (ShouldRemove(Entries[EntryIndex]))
+        {
+            RemoveEntry(EntryIndex);
+            ++Invalidations;
+        }
+        EntryIndex = NextIndex;
+    }
+}
@@ -0,0 +1,128 @@
+// PathCache.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "PathFinderTypes.h"
+
+/** Query a cached path answers, the cells are indexed like the grid */
+struct FPathCacheKey
+{
+    int32 StartIndex = INDEX_NONE;
+    int32 GoalIndex = INDEX_NONE;
+    ESolverMode SolverMode = ESolverMode::AStar;
+    EOpenListType OpenListType = EOpenListType::BinaryHeap;
+    bool bSmoothPath = false;
+
+    bool operator==(const FPathCacheKey& Other) const
+    {
+        return StartIndex == Other.StartIndex && GoalIndex == Other.GoalIndex && SolverMode == Other.SolverMode
+            && OpenListType == Other.OpenListType && bSmoothPath == Other.bSmoothPath;
+    }
+
+    friend uint32 GetTypeHash(const FPathCacheKey& Key)
+    {
+        uint32 Hash = HashCombine(GetTypeHash(Key.StartIndex), GetTypeHash(Key.GoalIndex));
+        Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.SolverMode)));
+        Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.OpenListType)));
+        return HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.bSmoothPath)));
+    }
+};
+
+/**
+ * Results of recent path queries, kept until a cell they depend on changes or the memory budget runs out.
+ * Each entry keeps two boxes of cells:
+ * - the box of its waypoints: blocking a cell or raising its cost outside it leaves the path valid and optimal,
+ *   since a path only gets longer when a cell it crosses gets worse.
+ * - the box no shorter path can leave: any path leaving it is longer than the cached one even through the cheapest
+ *   cells, so opening a cell or lowering its cost outside it cannot make a better path. A failed query keeps the
+ *   whole grid, the opened cell may connect its start and goal.
+ * Every change bumps the version of the cache, results of queries started on an older version are not stored.
+ * The least recently used entries are dropped first once the paths take more than the budget.
+ */
+struct ASTARPATHFINDING_API FPathCache
+{
+    //////// METHODS ////////
+    /// A budget of 0 disables the cache
+    void SetBudget(SIZE_T InBudgetBytes);
+    bool IsEnabled() const { return BudgetBytes > 0; }
+    uint32 GetVersion() const { return Version; }
+
+    /// Copies the cached result into OutPath, counted as a hit or a miss
+    bool Find(const FPathCacheKey& Key, bool& bOutFoundPath, TArray<FVector>& OutPath);
+
+    /// Stores the result of a query started on the version QueryVersion, the path holds the cell centers it crossed
+    void Add(const FPathCacheKey& Key, uint32 QueryVersion, bool bFoundPath, const TArray<FVector>& Path,
+        const FWalkabilityGrid& Grid, float CellSize);
+
+    /// Drops the entries a cell that got blocked or more expensive can make longer
+    void InvalidateWorsenedCell(int32 X, int32 Y);
+
+    /// Drops the entries a cell that got crossable or cheaper can make shorter
+    void InvalidateImprovedCell(int32 X, int32 Y);
+
+    /// Drops every entry, for changes of the whole grid, the counters are kept
+    void Reset();
+
+    FPathCacheStats GetStats() const;
+    SIZE_T GetAllocatedSize() const;
+
+    /// Drops every entry and releases the memory, the counters are kept
+    void Empty();
+
+private:
+    //////// STRUCTS ////////
+    /// Inclusive box of cells, empty when MinX > MaxX
+    struct FCellBounds
+    {
+        int32 MinX = MAX_int32;
+        int32 MinY = MAX_int32;
+        int32 MaxX = MIN_int32;
+        int32 MaxY = MIN_int32;
+
+        FORCEINLINE bool Contains(int32 X, int32 Y) const
+        {
+            return X >= MinX && X <= MaxX && Y >= MinY && Y <= MaxY;
+        }
+    };
+
+    struct FEntry
+    {
+        FPathCacheKey Key;
+        TArray<FVector> Path;
+        FCellBounds PathBounds;
+        FCellBounds ImprovementBounds;
+        bool bFoundPath = false;
+        SIZE_T Bytes = 0;
+
+        /// least recently used list, INDEX_NONE at its ends
+        int32 Previous = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+    };
+
+    //////// FIELDS ////////
+    TArray<FEntry> Entries;
+    TArray<int32> FreeEntries;
+    TMap<FPathCacheKey, int32> EntryByKey;
+
+    /// most recently used entry at the head
+    int32 Head = INDEX_NONE;
+    int32 Tail = INDEX_NONE;
+
+    SIZE_T UsedBytes = 0;
+    SIZE_T BudgetBytes = 0;
+    uint32 Version = 0;
+
+    int32 Hits = 0;
+    int32 Misses = 0;
+    int32 Evictions = 0;
+    int32 Invalidations = 0;
+
+    //////// METHODS ////////
+    void LinkAtHead(int32 EntryIndex);
+    void Unlink(int32 EntryIndex);
+    void RemoveEntry(int32 EntryIndex);
+
+    template <typename PredicateType>
+    void InvalidateEntries(PredicateType&& ShouldRemove);
+};
@@ -1,38 +1,30 @@
 // PathFinder.h
 #pragma once
 
-#include "CoreMinimal.h"
-#include "AStarPathfinding/Grid/GridNode.h"
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderTypes.h"
 
+struct FBidirectionalContext;
+struct FPathFinderContext;
+
+/**
+ * Grid A* with the default policies: 8-way moves, integer 10/14 costs and the octile heuristic.
+ * Other heuristics, neighborhoods or cost types are instantiated through TPathFinder (PathFinderKernel.h).
+ */
 class ASTARPATHFINDING_API PathFinder
 {
 public:
     //////// CONSTANTS ////////
     /// costs constants
-    static constexpr int32 STRAIGHT_COST = 10;
-    static constexpr int32 DIAGONAL_COST = 14;
-    
-    //////// STRUCTS ////////
-    /// nodes structs
-    struct FPathNode
-    {
-        int32 X;
-        int32 Y;
-        int32 CostFromStart;
-        int32 EstimatedCostToGoal;
-        FPathNode* PreviousNode;
-        bool IsExplored;
-    
-        int32 GetTotalCost() const
-        {
-            return CostFromStart + EstimatedCostToGoal;
-        }
-    };
+    static constexpr int32 STRAIGHT_COST = TPathCostTraits<int32>::STRAIGHT_COST;
+    static constexpr int32 DIAGONAL_COST = TPathCostTraits<int32>::DIAGONAL_COST;
 
     //////// METHODS ////////
     /// main method
     static TArray<FVector> Compute(
-        const TArray<FGridNode>& Grid,
+        const FWalkabilityGrid& Grid,
         int32 GridSizeX,
         int32 GridSizeY,
         int32 StartX,
@@ -40,55 +32,72 @@ public:
         int32 GoalX,
         int32 GoalY,
         float CellSize,
-        TArray<FVector>& OutExploredNodes
+        TArray<FVector>& OutExploredNodes,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap
     );
 
-private:
-    //////// FIELDS ////////
-    /// helper fields
-    static const TArray<TPair<int32, int32>> Directions;
+    /// Same search, reusing the node storage, open list and output buffers of Context.
+    /// Does not allocate once the context and the output arrays have grown to fit the grid.
+    static bool Compute(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        float CellSize,
+        TArray<FVector>& OutPath,
+        TArray<FVector>& OutExploredNodes,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap
+    );
 
-    //////// METHODS ////////
-    /// Initialization methods
-    static bool ValidateInputs(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY, int32 GridSizeX, int32 GridSizeY);
-    static void InitializePathNodes(TArray<FPathNode>& PathNodes, int32 GridSizeX, int32 GridSizeY);
-    static void InitializeNode(FPathNode& Node, int32 X, int32 Y);
-    static void SetupStartNode(
-        TArray<FPathNode>& PathNodes,
-        TArray<FPathNode*>& NodesToExplore,
+    /// Same search into a compact result: the path as cell indices, world positions built on request, and the
+    /// explored cells only recorded when OutResult.ExploredCapture asks for them.
+    static bool Compute(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
         int32 StartX,
         int32 StartY,
         int32 GoalX,
         int32 GoalY,
-        int32 GridSizeX
+        FPathResult& OutResult,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap
     );
 
-    /// Pathfinding methods
-    static FPathNode* FindNodeWithLowestCost(TArray<FPathNode*>& NodesToExplore);
-    static bool IsGoalNode(const FPathNode* Node, int32 GoalX, int32 GoalY);
-    static bool ProcessNeighbor(
-        const TPair<int32, int32>& Direction,
-        FPathNode* CurrentNode,
-        TArray<FPathNode>& PathNodes,
-        const TArray<FGridNode>& Grid,
+    /// Same search writing cell indices (Y * GridSizeX + X) instead of world positions, OutExploredCells may be null.
+    /// Touches no engine type beyond the containers, for tools and profiling runs that only need the cells.
+    static bool ComputeCells(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
         int32 GridSizeX,
         int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
         int32 GoalX,
         int32 GoalY,
-        TArray<FPathNode*>& NodesToExplore
+        TArray<int32>& OutPathCells,
+        TArray<int32>* OutExploredCells = nullptr,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap
     );
-    
-    static void UpdateNeighborNode(
-        FPathNode& NeighborNode,
-        FPathNode* CurrentNode,
-        int32 NewCostFromStart,
+
+    /// Bidirectional A*, one frontier from the start and one from the goal, same path costs as Compute.
+    /// bUseTwoThreads runs the goal frontier on a task while the calling thread runs the start frontier.
+    static bool ComputeBidirectional(
+        FBidirectionalContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
         int32 GoalX,
         int32 GoalY,
-        TArray<FPathNode*>& NodesToExplore
+        float CellSize,
+        TArray<FVector>& OutPath,
+        TArray<FVector>& OutExploredNodes,
+        bool bUseTwoThreads = false
     );
-    
-    /// Helpers methods
-    static int32 CalculateDistanceToGoal(int32 FromX, int32 FromY, int32 ToX, int32 ToY);
-    static bool IsNodeCrossable(const TArray<FGridNode>& Grid, int32 GridSizeX, int32 X, int32 Y);
-    static TArray<FVector> ReconstructPathToStart(FPathNode* EndNode, float CellSize);
-};
\ No newline at end of file
+};
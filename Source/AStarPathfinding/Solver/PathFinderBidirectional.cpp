@@ -0,0 +1,319 @@
+#include "PathFinder.h"
+#include "BidirectionalContext.h"
+#include "Tasks/Task.h"
+#include "PathFinderStats.h"
+
+namespace
+{
+    using FCostTraits = TPathCostTraits<int32>;
+    using FNeighborhood = FEightWayNeighborhood;
+
+    /// One search direction. The backward frontier follows moves in reverse, from the cell entered to the cell left.
+    struct FFrontier
+    {
+        FPathFinderContext& Context;
+        TArray<int64>& OwnCosts;
+        const TArray<int64>& OtherCosts;
+        TArray<FVector>& ExploredNodes;
+        volatile int32& OwnMinKey;
+        const volatile int32& OtherMinKey;
+        int32 SourceIndex;
+        int32 TargetIndex;
+        bool bIsBackward;
+    };
+
+    struct FBidirectionalQuery
+    {
+        FBidirectionalContext& Context;
+        const FWalkabilityGrid& Grid;
+        int32 GridSizeX;
+        int32 GridSizeY;
+        int32 StartIndex;
+        int32 StartToGoalEstimate;
+        float CellSize;
+
+        /// Octile distance, consistent in both directions since moves cost the same both ways
+        FORCEINLINE int32 Estimate(int32 FromIndex, int32 ToIndex) const
+        {
+            return FOctileHeuristic::Estimate<int32>(FMath::Abs(FromIndex % GridSizeX - ToIndex % GridSizeX),
+                FMath::Abs(FromIndex / GridSizeX - ToIndex / GridSizeX));
+        }
+
+        /// Twice the balanced potential of Ikeda et al. > https://doi.org/10.1109/VNIS.1994.396824
+        /// Forward and backward potentials sum to a constant, so both frontiers order nodes consistently.
+        /// Shifted by the start to goal estimate to stay positive.
+        FORCEINLINE int32 Potential(const FFrontier& Frontier, int32 Index) const
+        {
+            return Estimate(Index, Frontier.TargetIndex) - Estimate(Frontier.SourceIndex, Index) + StartToGoalEstimate;
+        }
+    };
+
+    void SetupFrontier(const FBidirectionalQuery& Query, FFrontier& Frontier)
+    {
+        FBinaryHeapOpenList& NodesToExplore = Frontier.Context.GetOpenList<FBinaryHeapOpenList>();
+        NodesToExplore.Initialize(Query.GridSizeX * Query.GridSizeY);
+        NodesToExplore.Reset();
+
+        const int32 Key = Query.Potential(Frontier, Frontier.SourceIndex);
+        Frontier.Context.TouchNode(Frontier.SourceIndex);
+        Frontier.Context.SetPackedCost(Frontier.SourceIndex, FCostTraits::Pack(0, 0));
+        FPlatformAtomics::AtomicStore(&Frontier.OwnCosts[Frontier.SourceIndex], Query.Context.MakeTaggedCost(0));
+        FPlatformAtomics::AtomicStore(&Frontier.OwnMinKey, Key);
+        NodesToExplore.Push(Frontier.SourceIndex, Key, Query.Estimate(Frontier.SourceIndex, Frontier.TargetIndex));
+    }
+
+    /// True when no path cheaper than the best meeting is left.
+    /// Keys are 2 * cost + potential, and a shorter path would hold a node in both open lists with keys summing below
+    /// 2 * meeting cost + 2 * start to goal estimate. A stale key of the other frontier is lower, so only delays the stop.
+    bool IsSearchDone(const FBidirectionalQuery& Query, FFrontier& Frontier)
+    {
+        const FBinaryHeapOpenList& NodesToExplore = Frontier.Context.GetOpenList<FBinaryHeapOpenList>();
+        if (NodesToExplore.IsEmpty())
+        {
+            return true;
+        }
+
+        uint32 Key, EstimatedCostToGoal;
+        NodesToExplore.Top(Key, EstimatedCostToGoal);
+        FPlatformAtomics::AtomicStore(&Frontier.OwnMinKey, static_cast<int32>(Key));
+
+        const int64 BestMeeting = FPlatformAtomics::AtomicRead(&Query.Context.BestMeeting);
+        if (BestMeeting == MAX_int64)
+        {
+            return false;
+        }
+
+        const int64 KeySum = static_cast<int64>(Key) + FPlatformAtomics::AtomicRead(&Frontier.OtherMinKey);
+        return KeySum >= 2 * ((BestMeeting >> 32) + Query.StartToGoalEstimate);
+    }
+
+    /// Concurrent frontiers publish their costs with full fences, the interleaved search does not need them
+    template <bool bIsConcurrent>
+    void ExpandNextNode(const FBidirectionalQuery& Query, FFrontier& Frontier)
+    {
+        FPathFinderContext& Context = Frontier.Context;
+        FBinaryHeapOpenList& NodesToExplore = Context.GetOpenList<FBinaryHeapOpenList>();
+        const FWalkabilityGrid& Grid = Query.Grid;
+        const int32 GridSizeX = Query.GridSizeX;
+
+        const int32 CurrentIndex = NodesToExplore.Pop();
+        const int32 CurrentX = CurrentIndex % GridSizeX;
+        const int32 CurrentY = CurrentIndex / GridSizeX;
+        Context.SetClosed(CurrentIndex);
+        Frontier.ExploredNodes.Add(FVector((CurrentX + 0.5f) * Query.CellSize, (CurrentY + 0.5f) * Query.CellSize, 0.0f));
+
+        // Moves only need the cell they enter to be crossable, backward moves enter the current cell
+        if (Frontier.bIsBackward && !Grid.IsCrossable(CurrentX, CurrentY))
+        {
+            return;
+        }
+
+        const int32 CurrentCost = FCostTraits::Unpack(Context.GetPackedCost(CurrentIndex));
+        for (int32 Direction = 0; Direction < FNeighborhood::NUM_DIRECTIONS; ++Direction)
+        {
+            const int32 OffsetX = FNeighborhood::OFFSET_X[Direction];
+            const int32 OffsetY = FNeighborhood::OFFSET_Y[Direction];
+            const int32 NeighborX = CurrentX + OffsetX;
+            const int32 NeighborY = CurrentY + OffsetY;
+            if (static_cast<uint32>(NeighborX) >= static_cast<uint32>(GridSizeX)
+                || static_cast<uint32>(NeighborY) >= static_cast<uint32>(Query.GridSizeY))
+            {
+                continue;
+            }
+
+            // A wall can only start a path, backward searches still reach the start if it is one
+            const int32 NeighborIndex = NeighborY * GridSizeX + NeighborX;
+            if (!Grid.IsCrossable(NeighborX, NeighborY) && !(Frontier.bIsBackward && NeighborIndex == Query.StartIndex))
+            {
+                continue;
+            }
+
+            Context.TouchNode(NeighborIndex);
+            if (Context.IsClosed(NeighborIndex))
+            {
+                continue;
+            }
+
+            const int32 MovementCost = OffsetX != 0 && OffsetY != 0 ? FCostTraits::DIAGONAL_COST : FCostTraits::STRAIGHT_COST;
+            const int32 NewCost = CurrentCost + MovementCost;
+            const uint32 PackedCost = Context.GetPackedCost(NeighborIndex);
+            const bool IsInList = PackedCost != FPathFinderContext::UNREACHED;
+            if (IsInList && NewCost >= FCostTraits::Unpack(PackedCost))
+            {
+                continue;
+            }
+
+            const int32 Potential = Query.Potential(Frontier, NeighborIndex);
+            const int32 EstimatedCost = Query.Estimate(NeighborIndex, Frontier.TargetIndex);
+            Context.SetPackedCost(NeighborIndex, FCostTraits::Pack(NewCost, Direction));
+            if (IsInList)
+            {
+                NodesToExplore.DecreaseKey(NeighborIndex, 2 * FCostTraits::Unpack(PackedCost) + Potential,
+                    2 * NewCost + Potential, EstimatedCost);
+            }
+            else
+            {
+                NodesToExplore.Push(NeighborIndex, 2 * NewCost + Potential, EstimatedCost);
+            }
+
+            // Publish before reading the other side, so of two frontiers reaching a node at once one sees the other
+            if constexpr (bIsConcurrent)
+            {
+                FPlatformAtomics::AtomicStore(&Frontier.OwnCosts[NeighborIndex], Query.Context.MakeTaggedCost(NewCost));
+            }
+            else
+            {
+                Frontier.OwnCosts[NeighborIndex] = Query.Context.MakeTaggedCost(NewCost);
+            }
+            const int32 OtherCost = Query.Context.ReadCost(Frontier.OtherCosts, NeighborIndex);
+            if (OtherCost != INDEX_NONE)
+            {
+                Query.Context.OfferMeeting(NewCost + OtherCost, NeighborIndex);
+            }
+        }
+    }
+
+    void RunFrontier(const FBidirectionalQuery& Query, FFrontier& Frontier)
+    {
+        while (!FPlatformAtomics::AtomicRead(&Query.Context.bIsSearchDone))
+        {
+            if (IsSearchDone(Query, Frontier))
+            {
+                FPlatformAtomics::AtomicStore(&Query.Context.bIsSearchDone, 1);
+                return;
+            }
+            ExpandNextNode<true>(Query, Frontier);
+        }
+    }
+
+    /// Number of cells from Index back to the source of the frontier, Index included
+    int32 CountChainLength(const FPathFinderContext& Context, int32 Index, int32 SourceIndex, int32 GridSizeX)
+    {
+        int32 Length = 1;
+        while (Index != SourceIndex)
+        {
+            const int32 Direction = Context.GetParentDirection(Index);
+            Index -= FNeighborhood::OFFSET_Y[Direction] * GridSizeX + FNeighborhood::OFFSET_X[Direction];
+            ++Length;
+        }
+        return Length;
+    }
+
+    void ReconstructPath(const FBidirectionalQuery& Query, int32 MeetingIndex, int32 GoalIndex,
+        TArray<FVector>& OutPath)
+    {
+        const FPathFinderContext& ForwardContext = Query.Context.ForwardContext;
+        const FPathFinderContext& BackwardContext = Query.Context.BackwardContext;
+        const int32 GridSizeX = Query.GridSizeX;
+        const float CellSize = Query.CellSize;
+
+        const int32 ForwardLength = CountChainLength(ForwardContext, MeetingIndex, Query.StartIndex, GridSizeX);
+        const int32 BackwardLength = CountChainLength(BackwardContext, MeetingIndex, GoalIndex, GridSizeX);
+        OutPath.AddUninitialized(ForwardLength + BackwardLength - 1);
+
+        auto ToPosition = [GridSizeX, CellSize](int32 Index)
+        {
+            return FVector((Index % GridSizeX + 0.5f) * CellSize, (Index / GridSizeX + 0.5f) * CellSize, 0.0f);
+        };
+
+        // Forward parents lead back to the start, backward parents lead on to the goal
+        int32 PathIndex = ForwardLength - 1;
+        for (int32 Index = MeetingIndex; ; )
+        {
+            OutPath[PathIndex] = ToPosition(Index);
+            if (Index == Query.StartIndex)
+            {
+                break;
+            }
+            const int32 Direction = ForwardContext.GetParentDirection(Index);
+            Index -= FNeighborhood::OFFSET_Y[Direction] * GridSizeX + FNeighborhood::OFFSET_X[Direction];
+            --PathIndex;
+        }
+
+        PathIndex = ForwardLength - 1;
+        for (int32 Index = MeetingIndex; Index != GoalIndex; )
+        {
+            const int32 Direction = BackwardContext.GetParentDirection(Index);
+            Index -= FNeighborhood::OFFSET_Y[Direction] * GridSizeX + FNeighborhood::OFFSET_X[Direction];
+            OutPath[++PathIndex] = ToPosition(Index);
+        }
+    }
+}
+
+bool PathFinder::ComputeBidirectional(FBidirectionalContext& Context, const FWalkabilityGrid& Grid, int32 GridSizeX,
+    int32 GridSizeY, int32 StartX, int32 StartY, int32 GoalX, int32 GoalY, float CellSize, TArray<FVector>& OutPath,
+    TArray<FVector>& OutExploredNodes, bool bUseTwoThreads)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(PathFinder::ComputeBidirectional);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    // Reset keeps the allocations of the caller's buffers
+    OutPath.Reset();
+    OutExploredNodes.Reset();
+
+    if (static_cast<uint32>(StartX) >= static_cast<uint32>(GridSizeX) || static_cast<uint32>(StartY) >= static_cast<uint32>(GridSizeY)
+        || static_cast<uint32>(GoalX) >= static_cast<uint32>(GridSizeX) || static_cast<uint32>(GoalY) >= static_cast<uint32>(GridSizeY))
+    {
+        return false; // Invalid Start or Goal > Impossible path
+    }
+
+    const int32 StartIndex = StartY * GridSizeX + StartX;
+    const int32 GoalIndex = GoalY * GridSizeX + GoalX;
+    if (StartIndex == GoalIndex)
+    {
+        OutPath.Add(FVector((StartX + 0.5f) * CellSize, (StartY + 0.5f) * CellSize, 0.0f));
+        OutExploredNodes.Add(OutPath[0]);
+        return true;
+    }
+
+    // Like Compute, the goal is never entered when it is a wall
+    if (!Grid.IsCrossable(GoalX, GoalY))
+    {
+        return false;
+    }
+
+    Context.BeginQuery(GridSizeX, GridSizeY);
+    const int32 StartToGoalEstimate = FOctileHeuristic::Estimate<int32>(FMath::Abs(GoalX - StartX),
+        FMath::Abs(GoalY - StartY));
+    const FBidirectionalQuery Query{ Context, Grid, GridSizeX, GridSizeY, StartIndex, StartToGoalEstimate, CellSize };
+
+    TArray<FVector> BackwardExploredNodes;
+    FFrontier Forward{ Context.ForwardContext, Context.ForwardCosts, Context.BackwardCosts, OutExploredNodes,
+        Context.ForwardMinKey, Context.BackwardMinKey, StartIndex, GoalIndex, false };
+    FFrontier Backward{ Context.BackwardContext, Context.BackwardCosts, Context.ForwardCosts, BackwardExploredNodes,
+        Context.BackwardMinKey, Context.ForwardMinKey, GoalIndex, StartIndex, true };
+    SetupFrontier(Query, Forward);
+    SetupFrontier(Query, Backward);
+
+    if (bUseTwoThreads)
+    {
+        UE::Tasks::FTask BackwardTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Query, &Backward]()
+        {
+            RunFrontier(Query, Backward);
+        });
+        RunFrontier(Query, Forward);
+        BackwardTask.Wait();
+    }
+    else
+    {
+        // Expand the smaller frontier first, it grows the fewest nodes for the same progress
+        while (!IsSearchDone(Query, Forward) && !IsSearchDone(Query, Backward))
+        {
+            FFrontier& Frontier = Context.ForwardContext.BinaryHeapOpenList.Num() <= Context.BackwardContext.BinaryHeapOpenList.Num()
+                ? Forward
+                : Backward;
+            ExpandNextNode<false>(Query, Frontier);
+        }
+    }
+
+    OutExploredNodes.Append(BackwardExploredNodes);
+
+    const int64 BestMeeting = FPlatformAtomics::AtomicRead(&Context.BestMeeting);
+    if (BestMeeting == MAX_int64)
+    {
+        return false;
+    }
+
+    ReconstructPath(Query, static_cast<int32>(BestMeeting & MAX_uint32), GoalIndex, OutPath);
+    return true;
+}
@@ -0,0 +1,82 @@
+#include "PathFinderContext.h"
+#include "PathFinderTypes.h"
+
+void FPathFinderContext::BeginQuery(int32 InGridSizeX, int32 InGridSizeY)
+{
+    if (InGridSizeX != GridSizeX || InGridSizeY != GridSizeY)
+    {
+        GridSizeX = InGridSizeX;
+        GridSizeY = InGridSizeY;
+
+        // Storage is padded to whole blocks so a block reset never needs a bounds check
+        const int32 BlockCount = FMath::DivideAndRoundUp(GridSizeX * GridSizeY, BLOCK_SIZE);
+        PackedCosts.SetNumUninitialized(BlockCount * BLOCK_SIZE);
+        ClosedNodes.SetNumUninitialized(BlockCount);
+        BlockGenerations.SetNumUninitialized(BlockCount);
+        Generation = 0;
+    }
+
+    // Generation 0 marks untouched blocks, a wrap forces one full sweep every 2^32 queries
+    if (++Generation == 0 || Generation == 1)
+    {
+        FMemory::Memzero(BlockGenerations.GetData(), BlockGenerations.Num() * sizeof(uint32));
+        Generation = 1;
+    }
+
+    LinearScanOpenList.ResetCounters();
+    BinaryHeapOpenList.ResetCounters();
+    QuaternaryHeapOpenList.ResetCounters();
+    BucketOpenList.ResetCounters();
+}
+
+void FPathFinderContext::GetQueryCounters(FPathQueryMetrics& OutMetrics) const
+{
+    OutMetrics.Pushes = 0;
+    OutMetrics.Pops = 0;
+    OutMetrics.DecreaseKeys = 0;
+    OutMetrics.PeakOpenListSize = 0;
+    for (const FOpenListCounters* Counters : { &LinearScanOpenList.GetCounters(), &BinaryHeapOpenList.GetCounters(),
+        &QuaternaryHeapOpenList.GetCounters(), &BucketOpenList.GetCounters() })
+    {
+        OutMetrics.Pushes += Counters->Pushes;
+        OutMetrics.Pops += Counters->Pops;
+        OutMetrics.DecreaseKeys += Counters->DecreaseKeys;
+        OutMetrics.PeakOpenListSize = FMath::Max(OutMetrics.PeakOpenListSize, Counters->PeakNum);
+    }
+    OutMetrics.Expansions = OutMetrics.Pops;
+}
+
+void FPathFinderContext::ResetBlock(int32 Block)
+{
+    FMemory::Memset(&PackedCosts[Block << BLOCK_SHIFT], 0xFF, BLOCK_SIZE * sizeof(uint32));
+    ClosedNodes[Block] = 0;
+    BlockGenerations[Block] = Generation;
+}
+
+SIZE_T FPathFinderContext::GetAllocatedSize() const
+{
+    return PackedCosts.GetAllocatedSize()
+        + ClosedNodes.GetAllocatedSize()
+        + BlockGenerations.GetAllocatedSize()
+        + ParentIndices.GetAllocatedSize()
+        + LinearScanOpenList.GetAllocatedSize()
+        + BinaryHeapOpenList.GetAllocatedSize()
+        + QuaternaryHeapOpenList.GetAllocatedSize()
+        + BucketOpenList.GetAllocatedSize();
+}
+
+void FPathFinderContext::Empty()
+{
+    LinearScanOpenList = {};
+    BinaryHeapOpenList = {};
+    QuaternaryHeapOpenList = {};
+    BucketOpenList = {};
+
+    PackedCosts.Empty();
+    ClosedNodes.Empty();
+    BlockGenerations.Empty();
+    ParentIndices.Empty();
+    GridSizeX = 0;
+    GridSizeY = 0;
+    Generation = 0;
+}
@@ -0,0 +1,138 @@
+// PathFinderContext.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "OpenList.h"
+
+struct FPathQueryMetrics;
+
+/**
+ * Search workspace reused across PathFinder::Compute calls.
+ * Node state is stored as a structure of arrays indexed by Y * GridSizeX + X:
+ * - a packed word per node holding the cost from start and the direction taken from the parent node,
+ * - one closed bit per node,
+ * - one generation stamp per block of 64 nodes, stale blocks are reset on first access.
+ * Open nodes are the reached nodes that are not closed, so no open flag is stored.
+ * Searches whose moves span several cells also store a parent index per node, see EnsureParentIndices.
+ * A context is not thread safe, each thread running queries owns its own.
+ */
+struct ASTARPATHFINDING_API FPathFinderContext
+{
+    //////// CONSTANTS ////////
+    static constexpr int32 DIRECTION_BITS = 3;
+    static constexpr uint32 DIRECTION_MASK = (1u << DIRECTION_BITS) - 1;
+    static constexpr uint32 UNREACHED = MAX_uint32;
+    static constexpr int32 BLOCK_SHIFT = 6;
+    static constexpr int32 BLOCK_SIZE = 1 << BLOCK_SHIFT;
+
+    //////// FIELDS ////////
+    /// node storage
+    TArray<uint32> PackedCosts;
+    TArray<uint64> ClosedNodes;
+    TArray<uint32> BlockGenerations;
+    int32 GridSizeX = 0;
+    int32 GridSizeY = 0;
+    uint32 Generation = 0;
+
+    /// parent of each reached node, only allocated by searches that need it
+    TArray<int32> ParentIndices;
+
+    /// open lists
+    FLinearScanOpenList LinearScanOpenList;
+    FBinaryHeapOpenList BinaryHeapOpenList;
+    FQuaternaryHeapOpenList QuaternaryHeapOpenList;
+    FBucketOpenList BucketOpenList;
+
+    //////// METHODS ////////
+    /// Starts a new query, only sweeps the node storage when the grid size changed or the generation wrapped
+    void BeginQuery(int32 InGridSizeX, int32 InGridSizeY);
+
+    /// Resets the block holding Index if the current query did not touch it yet, must run before any other access
+    FORCEINLINE void TouchNode(int32 Index)
+    {
+        const int32 Block = Index >> BLOCK_SHIFT;
+        if (BlockGenerations[Block] != Generation)
+        {
+            ResetBlock(Block);
+        }
+    }
+
+    FORCEINLINE bool IsReached(int32 Index) const
+    {
+        return PackedCosts[Index] != UNREACHED;
+    }
+
+    FORCEINLINE bool IsClosed(int32 Index) const
+    {
+        return (ClosedNodes[Index >> BLOCK_SHIFT] >> (Index & (BLOCK_SIZE - 1))) & 1;
+    }
+
+    FORCEINLINE void SetClosed(int32 Index)
+    {
+        ClosedNodes[Index >> BLOCK_SHIFT] |= uint64(1) << (Index & (BLOCK_SIZE - 1));
+    }
+
+    FORCEINLINE uint32 GetPackedCost(int32 Index) const
+    {
+        return PackedCosts[Index];
+    }
+
+    /// Packed value holding the cost from start and the parent direction, see TPathCostTraits::Pack
+    FORCEINLINE void SetPackedCost(int32 Index, uint32 PackedCost)
+    {
+        PackedCosts[Index] = PackedCost;
+    }
+
+    FORCEINLINE int32 GetParentDirection(int32 Index) const
+    {
+        return PackedCosts[Index] & DIRECTION_MASK;
+    }
+
+    /// Sizes ParentIndices for the current query, entries are only valid on reached nodes
+    FORCEINLINE void EnsureParentIndices()
+    {
+        if (ParentIndices.Num() != PackedCosts.Num())
+        {
+            ParentIndices.SetNumUninitialized(PackedCosts.Num());
+        }
+    }
+
+    template <typename OpenListType>
+    OpenListType& GetOpenList();
+
+    /// Open list counters of the current query, only one open list runs per query
+    void GetQueryCounters(FPathQueryMetrics& OutMetrics) const;
+
+    /// Bytes held by the node storage and open lists
+    SIZE_T GetAllocatedSize() const;
+
+    /// Releases all memory held by the context
+    void Empty();
+
+private:
+    void ResetBlock(int32 Block);
+};
+
+template <>
+FORCEINLINE FLinearScanOpenList& FPathFinderContext::GetOpenList()
+{
+    return LinearScanOpenList;
+}
+
+template <>
+FORCEINLINE FBinaryHeapOpenList& FPathFinderContext::GetOpenList()
+{
+    return BinaryHeapOpenList;
+}
+
+template <>
+FORCEINLINE FQuaternaryHeapOpenList& FPathFinderContext::GetOpenList()
+{
+    return QuaternaryHeapOpenList;
+}
+
+template <>
+FORCEINLINE FBucketOpenList& FPathFinderContext::GetOpenList()
+{
+    return BucketOpenList;
+}
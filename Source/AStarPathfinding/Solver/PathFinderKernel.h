@@ -0,0 +1,436 @@
+// PathFinderKernel.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "PathFinderContext.h"
+#include "PathFinderPolicies.h"
+#include "PathFinderStats.h"
+#include "PathFinderTypes.h"
+#include <type_traits>
+
+/**
+ * Outcome of TPathFinder, the iteration limit only guards against a corrupted context.
+ * The cost limit is reached by paths costing more than the packed costs hold, long paths through expensive cells.
+ */
+enum class EPathSearchResult : uint8
+{
+    Found,
+    NotFound,
+    IterationLimitReached,
+    CostLimitReached
+};
+
+/**
+ * A* search specialised at compile time on its heuristic, neighborhood and cost type.
+ * Neighbor offsets, movement costs and the corner cutting rule are constants of each instantiation:
+ * the neighbor loop is unrolled and carries no branch on the direction type.
+ * Grids with a cost layer run a second instantiation where a move costs its base cost times the cost of the cell
+ * it enters, and the heuristic is scaled by the lowest cell cost to stay admissible. Uniform grids never read costs.
+ * The search only handles cell indices, an output policy (PathFinderPolicies.h) turns them into what the caller
+ * needs: Compute fills world positions or an FPathResult, ComputeCells fills indices without touching engine types
+ * or logs.
+ */
+template <typename HeuristicPolicy, typename NeighborhoodPolicy, typename CostType = int32>
+class TPathFinder
+{
+    static_assert(NeighborhoodPolicy::NUM_DIRECTIONS <= (1 << FPathFinderContext::DIRECTION_BITS),
+        "Parent directions are stored on DIRECTION_BITS bits");
+
+public:
+    using FCostTraits = TPathCostTraits<CostType>;
+
+    //////// METHODS ////////
+    /// main method, picks the open list at runtime
+    static bool Compute(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        float CellSize,
+        TArray<FVector>& OutPath,
+        TArray<FVector>& OutExploredNodes,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap)
+    {
+        FCellCenterOutput Output = { OutPath, OutExploredNodes, CellSize, GridSizeX };
+        const EPathSearchResult Result = ComputeWithOutput(Context, Grid, GridSizeX, GridSizeY, StartX, StartY,
+            GoalX, GoalY, Output, OpenListType);
+        LogSearchLimit(Result);
+        return Result == EPathSearchResult::Found;
+    }
+
+    /// Same search into a compact result, expanded cells are only recorded as OutResult.ExploredCapture asks
+    static bool Compute(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        FPathResult& OutResult,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap)
+    {
+        FPathResultOutput Output = { OutResult, GridSizeX, GridSizeY };
+        const EPathSearchResult Result = ComputeWithOutput(Context, Grid, GridSizeX, GridSizeY, StartX, StartY,
+            GoalX, GoalY, Output, OpenListType);
+        LogSearchLimit(Result);
+        return Result == EPathSearchResult::Found;
+    }
+
+    /// Same search, the path and the expanded cells as cell indices, OutExploredCells may be null
+    static bool ComputeCells(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        TArray<int32>& OutPathCells,
+        TArray<int32>* OutExploredCells = nullptr,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap)
+    {
+        FCellIndexOutput Output = { OutPathCells, OutExploredCells };
+        return ComputeWithOutput(Context, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX, GoalY, Output,
+            OpenListType) == EPathSearchResult::Found;
+    }
+
+    /// Search into any output policy, picks the open list at runtime
+    template <typename OutputType>
+    static EPathSearchResult ComputeWithOutput(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        OutputType& Output,
+        EOpenListType OpenListType = EOpenListType::BinaryHeap)
+    {
+        switch (OpenListType)
+        {
+        case EOpenListType::LinearScan:
+            return Search<FLinearScanOpenList>(Context, Grid, GridSizeX, GridSizeY,
+                StartX, StartY, GoalX, GoalY, Output);
+        case EOpenListType::QuaternaryHeap:
+            return Search<FQuaternaryHeapOpenList>(Context, Grid, GridSizeX, GridSizeY,
+                StartX, StartY, GoalX, GoalY, Output);
+        case EOpenListType::BucketQueue:
+            // Buckets need integer costs, float searches fall back to the binary heap
+            if constexpr (std::is_integral_v<CostType>)
+            {
+                return Search<FBucketOpenList>(Context, Grid, GridSizeX, GridSizeY,
+                    StartX, StartY, GoalX, GoalY, Output);
+            }
+            [[fallthrough]];
+        case EOpenListType::BinaryHeap:
+        default:
+            return Search<FBinaryHeapOpenList>(Context, Grid, GridSizeX, GridSizeY,
+                StartX, StartY, GoalX, GoalY, Output);
+        }
+    }
+
+    /// Search with a fixed open list
+    template <typename OpenListType, typename OutputType>
+    static EPathSearchResult Search(
+        FPathFinderContext& Context,
+        const FWalkabilityGrid& Grid,
+        int32 GridSizeX,
+        int32 GridSizeY,
+        int32 StartX,
+        int32 StartY,
+        int32 GoalX,
+        int32 GoalY,
+        OutputType& Output)
+    {
+        // Reset keeps the allocations of the caller's buffers
+        Output.Reset();
+
+        if (!IsValidPos(StartX, StartY, GridSizeX, GridSizeY) || !IsValidPos(GoalX, GoalY, GridSizeX, GridSizeY))
+        {
+            return EPathSearchResult::NotFound; // Invalid Start or Goal > Impossible path
+        }
+
+        const FQuery Query = { &Grid, CostType(Grid.GetMinCellCost()), GridSizeX, GridSizeY, GoalX, GoalY };
+        if (Grid.HasUniformCosts())
+        {
+            return SearchGrid<OpenListType, false>(Query, Context, StartX, StartY, Output);
+        }
+        return SearchGrid<OpenListType, true>(Query, Context, StartX, StartY, Output);
+    }
+
+    /// Heuristic estimate between a cell and the goal
+    static FORCEINLINE CostType CalculateDistanceToGoal(int32 FromX, int32 FromY, int32 ToX, int32 ToY)
+    {
+        return HeuristicPolicy::template Estimate<CostType>(FMath::Abs(ToX - FromX), FMath::Abs(ToY - FromY));
+    }
+
+private:
+    //////// STRUCTS ////////
+    /// Query constants shared by every expansion
+    struct FQuery
+    {
+        const FWalkabilityGrid* Grid;
+        CostType HeuristicScale;
+        int32 GridSizeX;
+        int32 GridSizeY;
+        int32 GoalX;
+        int32 GoalY;
+    };
+
+    //////// METHODS ////////
+    /// Search loop, bUseCellCosts is false on grids without a cost layer
+    template <typename OpenListType, bool bUseCellCosts, typename OutputType>
+    static EPathSearchResult SearchGrid(const FQuery& Query, FPathFinderContext& Context, int32 StartX, int32 StartY,
+        OutputType& Output)
+    {
+        const FWalkabilityGrid& Grid = *Query.Grid;
+        const int32 GridSizeX = Query.GridSizeX;
+        const int32 GridSizeY = Query.GridSizeY;
+        const int32 StartIndex = StartY * GridSizeX + StartX;
+        const int32 GoalIndex = Query.GoalY * GridSizeX + Query.GoalX;
+
+        OpenListType& NodesToExplore = Context.GetOpenList<OpenListType>();
+        {
+            SCOPE_CYCLE_COUNTER(STAT_AStar_Init);
+
+            // Nodes are reset lazily by the context
+            Context.BeginQuery(GridSizeX, GridSizeY);
+            NodesToExplore.Initialize(GridSizeX * GridSizeY);
+            NodesToExplore.Reset();
+            SetupStartNode<bUseCellCosts>(Query, Context, NodesToExplore, StartIndex, StartX, StartY);
+        }
+
+        SCOPE_CYCLE_COUNTER(STAT_AStar_Search);
+
+        // Safety > prevent infinite loop
+        const int32 MaxIterations = GridSizeX * GridSizeY;
+        int32 IterationCount = 0;
+
+        // Main pathfinding loop
+        while (!NodesToExplore.IsEmpty())
+        {
+            if (++IterationCount > MaxIterations)
+            {
+                return EPathSearchResult::IterationLimitReached;
+            }
+
+            // Coordinates are not stored, they are derived from the node index
+            int32 CurrentIndex;
+            {
+                ASTAR_DETAILED_CYCLE_COUNTER(STAT_AStar_OpenListPop);
+                CurrentIndex = NodesToExplore.Pop();
+            }
+            const int32 CurrentX = CurrentIndex % GridSizeX;
+            const int32 CurrentY = CurrentIndex / GridSizeX;
+
+            Output.AddExplored(CurrentIndex);
+
+            if (CurrentIndex == GoalIndex)
+            {
+                ReconstructPathToStart(Context, GoalIndex, StartIndex, Output);
+                return EPathSearchResult::Found;
+            }
+
+            Context.SetClosed(CurrentIndex);
+
+            // One read of the packed grid covers every neighbor, blocked border cells replace the bounds checks
+            const CostType CurrentCost = FCostTraits::Unpack(Context.GetPackedCost(CurrentIndex));
+            const uint32 NeighborMask = Grid.GetNeighborMask(CurrentX, CurrentY);
+            if (!ExpandNeighbors<bUseCellCosts>(TMakeIntegerSequence<int32, NeighborhoodPolicy::NUM_DIRECTIONS>(),
+                Query, Context, NodesToExplore, CurrentIndex, CurrentX, CurrentY, CurrentCost, NeighborMask))
+            {
+                return EPathSearchResult::CostLimitReached;
+            }
+        }
+
+        return EPathSearchResult::NotFound;
+    }
+
+    /// Heuristic of the query, scaled so it never exceeds the cheapest cost of the moves left.
+    /// Integer estimates are capped to the packed range, a lower estimate stays admissible and consistent.
+    template <bool bUseCellCosts>
+    static FORCEINLINE CostType EstimateCostToGoal(const FQuery& Query, int32 X, int32 Y)
+    {
+        const CostType Estimate = CalculateDistanceToGoal(X, Y, Query.GoalX, Query.GoalY);
+        if constexpr (bUseCellCosts && std::is_integral_v<CostType>)
+        {
+            return static_cast<CostType>(FMath::Min<int64>(static_cast<int64>(Estimate) * Query.HeuristicScale,
+                FCostTraits::MAX_COST));
+        }
+        else if constexpr (bUseCellCosts)
+        {
+            return Estimate * Query.HeuristicScale;
+        }
+        return Estimate;
+    }
+
+    static void LogSearchLimit(EPathSearchResult Result)
+    {
+        if (Result == EPathSearchResult::IterationLimitReached)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PathFinder : Maximum iterations reached, path not found"));
+        }
+        else if (Result == EPathSearchResult::CostLimitReached)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PathFinder : Path costs exceed the packed cost range, path not found"));
+        }
+    }
+
+    /// Initialization methods
+    static FORCEINLINE bool IsValidPos(int32 X, int32 Y, int32 GridSizeX, int32 GridSizeY)
+    {
+        return static_cast<uint32>(X) < static_cast<uint32>(GridSizeX)
+            && static_cast<uint32>(Y) < static_cast<uint32>(GridSizeY);
+    }
+
+    template <bool bUseCellCosts, typename OpenListType>
+    static void SetupStartNode(const FQuery& Query, FPathFinderContext& Context, OpenListType& NodesToExplore,
+        int32 StartIndex, int32 StartX, int32 StartY)
+    {
+        const CostType EstimatedCostToGoal = EstimateCostToGoal<bUseCellCosts>(Query, StartX, StartY);
+        const uint32 Key = FCostTraits::ToKey(EstimatedCostToGoal);
+
+        // The start node has no parent, path reconstruction stops on its index before reading the direction
+        Context.TouchNode(StartIndex);
+        Context.SetPackedCost(StartIndex, FCostTraits::Pack(CostType(0), 0));
+        NodesToExplore.Push(StartIndex, Key, Key);
+    }
+
+    /// Pathfinding methods
+    /// False as soon as a neighbor's cost does not fit the packed costs
+    template <bool bUseCellCosts, typename OpenListType, int32... Directions>
+    static FORCEINLINE bool ExpandNeighbors(TIntegerSequence<int32, Directions...>, const FQuery& Query,
+        FPathFinderContext& Context, OpenListType& NodesToExplore, int32 CurrentIndex, int32 CurrentX,
+        int32 CurrentY, CostType CurrentCost, uint32 NeighborMask)
+    {
+        ASTAR_DETAILED_CYCLE_COUNTER(STAT_AStar_ExpandNeighbors);
+        return (ProcessNeighbor<Directions, bUseCellCosts>(Query, Context, NodesToExplore, CurrentIndex, CurrentX,
+            CurrentY, CurrentCost, NeighborMask) && ...);
+    }
+
+    template <int32 Direction, bool bUseCellCosts, typename OpenListType>
+    static FORCEINLINE bool ProcessNeighbor(const FQuery& Query, FPathFinderContext& Context,
+        OpenListType& NodesToExplore, int32 CurrentIndex, int32 CurrentX, int32 CurrentY, CostType CurrentCost,
+        uint32 NeighborMask)
+    {
+        constexpr int32 OffsetX = NeighborhoodPolicy::OFFSET_X[Direction];
+        constexpr int32 OffsetY = NeighborhoodPolicy::OFFSET_Y[Direction];
+        constexpr bool IsDiagonal = OffsetX != 0 && OffsetY != 0;
+        constexpr CostType MovementCost = IsDiagonal ? FCostTraits::DIAGONAL_COST : FCostTraits::STRAIGHT_COST;
+
+        // Cells outside the grid read as blocked
+        if (!((NeighborMask >> FEightWayNeighborhood::GetDirection(OffsetX, OffsetY)) & 1))
+        {
+            return true;
+        }
+
+        if constexpr (IsDiagonal && !NeighborhoodPolicy::ALLOW_CORNER_CUTTING)
+        {
+            if (!((NeighborMask >> FEightWayNeighborhood::GetDirection(OffsetX, 0)) & 1)
+                || !((NeighborMask >> FEightWayNeighborhood::GetDirection(0, OffsetY)) & 1))
+            {
+                return true;
+            }
+        }
+
+        const int32 NeighborIndex = CurrentIndex + OffsetY * Query.GridSizeX + OffsetX;
+
+        Context.TouchNode(NeighborIndex);
+        if (Context.IsClosed(NeighborIndex))
+        {
+            return true;
+        }
+
+        // Reached nodes that are not closed are in the open list
+        const uint32 PackedCost = Context.GetPackedCost(NeighborIndex);
+        const bool IsInList = PackedCost != FPathFinderContext::UNREACHED;
+        // Moves are priced by the cell they enter
+        CostType NewCostFromStart = CurrentCost + MovementCost;
+        if constexpr (bUseCellCosts)
+        {
+            NewCostFromStart = CurrentCost
+                + MovementCost * Query.Grid->GetLayerCellCost(CurrentX + OffsetX, CurrentY + OffsetY);
+        }
+
+        // Update neighbor if we found a better path
+        if (IsInList && !(NewCostFromStart < FCostTraits::Unpack(PackedCost)))
+        {
+            return true;
+        }
+
+        // Costs stay below MAX_COST, so adding a move or an estimate cannot wrap before this check
+        if constexpr (std::is_integral_v<CostType>)
+        {
+            if (NewCostFromStart > FCostTraits::MAX_COST)
+            {
+                return false;
+            }
+        }
+
+        const CostType EstimatedCostToGoal = EstimateCostToGoal<bUseCellCosts>(Query, CurrentX + OffsetX,
+            CurrentY + OffsetY);
+        const uint32 TotalCostKey = FCostTraits::ToKey(NewCostFromStart + EstimatedCostToGoal);
+        const uint32 EstimateKey = FCostTraits::ToKey(EstimatedCostToGoal);
+
+        Context.SetPackedCost(NeighborIndex, FCostTraits::Pack(NewCostFromStart, Direction));
+
+        if (IsInList)
+        {
+            const uint32 PreviousTotalCostKey = FCostTraits::ToKey(FCostTraits::Unpack(PackedCost) + EstimatedCostToGoal);
+            NodesToExplore.DecreaseKey(NeighborIndex, PreviousTotalCostKey, TotalCostKey, EstimateKey);
+        }
+        else
+        {
+            NodesToExplore.Push(NeighborIndex, TotalCostKey, EstimateKey);
+        }
+        return true;
+    }
+
+    /// Helpers methods
+    static FORCEINLINE int32 GetParentIndex(const FPathFinderContext& Context, int32 Index)
+    {
+        // The stored direction is the move taken from the parent to reach this node
+        const int32 Direction = Context.GetParentDirection(Index);
+        return Index - (NeighborhoodPolicy::OFFSET_Y[Direction] * Context.GridSizeX + NeighborhoodPolicy::OFFSET_X[Direction]);
+    }
+
+    template <typename OutputType>
+    static void ReconstructPathToStart(const FPathFinderContext& Context, int32 EndIndex, int32 StartIndex,
+        OutputType& Output)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AStar_Reconstruction);
+
+        int32 PathLength = 1;
+        for (int32 Index = EndIndex; Index != StartIndex; Index = GetParentIndex(Context, Index))
+        {
+            ++PathLength;
+        }
+
+        // Follow parent directions back to start, filling the path from its end
+        Output.SetPathLength(PathLength);
+
+        int32 Index = EndIndex;
+        for (int32 PathIndex = PathLength - 1; PathIndex >= 0; --PathIndex)
+        {
+            Output.SetPathCell(PathIndex, Index);
+
+            if (Index != StartIndex)
+            {
+                Index = GetParentIndex(Context, Index);
+            }
+        }
+    }
+};
+
+/// Instantiation behind PathFinder::Compute
+using FDefaultPathFinder = TPathFinder<FOctileHeuristic, FEightWayNeighborhood, int32>;
@@ -0,0 +1,266 @@
+// PathFinderPolicies.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "PathResult.h"
+
+//////// COST TYPES ////////
+/// Movement costs and storage of a cost type. Costs are stored in a uint32 shared with the 3-bit parent direction
+/// and compared through uint32 keys in the open lists.
+template <typename CostType>
+struct TPathCostTraits;
+
+template <>
+struct TPathCostTraits<int32>
+{
+    static constexpr int32 STRAIGHT_COST = 10;
+    static constexpr int32 DIAGONAL_COST = 14;
+    /// Largest cost Pack keeps beside the direction, a cost and an estimate both below it sum in a uint32 key
+    static constexpr int32 MAX_COST = static_cast<int32>(MAX_uint32 >> 3);
+
+    static FORCEINLINE uint32 ToKey(int32 Cost)
+    {
+        return static_cast<uint32>(Cost);
+    }
+
+    static FORCEINLINE uint32 Pack(int32 Cost, int32 Direction)
+    {
+        return (static_cast<uint32>(Cost) << 3) | static_cast<uint32>(Direction);
+    }
+
+    static FORCEINLINE int32 Unpack(uint32 Packed)
+    {
+        return static_cast<int32>(Packed >> 3);
+    }
+};
+
+template <>
+struct TPathCostTraits<float>
+{
+    static constexpr float STRAIGHT_COST = 1.0f;
+    static constexpr float DIAGONAL_COST = UE_SQRT_2;
+    static constexpr float MAX_COST = MAX_flt;
+
+    // Bit patterns of non-negative floats sort like the floats themselves
+    static FORCEINLINE uint32 ToKey(float Cost)
+    {
+        uint32 Key;
+        FMemory::Memcpy(&Key, &Cost, sizeof(Key));
+        return Key;
+    }
+
+    // The direction replaces the three lowest mantissa bits
+    static FORCEINLINE uint32 Pack(float Cost, int32 Direction)
+    {
+        return (ToKey(Cost) & ~7u) | static_cast<uint32>(Direction);
+    }
+
+    static FORCEINLINE float Unpack(uint32 Packed)
+    {
+        const uint32 Bits = Packed & ~7u;
+        float Cost;
+        FMemory::Memcpy(&Cost, &Bits, sizeof(Cost));
+        return Cost;
+    }
+};
+
+//////// HEURISTICS ////////
+/// Estimates take the absolute deltas between a cell and the goal
+
+/// Exact distance on an empty 8-way grid > http://theory.stanford.edu/~amitp/GameProgramming/Heuristics.html#diagonal-distance
+struct FOctileHeuristic
+{
+    template <typename CostType>
+    static FORCEINLINE CostType Estimate(int32 DeltaX, int32 DeltaY)
+    {
+        using FTraits = TPathCostTraits<CostType>;
+        const int32 Straight = FMath::Abs(DeltaX - DeltaY);
+        const int32 Diagonal = FMath::Min(DeltaX, DeltaY);
+        return FTraits::STRAIGHT_COST * Straight + FTraits::DIAGONAL_COST * Diagonal;
+    }
+};
+
+/// Every move costs at least a straight step > https://en.wikipedia.org/wiki/Chebyshev_distance
+struct FChebyshevHeuristic
+{
+    template <typename CostType>
+    static FORCEINLINE CostType Estimate(int32 DeltaX, int32 DeltaY)
+    {
+        return TPathCostTraits<CostType>::STRAIGHT_COST * FMath::Max(DeltaX, DeltaY);
+    }
+};
+
+/// Straight line distance, scaled by the diagonal cost so the rounded 10/14 costs never undercut it
+struct FEuclideanHeuristic
+{
+    template <typename CostType>
+    static FORCEINLINE CostType Estimate(int32 DeltaX, int32 DeltaY)
+    {
+        const float Distance = FMath::Sqrt(static_cast<float>(DeltaX) * DeltaX + static_cast<float>(DeltaY) * DeltaY);
+        return static_cast<CostType>(Distance * (TPathCostTraits<CostType>::DIAGONAL_COST / UE_SQRT_2));
+    }
+};
+
+/// Only admissible with 4-way movement > https://en.wikipedia.org/wiki/Taxicab_geometry
+struct FManhattanHeuristic
+{
+    template <typename CostType>
+    static FORCEINLINE CostType Estimate(int32 DeltaX, int32 DeltaY)
+    {
+        return TPathCostTraits<CostType>::STRAIGHT_COST * (DeltaX + DeltaY);
+    }
+};
+
+/// Turns A* into Dijkstra
+struct FZeroHeuristic
+{
+    template <typename CostType>
+    static FORCEINLINE CostType Estimate(int32 DeltaX, int32 DeltaY)
+    {
+        return CostType(0);
+    }
+};
+
+//////// NEIGHBORHOODS ////////
+/// Offsets are indexed by the direction code stored for each node, at most 8 directions fit in 3 bits
+
+/// Represents the 4 neighbors of a node in grid space:
+///        N
+///   W   [C]   E
+///        S
+struct FFourWayNeighborhood
+{
+    static constexpr int32 NUM_DIRECTIONS = 4;
+    static constexpr int32 OFFSET_X[NUM_DIRECTIONS] = { 0, -1, 1, 0 };
+    static constexpr int32 OFFSET_Y[NUM_DIRECTIONS] = { 1, 0, 0, -1 };
+    static constexpr bool ALLOW_CORNER_CUTTING = true;
+};
+
+/// Represents the 8 neighbors of a node in grid space:
+///   NW   N   NE
+///   W   [C]   E
+///   SW   S   SE
+/// Diagonal moves are allowed next to walls
+struct FEightWayNeighborhood
+{
+    static constexpr int32 NUM_DIRECTIONS = 8;
+    static constexpr int32 OFFSET_X[NUM_DIRECTIONS] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+    static constexpr int32 OFFSET_Y[NUM_DIRECTIONS] = { 1, 1, 1, 0, 0, -1, -1, -1 };
+    static constexpr bool ALLOW_CORNER_CUTTING = true;
+
+    /// Direction code of a unit offset, the center cell has none
+    static constexpr int32 GetDirection(int32 OffsetX, int32 OffsetY)
+    {
+        const int32 Cell = (1 - OffsetY) * 3 + OffsetX + 1;
+        return Cell < 4 ? Cell : Cell - 1;
+    }
+};
+
+/// Same neighbors, diagonal moves need both adjacent straight cells to be crossable
+struct FEightWayNoCornerCuttingNeighborhood : FEightWayNeighborhood
+{
+    static constexpr bool ALLOW_CORNER_CUTTING = false;
+};
+
+//////// OUTPUTS ////////
+/// Receive the expanded cells and the path of a search, the search itself only handles cell indices
+
+/// Centers of the cells in world space, what AGridManager displays
+struct FCellCenterOutput
+{
+    TArray<FVector>& Path;
+    TArray<FVector>& ExploredNodes;
+    float CellSize;
+    int32 GridSizeX;
+
+    FORCEINLINE void Reset()
+    {
+        Path.Reset();
+        ExploredNodes.Reset();
+    }
+
+    FORCEINLINE void AddExplored(int32 Index)
+    {
+        ExploredNodes.Add(GetCellCenter(Index));
+    }
+
+    FORCEINLINE void SetPathLength(int32 Length)
+    {
+        Path.Reset();
+        Path.AddUninitialized(Length);
+    }
+
+    FORCEINLINE void SetPathCell(int32 PathIndex, int32 Index)
+    {
+        Path[PathIndex] = GetCellCenter(Index);
+    }
+
+    FORCEINLINE FVector GetCellCenter(int32 Index) const
+    {
+        return FVector((Index % GridSizeX + 0.5f) * CellSize, (Index / GridSizeX + 0.5f) * CellSize, 0.0f);
+    }
+};
+
+/// Cell indices, for tools and benchmarks that do not need positions, expanded cells are skipped without an array
+struct FCellIndexOutput
+{
+    TArray<int32>& Path;
+    TArray<int32>* ExploredCells;
+
+    FORCEINLINE void Reset()
+    {
+        Path.Reset();
+        if (ExploredCells)
+        {
+            ExploredCells->Reset();
+        }
+    }
+
+    FORCEINLINE void AddExplored(int32 Index)
+    {
+        if (ExploredCells)
+        {
+            ExploredCells->Add(Index);
+        }
+    }
+
+    FORCEINLINE void SetPathLength(int32 Length)
+    {
+        Path.Reset();
+        Path.AddUninitialized(Length);
+    }
+
+    FORCEINLINE void SetPathCell(int32 PathIndex, int32 Index)
+    {
+        Path[PathIndex] = Index;
+    }
+};
+
+/// Compact FPathResult, expanded cells are only recorded as its capture mode asks
+struct FPathResultOutput
+{
+    FPathResult& Result;
+    int32 GridSizeX;
+    int32 GridSizeY;
+
+    FORCEINLINE void Reset()
+    {
+        Result.Reset(GridSizeX, GridSizeY);
+    }
+
+    FORCEINLINE void AddExplored(int32 Index)
+    {
+        Result.AddExplored(Index);
+    }
+
+    FORCEINLINE void SetPathLength(int32 Length)
+    {
+        Result.PathCells.Reset();
+        Result.PathCells.AddUninitialized(Length);
+    }
+
+    FORCEINLINE void SetPathCell(int32 PathIndex, int32 Index)
+    {
+        Result.PathCells[PathIndex] = Index;
+    }
+};
@@ -0,0 +1,61 @@
+#include "PathFinderStats.h"
+#include "PathFinderContext.h"
+
+DEFINE_STAT(STAT_AStar_Init);
+DEFINE_STAT(STAT_AStar_Search);
+DEFINE_STAT(STAT_AStar_OpenListPop);
+DEFINE_STAT(STAT_AStar_ExpandNeighbors);
+DEFINE_STAT(STAT_AStar_Reconstruction);
+DEFINE_STAT(STAT_AStar_UpdatePathfinding);
+DEFINE_STAT(STAT_AStar_SpawnPathNodes);
+DEFINE_STAT(STAT_AStar_Queries);
+DEFINE_STAT(STAT_AStar_Expansions);
+DEFINE_STAT(STAT_AStar_Pushes);
+DEFINE_STAT(STAT_AStar_Pops);
+DEFINE_STAT(STAT_AStar_DecreaseKeys);
+DEFINE_STAT(STAT_AStar_PeakOpenListSize);
+DEFINE_STAT(STAT_AStar_QueryTime);
+DEFINE_STAT(STAT_AStar_ContextAllocations);
+
+LLM_DEFINE_TAG(AStarPathfinding);
+
+FPathQueryMetricsScope::FPathQueryMetricsScope(FPathQueryMetrics& InMetrics, const FPathFinderContext* InContext,
+    const TArray<FVector>& InExploredNodes)
+    : Metrics(InMetrics)
+      , Context(InContext)
+      , ExploredNodes(InExploredNodes)
+      , StartCycles(FPlatformTime::Cycles64())
+{
+    if (Context)
+    {
+        StartAllocatedSize = Context->GetAllocatedSize();
+        StartGeneration = Context->Generation;
+    }
+}
+
+FPathQueryMetricsScope::~FPathQueryMetricsScope()
+{
+    Metrics = FPathQueryMetrics();
+    Metrics.WallTimeMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+
+    // A search that ran on the context began a new generation, its counters belong to this query
+    if (Context && Context->Generation != StartGeneration)
+    {
+        Context->GetQueryCounters(Metrics);
+        Metrics.AllocatedBytes = static_cast<int64>(Context->GetAllocatedSize())
+            - static_cast<int64>(StartAllocatedSize);
+    }
+    else
+    {
+        Metrics.Expansions = ExploredNodes.Num();
+    }
+
+    INC_DWORD_STAT(STAT_AStar_Queries);
+    INC_DWORD_STAT_BY(STAT_AStar_Expansions, Metrics.Expansions);
+    INC_DWORD_STAT_BY(STAT_AStar_Pushes, Metrics.Pushes);
+    INC_DWORD_STAT_BY(STAT_AStar_Pops, Metrics.Pops);
+    INC_DWORD_STAT_BY(STAT_AStar_DecreaseKeys, Metrics.DecreaseKeys);
+    SET_DWORD_STAT(STAT_AStar_PeakOpenListSize, Metrics.PeakOpenListSize);
+    SET_FLOAT_STAT(STAT_AStar_QueryTime, Metrics.WallTimeMs);
+    INC_MEMORY_STAT_BY(STAT_AStar_ContextAllocations, FMath::Max<int64>(Metrics.AllocatedBytes, 0));
+}
@@ -0,0 +1,80 @@
+// PathFinderStats.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "PathFinderTypes.h"
+
+struct FPathFinderContext;
+
+// Per-iteration timers in the search loop, their own overhead distorts the loop so they are off by default
+#ifndef ASTARPATHFINDING_DETAILED_STATS
+#define ASTARPATHFINDING_DETAILED_STATS 0
+#endif
+
+#if ASTARPATHFINDING_DETAILED_STATS
+#define ASTAR_DETAILED_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define ASTAR_DETAILED_CYCLE_COUNTER(Stat)
+#endif
+
+/// Shown in game with "stat AStar", the cycle counters also appear as timers in Unreal Insights
+DECLARE_STATS_GROUP(TEXT("AStar"), STATGROUP_AStar, STATCAT_Advanced);
+
+/// timers
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Search Init"), STAT_AStar_Init, STATGROUP_AStar, ASTARPATHFINDING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Search Loop"), STAT_AStar_Search, STATGROUP_AStar, ASTARPATHFINDING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Open List Pop"), STAT_AStar_OpenListPop, STATGROUP_AStar, ASTARPATHFINDING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Neighbor Expansion"), STAT_AStar_ExpandNeighbors, STATGROUP_AStar,
+    ASTARPATHFINDING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path Reconstruction"), STAT_AStar_Reconstruction, STATGROUP_AStar,
+    ASTARPATHFINDING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Pathfinding"), STAT_AStar_UpdatePathfinding, STATGROUP_AStar,
+    ASTARPATHFINDING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Path Nodes"), STAT_AStar_SpawnPathNodes, STATGROUP_AStar, ASTARPATHFINDING_API);
+
+/// counters of the queries run this frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Queries"), STAT_AStar_Queries, STATGROUP_AStar, ASTARPATHFINDING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Expansions"), STAT_AStar_Expansions, STATGROUP_AStar, ASTARPATHFINDING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pushes"), STAT_AStar_Pushes, STATGROUP_AStar, ASTARPATHFINDING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pops"), STAT_AStar_Pops, STATGROUP_AStar, ASTARPATHFINDING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Decrease Keys"), STAT_AStar_DecreaseKeys, STATGROUP_AStar,
+    ASTARPATHFINDING_API);
+
+/// last query
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Peak Open List Size"), STAT_AStar_PeakOpenListSize, STATGROUP_AStar,
+    ASTARPATHFINDING_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Query Time (ms)"), STAT_AStar_QueryTime, STATGROUP_AStar,
+    ASTARPATHFINDING_API);
+
+/// growth of the search contexts since startup
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Context Allocations"), STAT_AStar_ContextAllocations, STATGROUP_AStar,
+    ASTARPATHFINDING_API);
+
+/// Memory of the grid, the solvers and their caches in the LLM report (-llm, "stat LLM")
+LLM_DECLARE_TAG_API(AStarPathfinding, ASTARPATHFINDING_API);
+
+/**
+ * Measures the query run during its lifetime into Metrics, then adds it to the AStar stat group.
+ * Open list counters and allocations are read from the context when the query began a search on it, the other
+ * solvers only report their explored nodes as expansions and the wall time.
+ */
+class ASTARPATHFINDING_API FPathQueryMetricsScope
+{
+public:
+    //////// CONSTRUCTOR ////////
+    /// Context may be null, ExploredNodes is read when the scope ends
+    FPathQueryMetricsScope(FPathQueryMetrics& InMetrics, const FPathFinderContext* InContext,
+        const TArray<FVector>& InExploredNodes);
+    ~FPathQueryMetricsScope();
+
+    UE_NONCOPYABLE(FPathQueryMetricsScope);
+
+private:
+    //////// FIELDS ////////
+    FPathQueryMetrics& Metrics;
+    const FPathFinderContext* Context;
+    const TArray<FVector>& ExploredNodes;
+    uint64 StartCycles;
+    SIZE_T StartAllocatedSize = 0;
+    uint32 StartGeneration = 0;
+};
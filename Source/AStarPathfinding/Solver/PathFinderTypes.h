@@ -0,0 +1,112 @@
+// PathFinderTypes.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "PathFinderTypes.generated.h"
+
+/** Data structure used by PathFinder to hold the nodes waiting to be explored */
+UENUM(BlueprintType)
+enum class EOpenListType : uint8
+{
+    LinearScan      UMETA(DisplayName = "Linear Scan"),
+    BinaryHeap      UMETA(DisplayName = "Binary Heap"),
+    QuaternaryHeap  UMETA(DisplayName = "4-ary Heap"),
+    BucketQueue     UMETA(DisplayName = "Bucket Queue")
+};
+
+/** Search algorithm run by AGridManager */
+UENUM(BlueprintType)
+enum class ESolverMode : uint8
+{
+    AStar                 UMETA(DisplayName = "A*"),
+    JumpPoint             UMETA(DisplayName = "Jump Point Search"),
+    JumpPointPlus         UMETA(DisplayName = "JPS+ (precomputed jumps)"),
+    Hierarchical          UMETA(DisplayName = "HPA* (hierarchical)"),
+    Incremental           UMETA(DisplayName = "D* Lite (incremental)"),
+    Bidirectional         UMETA(DisplayName = "Bidirectional A*"),
+    BidirectionalParallel UMETA(DisplayName = "Bidirectional A* (two threads)"),
+    FlowField             UMETA(DisplayName = "Flow field"),
+    ThetaStar             UMETA(DisplayName = "Theta* (any-angle)"),
+    LazyThetaStar         UMETA(DisplayName = "Lazy Theta* (any-angle)")
+};
+
+/** Identifies a query of FPathRequestQueue, 0 is never a valid request */
+USTRUCT(BlueprintType)
+struct FPathRequestHandle
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Id = 0;
+
+    bool IsValid() const
+    {
+        return Id != 0;
+    }
+
+    bool operator==(const FPathRequestHandle& Other) const
+    {
+        return Id == Other.Id;
+    }
+};
+
+/** Counters of the path cache of AGridManager, since it was spawned */
+USTRUCT(BlueprintType)
+struct FPathCacheStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Hits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Misses = 0;
+
+    /// entries dropped to stay within the memory budget
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Evictions = 0;
+
+    /// entries dropped because a cell they depend on changed
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Invalidations = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 NumEntries = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int64 UsedBytes = 0;
+};
+
+/**
+ * Work done by one path query, see FPathQueryMetricsScope.
+ * A*, jump point search and Theta* fill every field, the other solvers and cached results only report their explored
+ * nodes as expansions and the wall time.
+ */
+USTRUCT(BlueprintType)
+struct FPathQueryMetrics
+{
+    GENERATED_BODY()
+
+    /// nodes taken out of the open list, jump points for jump point search
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Expansions = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Pushes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 Pops = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 DecreaseKeys = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int32 PeakOpenListSize = 0;
+
+    /// bytes the search context grew by, 0 once its buffers fit the grid
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    int64 AllocatedBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Grid|Pathfinding")
+    float WallTimeMs = 0.0f;
+};
@@ -0,0 +1,340 @@
+#include "PathRequestQueue.h"
+#include "AnyAnglePathFinder.h"
+#include "JumpPointFinder.h"
+#include "PathFinder.h"
+#include "PathFinderContext.h"
+#include "PathFinderStats.h"
+#include "Misc/ScopeLock.h"
+
+struct FPathRequestQueue::FRequestState
+{
+    volatile int32 bIsCancelled = 0;
+};
+
+struct FPathRequestQueue::FSharedState
+{
+    /// Grid copy searched by the workers, replaced when the grid revision changes
+    struct FGridSnapshot
+    {
+        FWalkabilityGrid Grid;
+        float CellSize = 0.0f;
+        int32 Revision = 0;
+    };
+
+    /// live grid, owned by the game thread
+    FRWLock GridLock;
+    const FWalkabilityGrid* Grid = nullptr;
+    float CellSize = 0.0f;
+    volatile int32 GridRevision = 0;
+
+    /// snapshot of the latest revision a worker needed
+    FCriticalSection SnapshotLock;
+    TSharedPtr<const FGridSnapshot> Snapshot;
+
+    /// search contexts reused across tasks, one per concurrently running search
+    FCriticalSection ContextLock;
+    TArray<TUniquePtr<FPathFinderContext>> FreeContexts;
+
+    TQueue<FPathRequestResult, EQueueMode::Mpsc> CompletedResults;
+
+    TSharedPtr<const FGridSnapshot> AcquireSnapshot()
+    {
+        FScopeLock Lock(&SnapshotLock);
+        if (Snapshot && Snapshot->Revision == FPlatformAtomics::AtomicRead(&GridRevision))
+        {
+            return Snapshot;
+        }
+
+        // The game thread only waits on the read lock while this copy runs, and only if it edits the grid meanwhile
+        TSharedPtr<FGridSnapshot> NewSnapshot = MakeShared<FGridSnapshot>();
+        {
+            FReadScopeLock ReadLock(GridLock);
+            if (!Grid)
+            {
+                return nullptr;
+            }
+            NewSnapshot->Grid = *Grid;
+            NewSnapshot->CellSize = CellSize;
+            NewSnapshot->Revision = FPlatformAtomics::AtomicRead(&GridRevision);
+        }
+        Snapshot = NewSnapshot;
+        return Snapshot;
+    }
+
+    TUniquePtr<FPathFinderContext> AcquireContext()
+    {
+        FScopeLock Lock(&ContextLock);
+        return FreeContexts.Num() > 0 ? FreeContexts.Pop() : MakeUnique<FPathFinderContext>();
+    }
+
+    void ReleaseContext(TUniquePtr<FPathFinderContext>&& Context)
+    {
+        FScopeLock Lock(&ContextLock);
+        FreeContexts.Add(MoveTemp(Context));
+    }
+};
+
+FPathRequestQueue::FPathRequestQueue()
+    : SharedState(MakeShared<FSharedState>())
+{
+}
+
+FPathRequestQueue::~FPathRequestQueue()
+{
+    // Requests submitted by the cancelled callbacks find no grid, their searches end right away
+    SetGrid(nullptr, 0.0f);
+    CancelAll();
+    for (const UE::Tasks::FTask& Task : RunningTasks)
+    {
+        Task.Wait();
+    }
+}
+
+void FPathRequestQueue::SetGrid(const FWalkabilityGrid* InGrid, float InCellSize)
+{
+    FWriteScopeLock WriteLock(SharedState->GridLock);
+    SharedState->Grid = InGrid;
+    SharedState->CellSize = InCellSize;
+    MarkGridChanged();
+}
+
+FRWLock& FPathRequestQueue::GetGridLock()
+{
+    return SharedState->GridLock;
+}
+
+void FPathRequestQueue::MarkGridChanged()
+{
+    FPlatformAtomics::InterlockedIncrement(&SharedState->GridRevision);
+}
+
+FPathRequestHandle FPathRequestQueue::Submit(const FPathRequest& Request, FOnPathRequestCompleted&& OnCompleted)
+{
+    if (Request.bIsKnownUnreachable)
+    {
+        return SubmitResult(Request, false, TArray<FVector>(), MoveTemp(OnCompleted));
+    }
+
+    TSharedRef<FRequestState> RequestState = MakeShared<FRequestState>();
+    const int32 RequestId = AddPendingRequest(Request.AgentId, RequestState, MoveTemp(OnCompleted));
+
+    // Finished tasks are pruned here so the array stays as small as the number of running searches
+    RunningTasks.RemoveAll([](const UE::Tasks::FTask& Task)
+    {
+        return Task.IsCompleted();
+    });
+
+    RunningTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [State = SharedState, RequestState, Request, RequestId]()
+        {
+            RunRequest(*State, *RequestState, Request, RequestId);
+        }));
+
+    return FPathRequestHandle{ RequestId };
+}
+
+FPathRequestHandle FPathRequestQueue::SubmitResult(const FPathRequest& Request, bool bFoundPath, TArray<FVector>&& Path,
+    FOnPathRequestCompleted&& OnCompleted)
+{
+    const int32 RequestId = AddPendingRequest(Request.AgentId, MakeShared<FRequestState>(), MoveTemp(OnCompleted));
+
+    FPathRequestResult Result;
+    Result.Handle.Id = RequestId;
+    Result.AgentId = Request.AgentId;
+    Result.bFoundPath = bFoundPath;
+    Result.Path = MoveTemp(Path);
+    SharedState->CompletedResults.Enqueue(MoveTemp(Result));
+    return FPathRequestHandle{ RequestId };
+}
+
+bool FPathRequestQueue::Cancel(FPathRequestHandle Handle)
+{
+    if (!PendingRequests.Contains(Handle.Id))
+    {
+        return false;
+    }
+
+    CancelPendingRequest(Handle.Id);
+    return true;
+}
+
+bool FPathRequestQueue::IsPending(FPathRequestHandle Handle) const
+{
+    return PendingRequests.Contains(Handle.Id);
+}
+
+int32 FPathRequestQueue::GetNumPending() const
+{
+    return PendingRequests.Num() + CancelledRequests.Num();
+}
+
+void FPathRequestQueue::DeliverCompletedRequests()
+{
+    // Callbacks may submit or cancel requests, so each one runs after its request left the pending map
+    FPathRequestResult Result;
+    while (SharedState->CompletedResults.Dequeue(Result))
+    {
+        FPendingRequest* PendingRequest = PendingRequests.Find(Result.Handle.Id);
+        if (!PendingRequest)
+        {
+            continue; // Cancelled while running, its callback is queued in CancelledRequests
+        }
+
+        FOnPathRequestCompleted OnCompleted = MoveTemp(PendingRequest->OnCompleted);
+        if (Result.AgentId != INDEX_NONE)
+        {
+            PendingRequestByAgent.Remove(Result.AgentId);
+        }
+        PendingRequests.Remove(Result.Handle.Id);
+
+        if (OnCompleted)
+        {
+            OnCompleted(Result);
+        }
+    }
+
+    TArray<FCancelledRequest> Cancelled = MoveTemp(CancelledRequests);
+    CancelledRequests.Reset();
+    for (FCancelledRequest& CancelledRequest : Cancelled)
+    {
+        if (CancelledRequest.OnCompleted)
+        {
+            CancelledRequest.OnCompleted(CancelledRequest.Result);
+        }
+    }
+}
+
+void FPathRequestQueue::CancelAll()
+{
+    TArray<int32> RequestIds;
+    PendingRequests.GetKeys(RequestIds);
+    for (const int32 RequestId : RequestIds)
+    {
+        CancelPendingRequest(RequestId);
+    }
+
+    for (const UE::Tasks::FTask& Task : RunningTasks)
+    {
+        Task.Wait();
+    }
+    RunningTasks.Reset();
+
+    // The results of the waited searches are dropped, every cancelled callback runs now
+    DeliverCompletedRequests();
+}
+
+void FPathRequestQueue::RunRequest(FSharedState& State, FRequestState& RequestState, const FPathRequest& Request,
+    int32 RequestId)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FPathRequestQueue::RunRequest);
+    LLM_SCOPE_BYTAG(AStarPathfinding);
+
+    if (FPlatformAtomics::AtomicRead(&RequestState.bIsCancelled))
+    {
+        return;
+    }
+
+    FPathRequestResult Result;
+    Result.Handle.Id = RequestId;
+    Result.AgentId = Request.AgentId;
+
+    const TSharedPtr<const FSharedState::FGridSnapshot> Snapshot = State.AcquireSnapshot();
+    if (Snapshot && !FPlatformAtomics::AtomicRead(&RequestState.bIsCancelled))
+    {
+        TUniquePtr<FPathFinderContext> Context = State.AcquireContext();
+        const FWalkabilityGrid& Grid = Snapshot->Grid;
+
+        // Jump points and any-angle paths assume uniform costs, grids with a cost layer always run A*
+        const ESolverMode SolverMode = Grid.HasUniformCosts() ? Request.SolverMode : ESolverMode::AStar;
+
+        // The metrics read the context, the scope ends before it goes back to the pool
+        {
+            FPathQueryMetricsScope MetricsScope(Result.Metrics, Context.Get(), Result.ExploredNodes);
+            switch (SolverMode)
+            {
+            case ESolverMode::JumpPoint:
+                Result.bFoundPath = JumpPointFinder::Compute(*Context, Grid, Grid.GetSizeX(), Grid.GetSizeY(),
+                    Request.StartX, Request.StartY, Request.GoalX, Request.GoalY, Snapshot->CellSize, Result.Path,
+                    Result.ExploredNodes, Request.OpenListType);
+                break;
+            case ESolverMode::ThetaStar:
+            case ESolverMode::LazyThetaStar:
+                Result.bFoundPath = AnyAnglePathFinder::Compute(*Context, Grid, Grid.GetSizeX(), Grid.GetSizeY(),
+                    Request.StartX, Request.StartY, Request.GoalX, Request.GoalY, Snapshot->CellSize, Result.Path,
+                    Result.ExploredNodes, SolverMode == ESolverMode::LazyThetaStar, Request.OpenListType);
+                break;
+            default:
+            {
+                FPathResult CellResult;
+                CellResult.ExploredCapture = Request.bCaptureExploredNodes
+                    ? EExploredCapture::Indices
+                    : EExploredCapture::None;
+                Result.bFoundPath = PathFinder::Compute(*Context, Grid, Grid.GetSizeX(), Grid.GetSizeY(),
+                    Request.StartX, Request.StartY, Request.GoalX, Request.GoalY, CellResult, Request.OpenListType);
+                CellResult.GetWorldPath(Snapshot->CellSize, Result.Path);
+                CellResult.GetWorldExploredNodes(Snapshot->CellSize, Result.ExploredNodes);
+                break;
+            }
+            }
+        }
+        State.ReleaseContext(MoveTemp(Context));
+
+        if (!Request.bCaptureExploredNodes)
+        {
+            Result.ExploredNodes.Empty();
+        }
+
+        if (Result.bFoundPath && Request.bSmoothPath && Grid.HasUniformCosts())
+        {
+            AnyAnglePathFinder::SmoothPath(Grid, Snapshot->CellSize, Result.Path);
+        }
+    }
+
+    if (!FPlatformAtomics::AtomicRead(&RequestState.bIsCancelled))
+    {
+        State.CompletedResults.Enqueue(MoveTemp(Result));
+    }
+}
+
+int32 FPathRequestQueue::AddPendingRequest(int32 AgentId, const TSharedRef<FRequestState>& RequestState,
+    FOnPathRequestCompleted&& OnCompleted)
+{
+    const int32 RequestId = NextRequestId;
+    NextRequestId = NextRequestId == MAX_int32 ? 1 : NextRequestId + 1;
+
+    // The newest request of an agent is the only one it still waits for
+    if (AgentId != INDEX_NONE)
+    {
+        if (const int32* SupersededId = PendingRequestByAgent.Find(AgentId))
+        {
+            CancelPendingRequest(*SupersededId);
+        }
+        PendingRequestByAgent.Add(AgentId, RequestId);
+    }
+
+    PendingRequests.Add(RequestId, { RequestState, MoveTemp(OnCompleted), AgentId });
+    return RequestId;
+}
+
+void FPathRequestQueue::CancelPendingRequest(int32 RequestId)
+{
+    FPendingRequest* PendingRequest = PendingRequests.Find(RequestId);
+    if (!PendingRequest)
+    {
+        return;
+    }
+
+    // The running search is not interrupted, its result is dropped instead
+    FPlatformAtomics::AtomicStore(&PendingRequest->State->bIsCancelled, 1);
+    if (PendingRequest->AgentId != INDEX_NONE)
+    {
+        PendingRequestByAgent.Remove(PendingRequest->AgentId);
+    }
+
+    FCancelledRequest& CancelledRequest = CancelledRequests.AddDefaulted_GetRef();
+    CancelledRequest.Result.Handle.Id = RequestId;
+    CancelledRequest.Result.AgentId = PendingRequest->AgentId;
+    CancelledRequest.Result.bWasCancelled = true;
+    CancelledRequest.OnCompleted = MoveTemp(PendingRequest->OnCompleted);
+    PendingRequests.Remove(RequestId);
+}
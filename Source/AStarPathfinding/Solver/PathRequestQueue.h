@@ -0,0 +1,129 @@
+// PathRequestQueue.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "PathFinderTypes.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeRWLock.h"
+#include "Tasks/Task.h"
+
+/** Query run by FPathRequestQueue, in grid cells */
+struct FPathRequest
+{
+    int32 StartX = 0;
+    int32 StartY = 0;
+    int32 GoalX = 0;
+    int32 GoalY = 0;
+
+    /// a new request of the same agent supersedes the pending one, INDEX_NONE never supersedes
+    int32 AgentId = INDEX_NONE;
+
+    /// only the solvers without persistent state run on workers, the others and grids with cell costs use A*
+    ESolverMode SolverMode = ESolverMode::AStar;
+    EOpenListType OpenListType = EOpenListType::BinaryHeap;
+
+    /// string pulls the cell paths of A* and JPS, on grids without cell costs
+    bool bSmoothPath = false;
+
+    /// set when the caller already knows start and goal are not connected, the request completes without a search
+    bool bIsKnownUnreachable = false;
+
+    /// fills ExploredNodes of the result, for debug displays, A* records nothing without it
+    bool bCaptureExploredNodes = false;
+};
+
+struct FPathRequestResult
+{
+    FPathRequestHandle Handle;
+    int32 AgentId = INDEX_NONE;
+    bool bFoundPath = false;
+
+    /// cancelled or superseded before its result was delivered, Path and ExploredNodes are empty
+    bool bWasCancelled = false;
+
+    TArray<FVector> Path;
+
+    /// only filled for requests with bCaptureExploredNodes
+    TArray<FVector> ExploredNodes;
+
+    /// work done by the search, empty for results given with SubmitResult
+    FPathQueryMetrics Metrics;
+};
+
+/**
+ * Runs path queries on the task system and hands their results back to the game thread.
+ * - Submit only records the request and launches a task, its cost does not depend on the grid size.
+ *   A request known to be unreachable or given its result with SubmitResult completes at the next
+ *   DeliverCompletedRequests without a task.
+ * - Workers search a snapshot of the grid, copied once per grid revision by the first worker that needs it.
+ *   Writes to the grid must hold GetGridLock() for writing, then call MarkGridChanged.
+ * - Every callback runs exactly once, on the game thread, from DeliverCompletedRequests or CancelAll.
+ * Submit, Cancel and DeliverCompletedRequests must all be called from the same thread.
+ */
+class ASTARPATHFINDING_API FPathRequestQueue
+{
+public:
+    using FOnPathRequestCompleted = TFunction<void(FPathRequestResult& Result)>;
+
+    //////// CONSTRUCTOR ////////
+    FPathRequestQueue();
+    ~FPathRequestQueue();
+
+    //////// METHODS ////////
+    /// Grid methods
+    void SetGrid(const FWalkabilityGrid* InGrid, float InCellSize);
+    FRWLock& GetGridLock();
+    void MarkGridChanged();
+
+    /// Request methods
+    FPathRequestHandle Submit(const FPathRequest& Request, FOnPathRequestCompleted&& OnCompleted);
+    /// Completes the request with a result the caller already has, at the next DeliverCompletedRequests
+    FPathRequestHandle SubmitResult(const FPathRequest& Request, bool bFoundPath, TArray<FVector>&& Path,
+        FOnPathRequestCompleted&& OnCompleted);
+    bool Cancel(FPathRequestHandle Handle);
+    bool IsPending(FPathRequestHandle Handle) const;
+    int32 GetNumPending() const;
+
+    /// Calls the callbacks of the requests completed or cancelled since the last call
+    void DeliverCompletedRequests();
+
+    /// Cancels every request, waits for the running searches and calls the callbacks, with bWasCancelled set.
+    /// The grid can then be released, requests submitted by those callbacks run on the grid set at that time.
+    void CancelAll();
+
+private:
+    //////// STRUCTS ////////
+    struct FSharedState;
+    struct FRequestState;
+
+    struct FPendingRequest
+    {
+        TSharedRef<FRequestState> State;
+        FOnPathRequestCompleted OnCompleted;
+        int32 AgentId;
+    };
+
+    struct FCancelledRequest
+    {
+        FPathRequestResult Result;
+        FOnPathRequestCompleted OnCompleted;
+    };
+
+    //////// FIELDS ////////
+    /// state shared with the running tasks, outlives the queue until the last task ends
+    TSharedRef<FSharedState> SharedState;
+
+    TMap<int32, FPendingRequest> PendingRequests;
+    TMap<int32, int32> PendingRequestByAgent;
+    TArray<FCancelledRequest> CancelledRequests;
+    TArray<UE::Tasks::FTask> RunningTasks;
+    int32 NextRequestId = 1;
+
+    //////// METHODS ////////
+    int32 AddPendingRequest(int32 AgentId, const TSharedRef<FRequestState>& RequestState,
+        FOnPathRequestCompleted&& OnCompleted);
+    static void RunRequest(FSharedState& State, FRequestState& RequestState, const FPathRequest& Request, int32 RequestId);
+    void CancelPendingRequest(int32 RequestId);
+};
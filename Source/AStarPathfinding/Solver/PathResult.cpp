@@ -0,0 +1,138 @@
+#include "PathResult.h"
+
+void FPathResult::Reset(int32 InGridSizeX, int32 InGridSizeY)
+{
+    GridSizeX = InGridSizeX;
+    GridSizeY = InGridSizeY;
+    PathCells.Reset();
+    ExploredCells.Reset();
+
+    if (ExploredCapture == EExploredCapture::Bitset)
+    {
+        ExploredMask.Init(false, GridSizeX * GridSizeY);
+    }
+    else
+    {
+        ExploredMask.Reset();
+    }
+}
+
+int32 FPathResult::GetNumExplored() const
+{
+    switch (ExploredCapture)
+    {
+    case EExploredCapture::Indices:
+        return ExploredCells.Num();
+    case EExploredCapture::Bitset:
+        return ExploredMask.CountSetBits();
+    default:
+        return 0;
+    }
+}
+
+void FPathResult::GetWaypointCells(TArray<int32>& OutCells) const
+{
+    OutCells.Reset();
+    if (PathCells.Num() == 0)
+    {
+        return;
+    }
+
+    OutCells.Add(PathCells[0]);
+    for (int32 i = 1; i < PathCells.Num() - 1; ++i)
+    {
+        // Moves are compared as cell deltas, a cell is kept when the move leaving it differs from the one entering it
+        const int32 Previous = PathCells[i - 1];
+        const int32 Current = PathCells[i];
+        const int32 Next = PathCells[i + 1];
+        const int32 InX = Current % GridSizeX - Previous % GridSizeX;
+        const int32 InY = Current / GridSizeX - Previous / GridSizeX;
+        const int32 OutX = Next % GridSizeX - Current % GridSizeX;
+        const int32 OutY = Next / GridSizeX - Current / GridSizeX;
+        if (InX != OutX || InY != OutY)
+        {
+            OutCells.Add(Current);
+        }
+    }
+
+    if (PathCells.Num() > 1)
+    {
+        OutCells.Add(PathCells.Last());
+    }
+}
+
+void FPathResult::GetWorldPath(float CellSize, TArray<FVector>& OutPath, bool bWaypointsOnly) const
+{
+    TArray<int32> WaypointCells;
+    if (bWaypointsOnly)
+    {
+        GetWaypointCells(WaypointCells);
+    }
+
+    const TArray<int32>& Cells = bWaypointsOnly ? WaypointCells : PathCells;
+    OutPath.Reset(Cells.Num());
+    for (const int32 Index : Cells)
+    {
+        OutPath.Add(FVector((Index % GridSizeX + 0.5f) * CellSize, (Index / GridSizeX + 0.5f) * CellSize, 0.0f));
+    }
+}
+
+void FPathResult::GetWorldExploredNodes(float CellSize, TArray<FVector>& OutExploredNodes) const
+{
+    OutExploredNodes.Reset(ExploredCapture == EExploredCapture::Indices ? ExploredCells.Num() : 0);
+    ForEachExploredCell([this, CellSize, &OutExploredNodes](int32 Index)
+    {
+        OutExploredNodes.Add(FVector((Index % GridSizeX + 0.5f) * CellSize, (Index / GridSizeX + 0.5f) * CellSize,
+            0.0f));
+    });
+}
+
+void FPathResult::SetPathFromWorldPositions(const TArray<FVector>& Path, float CellSize)
+{
+    const float InvCellSize = 1.0f / CellSize;
+    int32 Index;
+    PathCells.Reset(Path.Num());
+    for (const FVector& Position : Path)
+    {
+        if (GetCellFromWorldPosition(Position, InvCellSize, Index))
+        {
+            PathCells.Add(Index);
+        }
+    }
+}
+
+void FPathResult::AddExploredFromWorldPositions(const TArray<FVector>& ExploredNodes, float CellSize)
+{
+    if (ExploredCapture == EExploredCapture::None)
+    {
+        return;
+    }
+
+    const float InvCellSize = 1.0f / CellSize;
+    int32 Index;
+    for (const FVector& Position : ExploredNodes)
+    {
+        if (GetCellFromWorldPosition(Position, InvCellSize, Index))
+        {
+            AddExplored(Index);
+        }
+    }
+}
+
+SIZE_T FPathResult::GetAllocatedSize() const
+{
+    return PathCells.GetAllocatedSize() + ExploredCells.GetAllocatedSize() + ExploredMask.GetAllocatedSize();
+}
+
+bool FPathResult::GetCellFromWorldPosition(const FVector& Position, float InvCellSize, int32& OutIndex) const
+{
+    const int32 X = FMath::FloorToInt(Position.X * InvCellSize);
+    const int32 Y = FMath::FloorToInt(Position.Y * InvCellSize);
+    if (static_cast<uint32>(X) >= static_cast<uint32>(GridSizeX)
+        || static_cast<uint32>(Y) >= static_cast<uint32>(GridSizeY))
+    {
+        return false;
+    }
+    OutIndex = Y * GridSizeX + X;
+    return true;
+}
@@ -0,0 +1,91 @@
+// PathResult.h
+#pragma once
+
+#include "AStarPathfinding/PathfindingCore.h"
+
+/** Explored cells recorded by a query, only debug displays read them */
+enum class EExploredCapture : uint8
+{
+    None,
+    /// one index per expanded cell, in expansion order
+    Indices,
+    /// one bit per grid cell, bounded by the grid size however long the search runs
+    Bitset
+};
+
+/**
+ * Path of a query as cell indices (Y * GridSizeX + X), world positions are only built when asked for.
+ * Explored cells are recorded as set by ExploredCapture before the query, nothing is recorded by default.
+ * Buffers are kept across queries, a result reused by its caller stops allocating once grown to fit the grid.
+ */
+struct ASTARPATHFINDING_API FPathResult
+{
+    //////// FIELDS ////////
+    /// cells from start to goal, empty when no path was found
+    TArray<int32> PathCells;
+
+    EExploredCapture ExploredCapture = EExploredCapture::None;
+    TArray<int32> ExploredCells;
+    TBitArray<> ExploredMask;
+
+    int32 GridSizeX = 0;
+    int32 GridSizeY = 0;
+
+    //////// METHODS ////////
+    /// Clears the previous query, the capture mode and the allocations are kept
+    void Reset(int32 InGridSizeX, int32 InGridSizeY);
+
+    bool HasPath() const { return PathCells.Num() > 0; }
+    int32 GetNumExplored() const;
+
+    FORCEINLINE void AddExplored(int32 Index)
+    {
+        if (ExploredCapture == EExploredCapture::Indices)
+        {
+            ExploredCells.Add(Index);
+        }
+        else if (ExploredCapture == EExploredCapture::Bitset)
+        {
+            ExploredMask[Index] = true;
+        }
+    }
+
+    /// Start, goal and the cells where the path changes direction, the straight runs between them are dropped
+    void GetWaypointCells(TArray<int32>& OutCells) const;
+
+    /// Cell centers of the path, or of its waypoints only, relative to the grid origin like the solver outputs
+    void GetWorldPath(float CellSize, TArray<FVector>& OutPath, bool bWaypointsOnly = false) const;
+
+    /// Cell centers of the explored cells, empty when they were not captured
+    void GetWorldExploredNodes(float CellSize, TArray<FVector>& OutExploredNodes) const;
+
+    /// Calls Func with every explored cell, in expansion order when captured as indices
+    template <typename FuncType>
+    void ForEachExploredCell(FuncType&& Func) const
+    {
+        if (ExploredCapture == EExploredCapture::Indices)
+        {
+            for (const int32 Index : ExploredCells)
+            {
+                Func(Index);
+            }
+        }
+        else if (ExploredCapture == EExploredCapture::Bitset)
+        {
+            for (TConstSetBitIterator<> It(ExploredMask); It; ++It)
+            {
+                Func(It.GetIndex());
+            }
+        }
+    }
+
+    /// Replace the path or add explored cells from the world positions of the solvers without a cell output,
+    /// positions off the grid are dropped
+    void SetPathFromWorldPositions(const TArray<FVector>& Path, float CellSize);
+    void AddExploredFromWorldPositions(const TArray<FVector>& ExploredNodes, float CellSize);
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    bool GetCellFromWorldPosition(const FVector& Position, float InvCellSize, int32& OutIndex) const;
+};
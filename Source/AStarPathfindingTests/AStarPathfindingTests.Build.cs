@@ -0,0 +1,11 @@
+using UnrealBuildTool;
+
+public class AStarPathfindingTests : ModuleRules
+{
+	public AStarPathfindingTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "AStarPathfinding" });
+	}
+}
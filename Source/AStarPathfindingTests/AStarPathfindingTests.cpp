@@ -0,0 +1,5 @@
+#include "Modules/ModuleManager.h"
+
+// Automation tests of the grid and the solvers, run from the Session Frontend or headless:
+//   UnrealEditor-Cmd AStarPathfinding.uproject -ExecCmds="Automation RunTests AStarPathfinding; Quit" -unattended -nullrhi
+IMPLEMENT_MODULE(FDefaultModuleImpl, AStarPathfindingTests);
@@ -0,0 +1,97 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "AStarPathfinding/Grid/GridFile.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridFileImportPgmTest,
+	"AStarPathfinding.Grid.GridFile.ImportPgmRejectsTruncatedFiles",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGridFileImportPgmTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ImportPgmTest.pgm"));
+
+	// Headers announcing more pixels than the grid or the file can hold must fail before allocating the levels
+	const TCHAR* const InvalidFiles[] = {
+		TEXT("P2 1048576 1048576 255\n0 255"),
+		TEXT("P2 16384 16384 255\n0"),
+		TEXT("P2 8192 8192 255\n0 255 0 255"),
+		TEXT("P2 3 2 255\n0 255 0 255 0"),
+		TEXT("P5 8192 8192 255\n\x01"),
+	};
+	for (const TCHAR* const Contents : InvalidFiles)
+	{
+		FWalkabilityGrid Grid;
+		TestTrue(TEXT("write file"), FFileHelper::SaveStringToFile(Contents, *FilePath));
+		TestFalse(*FString::Printf(TEXT("import %s"), Contents), GridFile::ImportImage(FilePath, Grid));
+	}
+
+	FWalkabilityGrid Grid;
+	TestTrue(TEXT("write file"), FFileHelper::SaveStringToFile(TEXT("P2\n# comment\n3 2\n255\n0 255 0\n255 0 255\n"),
+		*FilePath));
+	if (TestTrue(TEXT("import valid file"), GridFile::ImportImage(FilePath, Grid)))
+	{
+		TestEqual(TEXT("size X"), Grid.GetSizeX(), 3);
+		TestEqual(TEXT("size Y"), Grid.GetSizeY(), 2);
+		TestFalse(TEXT("cell 0, 0"), Grid.IsCrossable(0, 0));
+		TestTrue(TEXT("cell 1, 0"), Grid.IsCrossable(1, 0));
+		TestTrue(TEXT("cell 0, 1"), Grid.IsCrossable(0, 1));
+		TestFalse(TEXT("cell 1, 1"), Grid.IsCrossable(1, 1));
+	}
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridFileRoundTripTest,
+	"AStarPathfinding.Grid.GridFile.SaveLoadKeepsWallsAndCosts",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGridFileRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("RoundTripTest.grid"));
+
+	FRandomStream Random(15);
+	for (const bool bHasCosts : { false, true })
+	{
+		const int32 GridSizeX = Random.RandRange(1, 300);
+		const int32 GridSizeY = Random.RandRange(1, 300);
+		FWalkabilityGrid Grid;
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, 20, Grid);
+		for (int32 Edit = 0; bHasCosts && Edit < 200; ++Edit)
+		{
+			Grid.SetCellCost(Random.RandRange(0, GridSizeX - 1), Random.RandRange(0, GridSizeY - 1),
+				static_cast<uint8>(Random.RandRange(1, MAX_uint8)));
+		}
+
+		FWalkabilityGrid LoadedGrid;
+		TestTrue(TEXT("save"), GridFile::Save(FilePath, Grid));
+		if (!TestTrue(TEXT("load"), GridFile::Load(FilePath, LoadedGrid)))
+		{
+			continue;
+		}
+
+		bool bSameCells = LoadedGrid.GetSizeX() == GridSizeX && LoadedGrid.GetSizeY() == GridSizeY
+			&& LoadedGrid.HasUniformCosts() == Grid.HasUniformCosts()
+			&& LoadedGrid.GetMinCellCost() == Grid.GetMinCellCost();
+		for (int32 Y = 0; Y < GridSizeY && bSameCells; ++Y)
+		{
+			for (int32 X = 0; X < GridSizeX && bSameCells; ++X)
+			{
+				bSameCells = LoadedGrid.IsCrossable(X, Y) == Grid.IsCrossable(X, Y)
+					&& LoadedGrid.GetCellCost(X, Y) == Grid.GetCellCost(X, Y);
+			}
+		}
+		TestTrue(*FString::Printf(TEXT("same cells, %s"), bHasCosts ? TEXT("with costs") : TEXT("uniform costs")),
+			bSameCells);
+	}
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWalkabilityGridCostTilesTest,
+	"AStarPathfinding.Grid.WalkabilityGrid.CostTilesMatchFlatCosts",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWalkabilityGridCostTilesTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 12;
+	constexpr int32 NumEdits = 600;
+
+	FRandomStream Random(15);
+	FWalkabilityGrid Grid;
+	TArray<uint8> ReferenceCosts;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(1, 200);
+		const int32 GridSizeY = Random.RandRange(1, 200);
+		Grid.Init(GridSizeX, GridSizeY);
+		const SIZE_T UniformSize = Grid.GetAllocatedSize();
+		ReferenceCosts.Init(FWalkabilityGrid::DEFAULT_CELL_COST, GridSizeX * GridSizeY);
+
+		// Edits cluster in a few cells so tiles often go back to the default cost and get released
+		const int32 EditSizeX = Random.RandRange(1, GridSizeX);
+		const int32 EditSizeY = Random.RandRange(1, GridSizeY);
+		for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+		{
+			const int32 X = Random.RandRange(0, EditSizeX - 1);
+			const int32 Y = Random.RandRange(0, EditSizeY - 1);
+			const uint8 Cost = Random.RandRange(0, 1) == 1 ? FWalkabilityGrid::DEFAULT_CELL_COST
+				: static_cast<uint8>(Random.RandRange(1, MAX_uint8));
+			Grid.SetCellCost(X, Y, Cost);
+			ReferenceCosts[Y * GridSizeX + X] = Cost;
+		}
+
+		bool bSameCosts = true;
+		uint8 MinCellCost = MAX_uint8;
+		for (int32 Y = 0; Y < GridSizeY; ++Y)
+		{
+			for (int32 X = 0; X < GridSizeX; ++X)
+			{
+				bSameCosts &= Grid.GetCellCost(X, Y) == ReferenceCosts[Y * GridSizeX + X];
+				MinCellCost = FMath::Min(MinCellCost, ReferenceCosts[Y * GridSizeX + X]);
+			}
+		}
+		TestTrue(*FString::Printf(TEXT("costs, grid %d"), GridIndex), bSameCosts);
+		TestEqual(*FString::Printf(TEXT("min cost, grid %d"), GridIndex), Grid.GetMinCellCost(), MinCellCost);
+
+		// Painting every edited cell back to the default cost releases the layer
+		for (int32 Y = 0; Y < EditSizeY; ++Y)
+		{
+			for (int32 X = 0; X < EditSizeX; ++X)
+			{
+				Grid.SetCellCost(X, Y, FWalkabilityGrid::DEFAULT_CELL_COST);
+			}
+		}
+		TestTrue(*FString::Printf(TEXT("uniform costs, grid %d"), GridIndex), Grid.HasUniformCosts());
+		TestEqual(*FString::Printf(TEXT("released layer, grid %d"), GridIndex),
+			static_cast<int64>(Grid.GetAllocatedSize()), static_cast<int64>(UniformSize));
+	}
+
+	// A single expensive cell on a large grid only owns the tile holding it
+	Grid.Init(4096, 4096);
+	Grid.SetCellCost(1000, 3000, 9);
+	TestEqual(TEXT("cost tiles"), Grid.GetCostTiles().Num(), 2 * FWalkabilityGrid::NUM_TILE_CELLS);
+	TestEqual(TEXT("single cost"), Grid.GetCellCost(1000, 3000), static_cast<uint8>(9));
+	TestEqual(TEXT("neighbor cost"), Grid.GetCellCost(1001, 3000), FWalkabilityGrid::DEFAULT_CELL_COST);
+	TestEqual(TEXT("other tile cost"), Grid.GetCellCost(0, 0), FWalkabilityGrid::DEFAULT_CELL_COST);
+	return true;
+}
+
+#endif
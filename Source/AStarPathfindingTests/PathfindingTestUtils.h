@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+
+/** Helpers shared by the automation tests, every random input comes from a seeded stream so failures replay */
+namespace PathfindingTestUtils
+{
+	/** Blocks about WallPercent percent of the cells, picked at random */
+	inline void MakeRandomGrid(FRandomStream& Random, int32 GridSizeX, int32 GridSizeY, int32 WallPercent,
+		FWalkabilityGrid& OutGrid)
+	{
+		OutGrid.Init(GridSizeX, GridSizeY);
+		for (int32 Y = 0; Y < GridSizeY; ++Y)
+		{
+			for (int32 X = 0; X < GridSizeX; ++X)
+			{
+				if (Random.RandRange(0, 99) < WallPercent)
+				{
+					OutGrid.SetCrossable(X, Y, false);
+				}
+			}
+		}
+	}
+
+	/** A random crossable cell, false when none was found after a few tries */
+	inline bool PickCrossableCell(FRandomStream& Random, const FWalkabilityGrid& Grid, int32& OutX, int32& OutY)
+	{
+		for (int32 Try = 0; Try < 64; ++Try)
+		{
+			OutX = Random.RandRange(0, Grid.GetSizeX() - 1);
+			OutY = Random.RandRange(0, Grid.GetSizeY() - 1);
+			if (Grid.IsCrossable(OutX, OutY))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Cell holding a point of a solver path, paths are relative to the grid origin */
+	inline FIntPoint GetPathCell(const FVector& Point, float CellSize)
+	{
+		return FIntPoint(FMath::FloorToInt(Point.X / CellSize), FMath::FloorToInt(Point.Y / CellSize));
+	}
+
+	/**
+	 * Cost of a path through neighbor cells with the moves of PathFinder, each move priced by the cell it enters.
+	 * INDEX_NONE when two points are not neighbors or a cell after the first is blocked.
+	 */
+	inline int64 GetCellPathCost(const FWalkabilityGrid& Grid, const TArray<FVector>& Path, float CellSize)
+	{
+		int64 Cost = 0;
+		for (int32 PathIndex = 1; PathIndex < Path.Num(); ++PathIndex)
+		{
+			const FIntPoint From = GetPathCell(Path[PathIndex - 1], CellSize);
+			const FIntPoint To = GetPathCell(Path[PathIndex], CellSize);
+			const int32 DeltaX = FMath::Abs(To.X - From.X);
+			const int32 DeltaY = FMath::Abs(To.Y - From.Y);
+			if (DeltaX > 1 || DeltaY > 1 || DeltaX + DeltaY == 0 || !Grid.IsCrossable(To.X, To.Y))
+			{
+				return INDEX_NONE;
+			}
+
+			const int32 MovementCost = DeltaX + DeltaY == 2 ? PathFinder::DIAGONAL_COST : PathFinder::STRAIGHT_COST;
+			Cost += MovementCost * Grid.GetCellCost(To.X, To.Y);
+		}
+		return Cost;
+	}
+
+	/** Whether a path runs from the start cell to the goal cell */
+	inline bool ConnectsCells(const TArray<FVector>& Path, float CellSize, int32 StartX, int32 StartY, int32 GoalX,
+		int32 GoalY)
+	{
+		return Path.Num() > 0 && GetPathCell(Path[0], CellSize) == FIntPoint(StartX, StartY)
+			&& GetPathCell(Path.Last(), CellSize) == FIntPoint(GoalX, GoalY);
+	}
+}
@@ -0,0 +1,127 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/AnyAnglePathFinder.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * Whether every point sampled along each segment of a path lies in a crossable cell, independently from
+	 * HasLineOfSight. Points close to a cell corner are skipped, segments may pass exactly between two walls there.
+	 */
+	bool IsPathInSight(const FWalkabilityGrid& Grid, const TArray<FVector>& Path)
+	{
+		constexpr double SAMPLE_STEP = 0.01;
+		constexpr double CORNER_TOLERANCE = 1e-3;
+
+		for (int32 PathIndex = 1; PathIndex < Path.Num(); ++PathIndex)
+		{
+			const FVector From = Path[PathIndex - 1];
+			const FVector To = Path[PathIndex];
+			const int32 NumSamples = FMath::CeilToInt(FVector::Dist(From, To) / SAMPLE_STEP);
+			for (int32 Sample = 0; Sample <= NumSamples; ++Sample)
+			{
+				const FVector Point = FMath::Lerp(From, To, static_cast<double>(Sample) / NumSamples);
+				if (FMath::Abs(Point.X - FMath::RoundToDouble(Point.X)) < CORNER_TOLERANCE
+					&& FMath::Abs(Point.Y - FMath::RoundToDouble(Point.Y)) < CORNER_TOLERANCE)
+				{
+					continue;
+				}
+
+				const FIntPoint Cell = PathfindingTestUtils::GetPathCell(Point, 1.0f);
+				if (!Grid.IsCrossable(Cell.X, Cell.Y))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	double GetPathLength(const TArray<FVector>& Path)
+	{
+		double Length = 0.0;
+		for (int32 PathIndex = 1; PathIndex < Path.Num(); ++PathIndex)
+		{
+			Length += FVector::Dist(Path[PathIndex - 1], Path[PathIndex]);
+		}
+		return Length;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAnyAnglePathFinderSightTest,
+	"AStarPathfinding.Solver.AnyAnglePathFinder.PathsStayInSight",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAnyAnglePathFinderSightTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 40;
+	constexpr int32 NumQueries = 30;
+	constexpr double LENGTH_TOLERANCE = 1e-3;
+
+	FRandomStream Random(16);
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	TArray<FVector> ReferencePath, Path, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(4, 48);
+		const int32 GridSizeY = Random.RandRange(4, 48);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 40), Grid);
+
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			int32 StartX, StartY, GoalX, GoalY;
+			if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, StartX, StartY)
+				|| !PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+			{
+				continue;
+			}
+
+			const bool bReferenceFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX,
+				GoalY, 1.0f, ReferencePath, ExploredNodes);
+			const FString Query = FString::Printf(TEXT("grid %d (%d, %d) to (%d, %d)"), GridIndex, StartX, StartY,
+				GoalX, GoalY);
+
+			// String pulling the grid path keeps it in sight and never makes it longer
+			if (bReferenceFound)
+			{
+				const double ReferenceLength = GetPathLength(ReferencePath);
+				AnyAnglePathFinder::SmoothPath(Grid, 1.0f, ReferencePath);
+				TestTrue(*FString::Printf(TEXT("smoothed path in sight, %s"), *Query), IsPathInSight(Grid, ReferencePath));
+				TestTrue(*FString::Printf(TEXT("smoothed path length, %s"), *Query),
+					GetPathLength(ReferencePath) <= ReferenceLength + LENGTH_TOLERANCE);
+			}
+
+			for (const bool bIsLazy : { false, true })
+			{
+				const bool bFound = AnyAnglePathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY,
+					GoalX, GoalY, 1.0f, Path, ExploredNodes, bIsLazy);
+				const FString Solver = bIsLazy ? TEXT("Lazy Theta*") : TEXT("Theta*");
+
+				TestEqual(*FString::Printf(TEXT("found, %s, %s"), *Solver, *Query), bFound, bReferenceFound);
+				if (!bFound || !bReferenceFound)
+				{
+					continue;
+				}
+
+				TestTrue(*FString::Printf(TEXT("path ends, %s, %s"), *Solver, *Query),
+					PathfindingTestUtils::ConnectsCells(Path, 1.0f, StartX, StartY, GoalX, GoalY));
+				TestTrue(*FString::Printf(TEXT("path in sight, %s, %s"), *Solver, *Query), IsPathInSight(Grid, Path));
+				for (int32 PathIndex = 1; PathIndex < Path.Num(); ++PathIndex)
+				{
+					const FIntPoint From = PathfindingTestUtils::GetPathCell(Path[PathIndex - 1], 1.0f);
+					const FIntPoint To = PathfindingTestUtils::GetPathCell(Path[PathIndex], 1.0f);
+					TestTrue(*FString::Printf(TEXT("line of sight of waypoint %d, %s, %s"), PathIndex, *Solver, *Query),
+						AnyAnglePathFinder::HasLineOfSight(Grid, From.X, From.Y, To.X, To.Y));
+				}
+			}
+		}
+	}
+	return true;
+}
+
+#endif
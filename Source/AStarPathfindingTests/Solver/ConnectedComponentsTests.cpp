@@ -0,0 +1,82 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/ConnectedComponents.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConnectedComponentsUpdateTest,
+	"AStarPathfinding.Solver.ConnectedComponents.UpdateMatchesBuild",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FConnectedComponentsUpdateTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 40;
+	constexpr int32 NumToggles = 40;
+	constexpr int32 NumQueries = 8;
+
+	FRandomStream Random(14);
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	FConnectedComponents Components, ReferenceComponents;
+	TMap<int32, int32> ReferenceToUpdated, UpdatedToReference;
+	TArray<FVector> Path, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(2, 40);
+		const int32 GridSizeY = Random.RandRange(2, 40);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(10, 60), Grid);
+		Components.Build(Grid, GridSizeX, GridSizeY);
+
+		for (int32 Toggle = 0; Toggle < NumToggles; ++Toggle)
+		{
+			const int32 ToggledX = Random.RandRange(0, GridSizeX - 1);
+			const int32 ToggledY = Random.RandRange(0, GridSizeY - 1);
+			Grid.SetCrossable(ToggledX, ToggledY, !Grid.IsCrossable(ToggledX, ToggledY));
+			Components.UpdateCell(Grid, ToggledX, ToggledY);
+			ReferenceComponents.Build(Grid, GridSizeX, GridSizeY);
+
+			// Labels differ between the two, the partitions of the cells they describe must not
+			ReferenceToUpdated.Reset();
+			UpdatedToReference.Reset();
+			bool bSamePartition = true;
+			for (int32 Y = 0; Y < GridSizeY && bSamePartition; ++Y)
+			{
+				for (int32 X = 0; X < GridSizeX && bSamePartition; ++X)
+				{
+					const int32 Component = Components.GetComponent(X, Y);
+					const int32 ReferenceComponent = ReferenceComponents.GetComponent(X, Y);
+					if (Component == INDEX_NONE || ReferenceComponent == INDEX_NONE)
+					{
+						bSamePartition = Component == ReferenceComponent;
+						continue;
+					}
+					bSamePartition = ReferenceToUpdated.FindOrAdd(ReferenceComponent, Component) == Component
+						&& UpdatedToReference.FindOrAdd(Component, ReferenceComponent) == ReferenceComponent;
+				}
+			}
+			TestTrue(*FString::Printf(TEXT("components, grid %d toggle %d of (%d, %d)"), GridIndex, Toggle, ToggledX,
+				ToggledY), bSamePartition);
+		}
+
+		// A blocked start may still leave through its neighbors, AreConnected must agree with a search on every cell
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			const int32 StartX = Random.RandRange(0, GridSizeX - 1);
+			const int32 StartY = Random.RandRange(0, GridSizeY - 1);
+			int32 GoalX, GoalY;
+			if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+			{
+				continue;
+			}
+			const bool bFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX, GoalY,
+				1.0f, Path, ExploredNodes);
+			TestEqual(*FString::Printf(TEXT("connected, grid %d (%d, %d) to (%d, %d)"), GridIndex, StartX, StartY,
+				GoalX, GoalY), Components.AreConnected(StartX, StartY, GoalX, GoalY), bFound);
+		}
+	}
+	return true;
+}
+
+#endif
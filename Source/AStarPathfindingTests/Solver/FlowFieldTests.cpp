@@ -0,0 +1,98 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/FlowField.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowFieldCostTest, "AStarPathfinding.Solver.FlowField.CostsMatchAStar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowFieldCostTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 20;
+	constexpr int32 NumRounds = 6;
+
+	FRandomStream Random(11);
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	FFlowField FlowField;
+	TArray<int32> Cells;
+	TArray<FVector> Path, ReferencePath, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(4, 24);
+		const int32 GridSizeY = Random.RandRange(4, 24);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 35), Grid);
+
+		int32 GoalX, GoalY;
+		if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+		{
+			continue;
+		}
+		FlowField.Build(Grid, GridSizeX, GridSizeY, GoalX, GoalY);
+
+		// Every round checks the fields repaired by the edits of the previous rounds against A* from every cell
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			for (int32 StartY = 0; StartY < GridSizeY; ++StartY)
+			{
+				for (int32 StartX = 0; StartX < GridSizeX; ++StartX)
+				{
+					if (!Grid.IsCrossable(StartX, StartY))
+					{
+						continue;
+					}
+
+					const int32 Index = StartY * GridSizeX + StartX;
+					const bool bReferenceFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY,
+						GoalX, GoalY, 1.0f, ReferencePath, ExploredNodes);
+					const FString Query = FString::Printf(TEXT("grid %d round %d (%d, %d) to (%d, %d)"), GridIndex,
+						Round, StartX, StartY, GoalX, GoalY);
+
+					TestEqual(*FString::Printf(TEXT("reached, %s"), *Query), FlowField.GetCost(Index) != FFlowField::UNREACHED,
+						bReferenceFound);
+					if (!bReferenceFound)
+					{
+						continue;
+					}
+					TestEqual(*FString::Printf(TEXT("cost, %s"), *Query), static_cast<int64>(FlowField.GetCost(Index)),
+						PathfindingTestUtils::GetCellPathCost(Grid, ReferencePath, 1.0f));
+
+					// Following the flow walks a path of that cost
+					if (!TestTrue(*FString::Printf(TEXT("traced, %s"), *Query),
+						FlowField.TracePath(StartX, StartY, Cells)))
+					{
+						continue;
+					}
+					Path.Reset();
+					for (const int32 Cell : Cells)
+					{
+						Path.Add(FVector(Cell % GridSizeX + 0.5f, Cell / GridSizeX + 0.5f, 0.0f));
+					}
+					TestTrue(*FString::Printf(TEXT("path ends, %s"), *Query),
+						PathfindingTestUtils::ConnectsCells(Path, 1.0f, StartX, StartY, GoalX, GoalY));
+					TestEqual(*FString::Printf(TEXT("traced cost, %s"), *Query),
+						PathfindingTestUtils::GetCellPathCost(Grid, Path, 1.0f), static_cast<int64>(FlowField.GetCost(Index)));
+				}
+			}
+
+			// Walls come and go anywhere but on the goal
+			const int32 NumEdits = Random.RandRange(1, 8);
+			for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+			{
+				const int32 X = Random.RandRange(0, GridSizeX - 1);
+				const int32 Y = Random.RandRange(0, GridSizeY - 1);
+				if (X != GoalX || Y != GoalY)
+				{
+					Grid.SetCrossable(X, Y, !Grid.IsCrossable(X, Y));
+					FlowField.UpdateCell(Grid, X, Y);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/HierarchicalGraph.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Centers of the cells, in the layout of the solver paths with a cell size of 1 */
+	void GetCellCenters(const TArray<int32>& Cells, int32 GridSizeX, TArray<FVector>& OutPath)
+	{
+		OutPath.Reset();
+		for (const int32 Cell : Cells)
+		{
+			OutPath.Add(FVector(Cell % GridSizeX + 0.5f, Cell / GridSizeX + 0.5f, 0.0f));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHierarchicalGraphPathTest, "AStarPathfinding.Solver.HierarchicalGraph.PathsMatchAStar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHierarchicalGraphPathTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 30;
+	constexpr int32 NumRounds = 6;
+	constexpr int32 NumQueries = 8;
+
+	FRandomStream Random(29);
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	FHierarchicalGraph HierarchicalGraph;
+	FHierarchicalPath AbstractPath;
+	TArray<int32> Cells;
+	TArray<FVector> Path, ReferencePath, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(4, 60);
+		const int32 GridSizeY = Random.RandRange(4, 60);
+		const int32 ClusterSize = Random.RandRange(3, 16);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 40), Grid);
+		HierarchicalGraph.Build(Grid, GridSizeX, GridSizeY, ClusterSize);
+
+		// Every round queries the graph patched by the edits of the previous rounds, never rebuilt from scratch
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+			{
+				int32 StartX, StartY, GoalX, GoalY;
+				if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, StartX, StartY)
+					|| !PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+				{
+					continue;
+				}
+
+				const bool bFound = HierarchicalGraph.FindAbstractPath(Grid, StartX, StartY, GoalX, GoalY, AbstractPath);
+				const bool bReferenceFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY,
+					GoalX, GoalY, 1.0f, ReferencePath, ExploredNodes);
+				const FString Query = FString::Printf(TEXT("grid %d cluster %d round %d (%d, %d) to (%d, %d)"),
+					GridIndex, ClusterSize, Round, StartX, StartY, GoalX, GoalY);
+
+				TestEqual(*FString::Printf(TEXT("found, %s"), *Query), bFound, bReferenceFound);
+				if (!bFound || !bReferenceFound)
+				{
+					continue;
+				}
+
+				// The refined cells are a walkable path whose cost is the one the abstract search returned
+				if (!TestTrue(*FString::Printf(TEXT("refined, %s"), *Query),
+					HierarchicalGraph.RefinePath(Grid, AbstractPath, Cells)))
+				{
+					continue;
+				}
+				GetCellCenters(Cells, GridSizeX, Path);
+				TestTrue(*FString::Printf(TEXT("path ends, %s"), *Query),
+					PathfindingTestUtils::ConnectsCells(Path, 1.0f, StartX, StartY, GoalX, GoalY));
+				const int64 Cost = PathfindingTestUtils::GetCellPathCost(Grid, Path, 1.0f);
+				TestEqual(*FString::Printf(TEXT("refined cost, %s"), *Query), Cost,
+					static_cast<int64>(AbstractPath.Cost));
+
+				// Close to optimal only, never shorter than A*
+				TestTrue(*FString::Printf(TEXT("no shorter than A*, %s"), *Query),
+					Cost >= PathfindingTestUtils::GetCellPathCost(Grid, ReferencePath, 1.0f));
+			}
+
+			// Walls come and go anywhere, only the clusters around them are rebuilt by the next query
+			const int32 NumEdits = Random.RandRange(1, 10);
+			for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+			{
+				const int32 X = Random.RandRange(0, GridSizeX - 1);
+				const int32 Y = Random.RandRange(0, GridSizeY - 1);
+				Grid.SetCrossable(X, Y, !Grid.IsCrossable(X, Y));
+				HierarchicalGraph.MarkCellDirty(X, Y);
+			}
+		}
+	}
+	return true;
+}
+
+#endif
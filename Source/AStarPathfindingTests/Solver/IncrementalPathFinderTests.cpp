@@ -0,0 +1,85 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/IncrementalPathFinder.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIncrementalPathFinderRepairTest,
+	"AStarPathfinding.Solver.IncrementalPathFinder.RepairMatchesFullSearch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FIncrementalPathFinderRepairTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 30;
+	constexpr int32 NumRounds = 12;
+
+	FRandomStream Random(7);
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	FIncrementalPathFinder IncrementalPathFinder;
+	TArray<FVector> ReferencePath, Path, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(4, 40);
+		const int32 GridSizeY = Random.RandRange(4, 40);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 35), Grid);
+
+		int32 StartX, StartY, GoalX, GoalY;
+		if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, StartX, StartY)
+			|| !PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+		{
+			continue;
+		}
+		IncrementalPathFinder.Initialize(GridSizeX, GridSizeY, StartX, StartY, GoalX, GoalY);
+
+		// Every round repairs the state kept from the previous one, then is checked against a search from scratch
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			const bool bFound = IncrementalPathFinder.ComputePath(Grid, 1.0f, Path, ExploredNodes);
+			const bool bReferenceFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX,
+				GoalY, 1.0f, ReferencePath, ExploredNodes);
+			const FString Query = FString::Printf(TEXT("grid %d round %d (%d, %d) to (%d, %d)"), GridIndex, Round,
+				StartX, StartY, GoalX, GoalY);
+
+			TestEqual(*FString::Printf(TEXT("found, %s"), *Query), bFound, bReferenceFound);
+			if (bFound && bReferenceFound)
+			{
+				TestTrue(*FString::Printf(TEXT("path ends, %s"), *Query),
+					PathfindingTestUtils::ConnectsCells(Path, 1.0f, StartX, StartY, GoalX, GoalY));
+				TestEqual(*FString::Printf(TEXT("cost, %s"), *Query),
+					PathfindingTestUtils::GetCellPathCost(Grid, Path, 1.0f),
+					PathfindingTestUtils::GetCellPathCost(Grid, ReferencePath, 1.0f));
+			}
+
+			// Walls come and go anywhere but on the goal, the start moves along like an agent would
+			const int32 NumEdits = Random.RandRange(1, 8);
+			for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+			{
+				const int32 X = Random.RandRange(0, GridSizeX - 1);
+				const int32 Y = Random.RandRange(0, GridSizeY - 1);
+				if ((X != GoalX || Y != GoalY) && (X != StartX || Y != StartY))
+				{
+					Grid.SetCrossable(X, Y, !Grid.IsCrossable(X, Y));
+					IncrementalPathFinder.NotifyCellChanged(X, Y);
+				}
+			}
+
+			if (bFound && Path.Num() > 2 && Random.RandRange(0, 1) == 1)
+			{
+				const FIntPoint NextStart = PathfindingTestUtils::GetPathCell(Path[Random.RandRange(1, Path.Num() - 2)],
+					1.0f);
+				if (Grid.IsCrossable(NextStart.X, NextStart.Y))
+				{
+					StartX = NextStart.X;
+					StartY = NextStart.Y;
+					IncrementalPathFinder.MoveStart(StartX, StartY);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+#endif
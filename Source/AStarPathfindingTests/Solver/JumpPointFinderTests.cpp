@@ -0,0 +1,160 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/JumpPointFinder.h"
+#include "AStarPathfinding/Solver/JumpPointTable.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJumpPointFinderCostTest, "AStarPathfinding.Solver.JumpPointFinder.SameCostsAsAStar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FJumpPointFinderCostTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 40;
+	constexpr int32 NumQueries = 50;
+
+	FRandomStream Random(5);
+	FPathFinderContext Context;
+	FJumpPointTable Table;
+	FWalkabilityGrid Grid;
+	TArray<FVector> ReferencePath, Path, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(4, 48);
+		const int32 GridSizeY = Random.RandRange(4, 48);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 40), Grid);
+		Table.Build(Grid, GridSizeX, GridSizeY);
+
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			int32 StartX, StartY, GoalX, GoalY;
+			if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, StartX, StartY)
+				|| !PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+			{
+				continue;
+			}
+
+			const bool bReferenceFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX,
+				GoalY, 1.0f, ReferencePath, ExploredNodes);
+			const int64 ReferenceCost = PathfindingTestUtils::GetCellPathCost(Grid, ReferencePath, 1.0f);
+			const FString Query = FString::Printf(TEXT("grid %d (%d, %d) to (%d, %d)"), GridIndex, StartX, StartY,
+				GoalX, GoalY);
+
+			for (const bool bUseTable : { false, true })
+			{
+				const bool bFound = bUseTable
+					? JumpPointFinder::Compute(Context, Table, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX, GoalY,
+						1.0f, Path, ExploredNodes)
+					: JumpPointFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX, GoalY, 1.0f,
+						Path, ExploredNodes);
+				const TCHAR* Solver = bUseTable ? TEXT("JPS+") : TEXT("JPS");
+
+				TestEqual(*FString::Printf(TEXT("%s found, %s"), Solver, *Query), bFound, bReferenceFound);
+				if (bFound && bReferenceFound)
+				{
+					TestTrue(*FString::Printf(TEXT("%s path ends, %s"), Solver, *Query),
+						PathfindingTestUtils::ConnectsCells(Path, 1.0f, StartX, StartY, GoalX, GoalY));
+					TestEqual(*FString::Printf(TEXT("%s cost, %s"), Solver, *Query),
+						PathfindingTestUtils::GetCellPathCost(Grid, Path, 1.0f), ReferenceCost);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJumpPointTableUpdateTest, "AStarPathfinding.Solver.JumpPointTable.UpdateMatchesBuild",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FJumpPointTableUpdateTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 40;
+	constexpr int32 NumEdits = 30;
+
+	FRandomStream Random(6);
+	FWalkabilityGrid Grid;
+	FJumpPointTable Table, ReferenceTable;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(3, 40);
+		const int32 GridSizeY = Random.RandRange(3, 40);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 40), Grid);
+		Table.Build(Grid, GridSizeX, GridSizeY);
+
+		// Each edit is patched alone, like AGridManager does
+		for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+		{
+			const int32 X = Random.RandRange(0, GridSizeX - 1);
+			const int32 Y = Random.RandRange(0, GridSizeY - 1);
+			Grid.SetCrossable(X, Y, !Grid.IsCrossable(X, Y));
+			Table.UpdateCell(Grid, X, Y);
+		}
+
+		ReferenceTable.Build(Grid, GridSizeX, GridSizeY);
+		int32 NumMismatches = 0;
+		for (int32 Index = 0; Index < GridSizeX * GridSizeY; ++Index)
+		{
+			for (int32 Direction = 0; Direction < FJumpPointTable::NUM_DIRECTIONS; ++Direction)
+			{
+				NumMismatches += Table.GetDistance(Index, Direction) != ReferenceTable.GetDistance(Index, Direction);
+			}
+		}
+		TestEqual(*FString::Printf(TEXT("grid %d: distances differing from a rebuild"), GridIndex), NumMismatches, 0);
+	}
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJumpPointTableBatchedUpdateTest, "AStarPathfinding.Solver.JumpPointTable.BatchedUpdateMatchesBuild",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FJumpPointTableBatchedUpdateTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 40;
+	constexpr int32 NumBatches = 6;
+
+	FRandomStream Random(9);
+	FWalkabilityGrid Grid;
+	FJumpPointTable Table, ReferenceTable;
+	TArray<FIntPoint> EditedCells;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(3, 40);
+		const int32 GridSizeY = Random.RandRange(3, 40);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 40), Grid);
+		Table.Build(Grid, GridSizeX, GridSizeY);
+
+		// A committed grid edit writes every cell first and patches them afterwards, against the final grid
+		for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+		{
+			EditedCells.Reset();
+			const int32 NumEdits = Random.RandRange(1, 12);
+			for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+			{
+				const FIntPoint Cell(Random.RandRange(0, GridSizeX - 1), Random.RandRange(0, GridSizeY - 1));
+				Grid.SetCrossable(Cell.X, Cell.Y, !Grid.IsCrossable(Cell.X, Cell.Y));
+				EditedCells.Add(Cell);
+			}
+			for (const FIntPoint& Cell : EditedCells)
+			{
+				Table.UpdateCell(Grid, Cell.X, Cell.Y);
+			}
+		}
+
+		ReferenceTable.Build(Grid, GridSizeX, GridSizeY);
+		int32 NumMismatches = 0;
+		for (int32 Index = 0; Index < GridSizeX * GridSizeY; ++Index)
+		{
+			for (int32 Direction = 0; Direction < FJumpPointTable::NUM_DIRECTIONS; ++Direction)
+			{
+				NumMismatches += Table.GetDistance(Index, Direction) != ReferenceTable.GetDistance(Index, Direction);
+			}
+		}
+		TestEqual(*FString::Printf(TEXT("grid %d: distances differing from a rebuild"), GridIndex), NumMismatches, 0);
+	}
+	return true;
+}
+
+#endif
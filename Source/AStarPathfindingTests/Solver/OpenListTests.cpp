@@ -0,0 +1,96 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/OpenList.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * Random pushes, decrease-keys and pops on one open list, then pops until it is empty.
+	 * Returns the pops that did not return a node of the lowest total cost, ties broken by the lowest estimate
+	 * when bBreaksTiesOnEstimate is set.
+	 */
+	template <typename FOpenList>
+	int32 CountOutOfOrderPops(FRandomStream& Random, bool bBreaksTiesOnEstimate, int32& OutNumPops)
+	{
+		constexpr int32 NumNodes = 400;
+		constexpr int32 NumOperations = 6000;
+		constexpr int32 MaxCost = 3000;
+
+		FOpenList OpenList;
+		OpenList.Initialize(NumNodes);
+		TArray<uint32> TotalCosts;
+		TArray<uint32> EstimatedCosts;
+		TArray<uint8> IsOpen;
+		TotalCosts.Init(0, NumNodes);
+		EstimatedCosts.Init(0, NumNodes);
+		IsOpen.Init(0, NumNodes);
+
+		int32 NumOpen = 0;
+		int32 NumOutOfOrder = 0;
+		OutNumPops = 0;
+		for (int32 Operation = 0; Operation < NumOperations || NumOpen > 0; ++Operation)
+		{
+			const bool bPops = Operation >= NumOperations || (NumOpen > 0 && Random.RandRange(0, 2) == 0);
+			if (!bPops)
+			{
+				const int32 Node = Random.RandRange(0, NumNodes - 1);
+				if (!IsOpen[Node])
+				{
+					TotalCosts[Node] = Random.RandRange(0, MaxCost);
+					EstimatedCosts[Node] = Random.RandRange(0, TotalCosts[Node]);
+					OpenList.Push(Node, TotalCosts[Node], EstimatedCosts[Node]);
+					IsOpen[Node] = 1;
+					++NumOpen;
+				}
+				else
+				{
+					const uint32 PreviousTotalCost = TotalCosts[Node];
+					TotalCosts[Node] = Random.RandRange(0, PreviousTotalCost);
+					EstimatedCosts[Node] = Random.RandRange(0, TotalCosts[Node]);
+					OpenList.DecreaseKey(Node, PreviousTotalCost, TotalCosts[Node], EstimatedCosts[Node]);
+				}
+				continue;
+			}
+
+			int32 BestNode = INDEX_NONE;
+			for (int32 Node = 0; Node < NumNodes; ++Node)
+			{
+				if (IsOpen[Node] && (BestNode == INDEX_NONE || TotalCosts[Node] < TotalCosts[BestNode]
+					|| (TotalCosts[Node] == TotalCosts[BestNode] && EstimatedCosts[Node] < EstimatedCosts[BestNode])))
+				{
+					BestNode = Node;
+				}
+			}
+
+			const int32 Node = OpenList.Pop();
+			NumOutOfOrder += !IsOpen[Node] || TotalCosts[Node] != TotalCosts[BestNode]
+				|| (bBreaksTiesOnEstimate && EstimatedCosts[Node] != EstimatedCosts[BestNode]);
+			IsOpen[Node] = 0;
+			--NumOpen;
+			++OutNumPops;
+		}
+		NumOutOfOrder += !OpenList.IsEmpty();
+		return NumOutOfOrder;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOpenListOrderTest, "AStarPathfinding.Solver.OpenList.PopsInKeyOrder",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOpenListOrderTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Random(19);
+	int32 NumPops = 0;
+	TestEqual(TEXT("linear scan pops out of order"), CountOutOfOrderPops<FLinearScanOpenList>(Random, true, NumPops), 0);
+	TestEqual(TEXT("binary heap pops out of order"),
+		CountOutOfOrderPops<TIndexedHeapOpenList<2>>(Random, true, NumPops), 0);
+	TestEqual(TEXT("4-ary heap pops out of order"),
+		CountOutOfOrderPops<TIndexedHeapOpenList<4>>(Random, true, NumPops), 0);
+	// Ties on total cost pop last in, first out
+	TestEqual(TEXT("bucket queue pops out of order"), CountOutOfOrderPops<FBucketOpenList>(Random, false, NumPops), 0);
+	TestTrue(TEXT("nodes popped"), NumPops > 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/PathCache.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	struct FCellQuery
+	{
+		int32 StartX;
+		int32 StartY;
+		int32 GoalX;
+		int32 GoalY;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathCacheInvalidationTest,
+	"AStarPathfinding.Solver.PathCache.KeptEntriesStayOptimal",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathCacheInvalidationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 30;
+	constexpr int32 NumRounds = 10;
+	constexpr int32 NumQueries = 24;
+	constexpr uint8 MAX_TEST_CELL_COST = 8;
+
+	FRandomStream Random(17);
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	FPathCache PathCache;
+	PathCache.SetBudget(64 * 1024 * 1024);
+	TArray<FCellQuery> Queries;
+	TArray<FVector> Path, CachedPath, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(4, 40);
+		const int32 GridSizeY = Random.RandRange(4, 40);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 35), Grid);
+		PathCache.Reset();
+
+		// Queries as start and goal cells, their starts and goals may get blocked by later rounds
+		Queries.Reset();
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			int32 StartX, StartY, GoalX, GoalY;
+			if (PathfindingTestUtils::PickCrossableCell(Random, Grid, StartX, StartY)
+				&& PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+			{
+				Queries.Add({ StartX, StartY, GoalX, GoalY });
+			}
+		}
+
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			// Every kept entry must answer like a fresh search, the others are searched and stored again
+			for (const FCellQuery& Query : Queries)
+			{
+				FPathCacheKey Key;
+				Key.StartIndex = Query.StartY * GridSizeX + Query.StartX;
+				Key.GoalIndex = Query.GoalY * GridSizeX + Query.GoalX;
+
+				const uint32 QueryVersion = PathCache.GetVersion();
+				const bool bFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, Query.StartX, Query.StartY,
+					Query.GoalX, Query.GoalY, 1.0f, Path, ExploredNodes);
+
+				bool bCachedFound = false;
+				if (!PathCache.Find(Key, bCachedFound, CachedPath))
+				{
+					PathCache.Add(Key, QueryVersion, bFound, Path, Grid, 1.0f);
+					continue;
+				}
+
+				const FString Description = FString::Printf(TEXT("grid %d round %d (%d, %d) to (%d, %d)"), GridIndex,
+					Round, Query.StartX, Query.StartY, Query.GoalX, Query.GoalY);
+				TestEqual(*FString::Printf(TEXT("found, %s"), *Description), bCachedFound, bFound);
+				if (bCachedFound && bFound)
+				{
+					TestEqual(*FString::Printf(TEXT("cost, %s"), *Description),
+						PathfindingTestUtils::GetCellPathCost(Grid, CachedPath, 1.0f),
+						PathfindingTestUtils::GetCellPathCost(Grid, Path, 1.0f));
+				}
+			}
+
+			// Walls and costs change the way AGridManager reports them to the cache
+			const int32 NumEdits = Random.RandRange(1, 6);
+			for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+			{
+				const int32 X = Random.RandRange(0, GridSizeX - 1);
+				const int32 Y = Random.RandRange(0, GridSizeY - 1);
+				if (Random.RandRange(0, 1) == 1)
+				{
+					const bool bIsCrossable = !Grid.IsCrossable(X, Y);
+					Grid.SetCrossable(X, Y, bIsCrossable);
+					if (bIsCrossable)
+					{
+						PathCache.InvalidateImprovedCell(X, Y);
+					}
+					else
+					{
+						PathCache.InvalidateWorsenedCell(X, Y);
+					}
+					continue;
+				}
+
+				const uint8 PreviousMinCellCost = Grid.GetMinCellCost();
+				const uint8 PreviousCost = Grid.GetCellCost(X, Y);
+				const uint8 Cost = static_cast<uint8>(Random.RandRange(1, MAX_TEST_CELL_COST));
+				Grid.SetCellCost(X, Y, Cost);
+				if (Grid.GetMinCellCost() < PreviousMinCellCost)
+				{
+					PathCache.Reset();
+				}
+				else if (Cost < PreviousCost)
+				{
+					PathCache.InvalidateImprovedCell(X, Y);
+				}
+				else if (Cost > PreviousCost)
+				{
+					PathCache.InvalidateWorsenedCell(X, Y);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+#endif
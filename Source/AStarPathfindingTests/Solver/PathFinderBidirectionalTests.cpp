@@ -0,0 +1,64 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/BidirectionalContext.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathFinderBidirectionalCostTest,
+	"AStarPathfinding.Solver.PathFinder.BidirectionalSameCostsAsAStar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathFinderBidirectionalCostTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGrids = 40;
+	constexpr int32 NumQueries = 40;
+
+	FRandomStream Random(8);
+	FPathFinderContext Context;
+	FBidirectionalContext BidirectionalContext;
+	FWalkabilityGrid Grid;
+	TArray<FVector> ReferencePath, Path, ExploredNodes;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+	{
+		const int32 GridSizeX = Random.RandRange(4, 48);
+		const int32 GridSizeY = Random.RandRange(4, 48);
+		PathfindingTestUtils::MakeRandomGrid(Random, GridSizeX, GridSizeY, Random.RandRange(0, 40), Grid);
+
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			int32 StartX, StartY, GoalX, GoalY;
+			if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, StartX, StartY)
+				|| !PathfindingTestUtils::PickCrossableCell(Random, Grid, GoalX, GoalY))
+			{
+				continue;
+			}
+
+			const bool bReferenceFound = PathFinder::Compute(Context, Grid, GridSizeX, GridSizeY, StartX, StartY, GoalX,
+				GoalY, 1.0f, ReferencePath, ExploredNodes);
+			const int64 ReferenceCost = PathfindingTestUtils::GetCellPathCost(Grid, ReferencePath, 1.0f);
+
+			// The two frontiers meet in a different order on a task, both runs must stay optimal
+			for (const bool bUseTwoThreads : { false, true })
+			{
+				const bool bFound = PathFinder::ComputeBidirectional(BidirectionalContext, Grid, GridSizeX, GridSizeY,
+					StartX, StartY, GoalX, GoalY, 1.0f, Path, ExploredNodes, bUseTwoThreads);
+				const FString Query = FString::Printf(TEXT("grid %d (%d, %d) to (%d, %d), %s"), GridIndex, StartX,
+					StartY, GoalX, GoalY, bUseTwoThreads ? TEXT("two threads") : TEXT("one thread"));
+
+				TestEqual(*FString::Printf(TEXT("found, %s"), *Query), bFound, bReferenceFound);
+				if (bFound && bReferenceFound)
+				{
+					TestTrue(*FString::Printf(TEXT("path ends, %s"), *Query),
+						PathfindingTestUtils::ConnectsCells(Path, 1.0f, StartX, StartY, GoalX, GoalY));
+					TestEqual(*FString::Printf(TEXT("cost, %s"), *Query),
+						PathfindingTestUtils::GetCellPathCost(Grid, Path, 1.0f), ReferenceCost);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+#endif
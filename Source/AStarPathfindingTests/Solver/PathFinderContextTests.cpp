@@ -0,0 +1,217 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfinding/Solver/PathFinderStats.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * Forwards everything to the allocator it wraps and counts the allocations made by the thread that created it,
+	 * the other threads of the engine keep allocating meanwhile.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInnerMalloc)
+			: InnerMalloc(InInnerMalloc)
+			, ThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return InnerMalloc->ValidateHeap();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("CountingMalloc");
+		}
+
+		FMalloc* GetInnerMalloc() const
+		{
+			return InnerMalloc;
+		}
+
+		int32 GetNumAllocations() const
+		{
+			return NumAllocations;
+		}
+
+	private:
+		FMalloc* InnerMalloc;
+		uint32 ThreadId;
+		int32 NumAllocations = 0;
+
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				++NumAllocations;
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathFinderContextSteadyStateTest,
+	"AStarPathfinding.Solver.PathFinderContext.SteadyStateAllocatesNothing",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathFinderContextSteadyStateTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 GridSize = 128;
+	constexpr int32 NumQueries = 64;
+
+	FRandomStream Random(2);
+	FWalkabilityGrid Grid;
+	PathfindingTestUtils::MakeRandomGrid(Random, GridSize, GridSize, 25, Grid);
+
+	struct FQuery
+	{
+		int32 StartX, StartY, GoalX, GoalY;
+	};
+	TArray<FQuery> Queries;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		FQuery& Query = Queries.AddDefaulted_GetRef();
+		PathfindingTestUtils::PickCrossableCell(Random, Grid, Query.StartX, Query.StartY);
+		PathfindingTestUtils::PickCrossableCell(Random, Grid, Query.GoalX, Query.GoalY);
+	}
+
+	for (const EOpenListType OpenListType : { EOpenListType::LinearScan, EOpenListType::BinaryHeap,
+		EOpenListType::QuaternaryHeap, EOpenListType::BucketQueue })
+	{
+		FPathFinderContext Context;
+		FPathResult Result;
+		Result.ExploredCapture = EExploredCapture::Indices;
+		TArray<FVector> Path;
+		TArray<FVector> ExploredNodes;
+
+		// The first pass grows the context and the outputs to the largest of the queries
+		for (const FQuery& Query : Queries)
+		{
+			PathFinder::Compute(Context, Grid, GridSize, GridSize, Query.StartX, Query.StartY, Query.GoalX,
+				Query.GoalY, Result, OpenListType);
+			PathFinder::Compute(Context, Grid, GridSize, GridSize, Query.StartX, Query.StartY, Query.GoalX,
+				Query.GoalY, 1.0f, Path, ExploredNodes, OpenListType);
+		}
+
+		const SIZE_T ContextSize = Context.GetAllocatedSize();
+		const SIZE_T ResultSize = Result.GetAllocatedSize();
+		const SIZE_T PathSize = Path.GetAllocatedSize() + ExploredNodes.GetAllocatedSize();
+		int64 AllocatedBytes = 0;
+		for (const FQuery& Query : Queries)
+		{
+			FPathQueryMetrics Metrics;
+			{
+				FPathQueryMetricsScope MetricsScope(Metrics, &Context, ExploredNodes);
+				PathFinder::Compute(Context, Grid, GridSize, GridSize, Query.StartX, Query.StartY, Query.GoalX,
+					Query.GoalY, Result, OpenListType);
+			}
+			AllocatedBytes += Metrics.AllocatedBytes;
+
+			{
+				FPathQueryMetricsScope MetricsScope(Metrics, &Context, ExploredNodes);
+				PathFinder::Compute(Context, Grid, GridSize, GridSize, Query.StartX, Query.StartY, Query.GoalX,
+					Query.GoalY, 1.0f, Path, ExploredNodes, OpenListType);
+			}
+			AllocatedBytes += Metrics.AllocatedBytes;
+		}
+
+		// Same replay with every allocation counted, without the metrics and their stats in the way
+		FCountingMalloc CountingMalloc(GMalloc);
+		GMalloc = &CountingMalloc;
+		for (const FQuery& Query : Queries)
+		{
+			PathFinder::Compute(Context, Grid, GridSize, GridSize, Query.StartX, Query.StartY, Query.GoalX,
+				Query.GoalY, Result, OpenListType);
+			PathFinder::Compute(Context, Grid, GridSize, GridSize, Query.StartX, Query.StartY, Query.GoalX,
+				Query.GoalY, 1.0f, Path, ExploredNodes, OpenListType);
+		}
+		GMalloc = CountingMalloc.GetInnerMalloc();
+
+		const FString OpenListName = StaticEnum<EOpenListType>()->GetNameStringByValue(static_cast<int64>(OpenListType));
+		TestEqual(*FString::Printf(TEXT("%s: bytes allocated by the queries"), *OpenListName), AllocatedBytes, int64(0));
+		TestEqual(*FString::Printf(TEXT("%s: allocations of the queries"), *OpenListName),
+			CountingMalloc.GetNumAllocations(), 0);
+		TestEqual(*FString::Printf(TEXT("%s: context size"), *OpenListName),
+			static_cast<int64>(Context.GetAllocatedSize()), static_cast<int64>(ContextSize));
+		TestEqual(*FString::Printf(TEXT("%s: result size"), *OpenListName),
+			static_cast<int64>(Result.GetAllocatedSize()), static_cast<int64>(ResultSize));
+		TestEqual(*FString::Printf(TEXT("%s: output size"), *OpenListName),
+			static_cast<int64>(Path.GetAllocatedSize() + ExploredNodes.GetAllocatedSize()), static_cast<int64>(PathSize));
+	}
+	return true;
+}
+
+#endif
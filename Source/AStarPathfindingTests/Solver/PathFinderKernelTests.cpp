@@ -0,0 +1,40 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfinding/Solver/PathFinderKernel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathFinderKernelCostLimitTest,
+	"AStarPathfinding.Solver.PathFinderKernel.CostLimit",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathFinderKernelCostLimitTest::RunTest(const FString& Parameters)
+{
+	// Corridors of the most expensive cells, the longer one costs more than the packed costs hold
+	constexpr int32 MAX_PACKED_STEPS = FDefaultPathFinder::FCostTraits::MAX_COST
+		/ (FDefaultPathFinder::FCostTraits::STRAIGHT_COST * MAX_uint8);
+
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	TArray<int32> PathCells;
+	for (const int32 Length : { MAX_PACKED_STEPS, MAX_PACKED_STEPS + 2 })
+	{
+		Grid.Init(Length, 1);
+		for (int32 X = 1; X < Length; ++X)
+		{
+			Grid.SetCellCost(X, 0, MAX_uint8);
+		}
+
+		FCellIndexOutput Output = { PathCells, nullptr };
+		const EPathSearchResult Result = FDefaultPathFinder::ComputeWithOutput(Context, Grid, Length, 1, 0, 0,
+			Length - 1, 0, Output);
+		const EPathSearchResult ExpectedResult = Length - 1 <= MAX_PACKED_STEPS
+			? EPathSearchResult::Found
+			: EPathSearchResult::CostLimitReached;
+		TestEqual(*FString::Printf(TEXT("result, %d cells"), Length), static_cast<int32>(Result),
+			static_cast<int32>(ExpectedResult));
+	}
+	return true;
+}
+
+#endif
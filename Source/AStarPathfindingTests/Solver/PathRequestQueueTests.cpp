@@ -0,0 +1,193 @@
+#include "Misc/AutomationTest.h"
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfinding/Solver/PathRequestQueue.h"
+#include "AStarPathfindingTests/PathfindingTestUtils.h"
+#include "HAL/PlatformProcess.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** What the callback of one request received */
+	struct FRequestRecord
+	{
+		int32 NumCalls = 0;
+		bool bWasCancelled = false;
+		bool bFoundPath = false;
+		TArray<FVector> Path;
+	};
+
+	/** Submits a request whose callback fills the record of index RecordIndex */
+	FPathRequestHandle SubmitRecorded(FPathRequestQueue& Queue, const FPathRequest& Request,
+		TArray<FRequestRecord>& Records, int32 RecordIndex)
+	{
+		return Queue.Submit(Request, [&Records, RecordIndex](FPathRequestResult& Result)
+		{
+			FRequestRecord& Record = Records[RecordIndex];
+			++Record.NumCalls;
+			Record.bWasCancelled = Result.bWasCancelled;
+			Record.bFoundPath = Result.bFoundPath;
+			Record.Path = Result.Path;
+		});
+	}
+
+	/** Delivers until no request is left, false when the searches did not end in time */
+	bool DeliverAll(FPathRequestQueue& Queue)
+	{
+		for (int32 Try = 0; Try < 10000 && Queue.GetNumPending() > 0; ++Try)
+		{
+			Queue.DeliverCompletedRequests();
+			if (Queue.GetNumPending() > 0)
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+		}
+		return Queue.GetNumPending() == 0;
+	}
+
+	FPathRequest MakeRequest(int32 StartX, int32 StartY, int32 GoalX, int32 GoalY, int32 AgentId)
+	{
+		FPathRequest Request;
+		Request.StartX = StartX;
+		Request.StartY = StartY;
+		Request.GoalX = GoalX;
+		Request.GoalY = GoalY;
+		Request.AgentId = AgentId;
+		return Request;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathRequestQueueSupersedeTest,
+	"AStarPathfinding.Solver.PathRequestQueue.SupersedesAgentRequests",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathRequestQueueSupersedeTest::RunTest(const FString& Parameters)
+{
+	FWalkabilityGrid Grid;
+	Grid.Init(32, 32);
+	FPathRequestQueue Queue;
+	Queue.SetGrid(&Grid, 1.0f);
+
+	TArray<FRequestRecord> Records;
+	Records.SetNum(4);
+	const FPathRequestHandle First = SubmitRecorded(Queue, MakeRequest(0, 0, 31, 31, 1), Records, 0);
+	const FPathRequestHandle Other = SubmitRecorded(Queue, MakeRequest(0, 31, 31, 0, 2), Records, 1);
+	const FPathRequestHandle Second = SubmitRecorded(Queue, MakeRequest(0, 0, 31, 0, 1), Records, 2);
+	const FPathRequestHandle Anonymous = SubmitRecorded(Queue, MakeRequest(5, 5, 6, 6, INDEX_NONE), Records, 3);
+
+	// Only the newest request of an agent stays pending, the other agents and anonymous requests are untouched
+	TestFalse(TEXT("superseded request pending"), Queue.IsPending(First));
+	TestTrue(TEXT("other agent request pending"), Queue.IsPending(Other));
+	TestTrue(TEXT("newest request pending"), Queue.IsPending(Second));
+	TestTrue(TEXT("anonymous request pending"), Queue.IsPending(Anonymous));
+	TestFalse(TEXT("cancelled superseded request"), Queue.Cancel(First));
+
+	TestTrue(TEXT("delivered"), DeliverAll(Queue));
+	for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+	{
+		TestEqual(*FString::Printf(TEXT("calls of request %d"), RecordIndex), Records[RecordIndex].NumCalls, 1);
+		TestEqual(*FString::Printf(TEXT("request %d cancelled"), RecordIndex), Records[RecordIndex].bWasCancelled,
+			RecordIndex == 0);
+		TestEqual(*FString::Printf(TEXT("request %d found"), RecordIndex), Records[RecordIndex].bFoundPath,
+			RecordIndex != 0);
+	}
+	TestEqual(TEXT("superseded path length"), Records[0].Path.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathRequestQueueCancelTest,
+	"AStarPathfinding.Solver.PathRequestQueue.CallsEveryCallbackOnce",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathRequestQueueCancelTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumRounds = 20;
+	constexpr int32 NumAgents = 6;
+
+	FRandomStream Random(37);
+	FPathFinderContext Context;
+	FWalkabilityGrid Grid;
+	PathfindingTestUtils::MakeRandomGrid(Random, 48, 48, 25, Grid);
+	FPathRequestQueue Queue;
+	Queue.SetGrid(&Grid, 1.0f);
+
+	TArray<FRequestRecord> Records;
+	TArray<FPathRequestHandle> Handles;
+	TArray<FPathRequest> Requests;
+	TArray<uint8> IsCancelled;
+	TArray<FVector> ReferencePath, ExploredNodes;
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		const int32 NumRequests = Random.RandRange(1, 24);
+		for (int32 RequestIndex = 0; RequestIndex < NumRequests; ++RequestIndex)
+		{
+			FPathRequest Request;
+			if (!PathfindingTestUtils::PickCrossableCell(Random, Grid, Request.StartX, Request.StartY)
+				|| !PathfindingTestUtils::PickCrossableCell(Random, Grid, Request.GoalX, Request.GoalY))
+			{
+				continue;
+			}
+			Request.AgentId = Random.RandRange(-1, NumAgents - 1);
+
+			const int32 RecordIndex = Records.AddDefaulted();
+			Requests.Add(Request);
+			IsCancelled.Add(0);
+			Handles.Add(SubmitRecorded(Queue, Request, Records, RecordIndex));
+
+			// Cancel pending requests at random, a second cancel of the same handle finds nothing
+			if (Random.RandRange(0, 3) == 0)
+			{
+				const int32 CancelIndex = Random.RandRange(0, Handles.Num() - 1);
+				if (Queue.IsPending(Handles[CancelIndex]))
+				{
+					TestTrue(TEXT("cancelled pending request"), Queue.Cancel(Handles[CancelIndex]));
+					TestFalse(TEXT("cancelled twice"), Queue.Cancel(Handles[CancelIndex]));
+					IsCancelled[CancelIndex] = 1;
+				}
+			}
+		}
+
+		// Every other round drops everything still running, CancelAll delivers the callbacks itself
+		if (Round % 2 == 1)
+		{
+			Queue.CancelAll();
+			TestEqual(TEXT("pending after CancelAll"), Queue.GetNumPending(), 0);
+		}
+		else
+		{
+			TestTrue(TEXT("delivered"), DeliverAll(Queue));
+		}
+	}
+	Queue.DeliverCompletedRequests();
+
+	for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+	{
+		const FRequestRecord& Record = Records[RecordIndex];
+		const FPathRequest& Request = Requests[RecordIndex];
+		const FString Query = FString::Printf(TEXT("request %d (%d, %d) to (%d, %d)"), RecordIndex, Request.StartX,
+			Request.StartY, Request.GoalX, Request.GoalY);
+
+		TestEqual(*FString::Printf(TEXT("calls, %s"), *Query), Record.NumCalls, 1);
+		if (IsCancelled[RecordIndex])
+		{
+			TestTrue(*FString::Printf(TEXT("cancelled, %s"), *Query), Record.bWasCancelled);
+		}
+		if (Record.bWasCancelled)
+		{
+			TestEqual(*FString::Printf(TEXT("cancelled path, %s"), *Query), Record.Path.Num(), 0);
+			continue;
+		}
+
+		// Delivered results are the ones of a search on the grid
+		const bool bReferenceFound = PathFinder::Compute(Context, Grid, Grid.GetSizeX(), Grid.GetSizeY(),
+			Request.StartX, Request.StartY, Request.GoalX, Request.GoalY, 1.0f, ReferencePath, ExploredNodes);
+		TestEqual(*FString::Printf(TEXT("found, %s"), *Query), Record.bFoundPath, bReferenceFound);
+		TestEqual(*FString::Printf(TEXT("cost, %s"), *Query),
+			PathfindingTestUtils::GetCellPathCost(Grid, Record.Path, 1.0f),
+			PathfindingTestUtils::GetCellPathCost(Grid, ReferencePath, 1.0f));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,131 @@
+// Micro-benchmark of the standalone A* core: seeded random grids of a few sizes and wall densities, one reused
+// context, every open list. Prints the mean time per query and the mean explored cells per query.
+//   AStarPathfindingCoreBenchmark [NumQueries]
+#include "AStarPathfinding/Solver/PathFinder.h"
+#include "AStarPathfinding/Solver/PathFinderContext.h"
+#include "AStarPathfinding/Grid/WalkabilityGrid.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+	struct FBenchmarkGrid
+	{
+		int32 Size;
+		int32 WallPercent;
+	};
+
+	struct FQuery
+	{
+		int32 StartX;
+		int32 StartY;
+		int32 GoalX;
+		int32 GoalY;
+	};
+
+	const TCHAR* GetOpenListName(EOpenListType OpenListType)
+	{
+		switch (OpenListType)
+		{
+		case EOpenListType::LinearScan:
+			return TEXT("linear scan");
+		case EOpenListType::BinaryHeap:
+			return TEXT("binary heap");
+		case EOpenListType::QuaternaryHeap:
+			return TEXT("4-ary heap");
+		case EOpenListType::BucketQueue:
+			return TEXT("bucket queue");
+		}
+		return TEXT("unknown");
+	}
+
+	void MakeGrid(std::mt19937& Random, const FBenchmarkGrid& Layout, FWalkabilityGrid& OutGrid)
+	{
+		std::uniform_int_distribution<int32> Percent(0, 99);
+		OutGrid.Init(Layout.Size, Layout.Size);
+		for (int32 Y = 0; Y < Layout.Size; ++Y)
+		{
+			for (int32 X = 0; X < Layout.Size; ++X)
+			{
+				if (Percent(Random) < Layout.WallPercent)
+				{
+					OutGrid.SetCrossable(X, Y, false);
+				}
+			}
+		}
+	}
+
+	/// Queries between crossable cells, start and goal at least half the grid apart
+	void MakeQueries(std::mt19937& Random, const FWalkabilityGrid& Grid, int32 NumQueries, TArray<FQuery>& OutQueries)
+	{
+		const int32 Size = Grid.GetSizeX();
+		std::uniform_int_distribution<int32> Coordinate(0, Size - 1);
+		OutQueries.Reset();
+		while (OutQueries.Num() < NumQueries)
+		{
+			const FQuery Query = { Coordinate(Random), Coordinate(Random), Coordinate(Random), Coordinate(Random) };
+			if (Grid.IsCrossable(Query.StartX, Query.StartY) && Grid.IsCrossable(Query.GoalX, Query.GoalY)
+				&& FMath::Abs(Query.GoalX - Query.StartX) + FMath::Abs(Query.GoalY - Query.StartY) >= Size / 2)
+			{
+				OutQueries.Add(Query);
+			}
+		}
+	}
+}
+
+int main(int ArgC, char** ArgV)
+{
+	const int32 NumQueries = ArgC > 1 ? FMath::Max(1, std::atoi(ArgV[1])) : 200;
+	const FBenchmarkGrid Layouts[] = { { 64, 20 }, { 256, 20 }, { 256, 35 }, { 1024, 20 } };
+	const EOpenListType OpenListTypes[] = {
+		EOpenListType::LinearScan, EOpenListType::BinaryHeap, EOpenListType::QuaternaryHeap,
+		EOpenListType::BucketQueue
+	};
+
+	std::printf("%-10s %-6s %-13s %12s %12s %8s\n", "grid", "walls", "open list", "us/query", "explored", "found");
+
+	std::mt19937 Random(19);
+	FWalkabilityGrid Grid;
+	FPathFinderContext Context;
+	TArray<FQuery> Queries;
+	TArray<int32> PathCells;
+	TArray<int32> ExploredCells;
+	for (const FBenchmarkGrid& Layout : Layouts)
+	{
+		MakeGrid(Random, Layout, Grid);
+		MakeQueries(Random, Grid, NumQueries, Queries);
+
+		for (const EOpenListType OpenListType : OpenListTypes)
+		{
+			// The linear scan is quadratic in the frontier, the largest grid would take minutes
+			if (OpenListType == EOpenListType::LinearScan && Layout.Size > 256)
+			{
+				continue;
+			}
+
+			// One untimed query sizes the context
+			PathFinder::ComputeCells(Context, Grid, Layout.Size, Layout.Size, Queries[0].StartX, Queries[0].StartY,
+				Queries[0].GoalX, Queries[0].GoalY, PathCells, &ExploredCells, OpenListType);
+
+			int64 NumExplored = 0;
+			int32 NumFound = 0;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (const FQuery& Query : Queries)
+			{
+				NumFound += PathFinder::ComputeCells(Context, Grid, Layout.Size, Layout.Size, Query.StartX, Query.StartY,
+					Query.GoalX, Query.GoalY, PathCells, &ExploredCells, OpenListType);
+				NumExplored += ExploredCells.Num();
+			}
+			const double Milliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+			char GridName[32];
+			std::snprintf(GridName, sizeof(GridName), "%dx%d", Layout.Size, Layout.Size);
+			std::printf("%-10s %5d%% %-13s %12.1f %12lld %7d%%\n", GridName, Layout.WallPercent,
+				GetOpenListName(OpenListType), Milliseconds * 1000.0 / Queries.Num(),
+				static_cast<long long>(NumExplored / Queries.Num()), NumFound * 100 / Queries.Num());
+		}
+	}
+	return 0;
+}
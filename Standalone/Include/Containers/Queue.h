@@ -0,0 +1,58 @@
+// Queue.h
+#pragma once
+
+/**
+ * Unbounded FIFO queue of the engine for the standalone build. Both modes lock a mutex, the engine Mpsc queue is
+ * lock-free, so only the ordering and thread-safety guarantees match.
+ */
+
+#include "PathfindingCoreStandalone.h"
+#include <deque>
+#include <mutex>
+
+enum class EQueueMode
+{
+	Mpsc,
+	Spsc
+};
+
+template <typename T, EQueueMode Mode = EQueueMode::Spsc>
+class TQueue
+{
+public:
+	bool Enqueue(T&& Item)
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		Items.push_back(MoveTemp(Item));
+		return true;
+	}
+
+	bool Enqueue(const T& Item)
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		Items.push_back(Item);
+		return true;
+	}
+
+	bool Dequeue(T& OutItem)
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		if (Items.empty())
+		{
+			return false;
+		}
+		OutItem = MoveTemp(Items.front());
+		Items.pop_front();
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		return Items.empty();
+	}
+
+private:
+	mutable std::mutex Mutex;
+	std::deque<T> Items;
+};
@@ -0,0 +1,52 @@
+// CriticalSection.h
+#pragma once
+
+/** Mutexes of the engine for the standalone build, over the standard library ones */
+
+#include "PathfindingCoreStandalone.h"
+#include <mutex>
+#include <shared_mutex>
+
+class FCriticalSection
+{
+public:
+	void Lock()
+	{
+		Mutex.lock();
+	}
+
+	void Unlock()
+	{
+		Mutex.unlock();
+	}
+
+private:
+	std::mutex Mutex;
+};
+
+class FRWLock
+{
+public:
+	void ReadLock()
+	{
+		Mutex.lock_shared();
+	}
+
+	void ReadUnlock()
+	{
+		Mutex.unlock_shared();
+	}
+
+	void WriteLock()
+	{
+		Mutex.lock();
+	}
+
+	void WriteUnlock()
+	{
+		Mutex.unlock();
+	}
+
+private:
+	std::shared_mutex Mutex;
+};
@@ -0,0 +1,15 @@
+// PlatformProcess.h
+#pragma once
+
+/** Process helpers of the engine for the standalone build, only what the tests use */
+
+#include "PathfindingCoreStandalone.h"
+#include <thread>
+
+struct FPlatformProcess
+{
+	static void Sleep(float Seconds)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<float>(Seconds));
+	}
+};
@@ -0,0 +1,25 @@
+// ScopeLock.h
+#pragma once
+
+#include "HAL/CriticalSection.h"
+
+/** Holds a critical section for its lifetime */
+class FScopeLock
+{
+public:
+	explicit FScopeLock(FCriticalSection* InCriticalSection)
+		: CriticalSection(InCriticalSection)
+	{
+		CriticalSection->Lock();
+	}
+
+	~FScopeLock()
+	{
+		CriticalSection->Unlock();
+	}
+
+	UE_NONCOPYABLE(FScopeLock);
+
+private:
+	FCriticalSection* CriticalSection;
+};
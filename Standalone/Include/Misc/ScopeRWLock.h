@@ -0,0 +1,46 @@
+// ScopeRWLock.h
+#pragma once
+
+#include "HAL/CriticalSection.h"
+
+/** Holds a read-write lock for reading for its lifetime */
+class FReadScopeLock
+{
+public:
+	explicit FReadScopeLock(FRWLock& InLock)
+		: Lock(InLock)
+	{
+		Lock.ReadLock();
+	}
+
+	~FReadScopeLock()
+	{
+		Lock.ReadUnlock();
+	}
+
+	UE_NONCOPYABLE(FReadScopeLock);
+
+private:
+	FRWLock& Lock;
+};
+
+/** Holds a read-write lock for writing for its lifetime */
+class FWriteScopeLock
+{
+public:
+	explicit FWriteScopeLock(FRWLock& InLock)
+		: Lock(InLock)
+	{
+		Lock.WriteLock();
+	}
+
+	~FWriteScopeLock()
+	{
+		Lock.WriteUnlock();
+	}
+
+	UE_NONCOPYABLE(FWriteScopeLock);
+
+private:
+	FRWLock& Lock;
+};
@@ -0,0 +1,4 @@
+// PathFinderTypes.generated.h
+#pragma once
+
+// Stands in for the header generated by the engine, the standalone build has no reflection
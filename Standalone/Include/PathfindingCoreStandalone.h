@@ -0,0 +1,1022 @@
+// PathfindingCoreStandalone.h
+#pragma once
+
+/**
+ * Standard library versions of the engine types the pathfinding core uses, see AStarPathfinding/PathfindingCore.h.
+ * Only the subset the core needs, with the engine semantics it relies on: int32 sizes (int64 for TArray64),
+ * INDEX_NONE for missing items, Reset keeping the allocation, checks compiled out with NDEBUG.
+ * Stats, trace and memory tag macros compile to nothing, UE_LOG prints to stderr.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//////// TYPES ////////
+typedef int8_t int8;
+typedef uint8_t uint8;
+typedef int16_t int16;
+typedef uint16_t uint16;
+typedef int32_t int32;
+typedef uint32_t uint32;
+typedef int64_t int64;
+typedef uint64_t uint64;
+typedef size_t SIZE_T;
+typedef char TCHAR;
+
+#define TEXT(Text) Text
+#define FORCEINLINE inline __attribute__((always_inline))
+#define FORCENOINLINE __attribute__((noinline))
+#define LIKELY(Expr) __builtin_expect(!!(Expr), 1)
+#define UNLIKELY(Expr) __builtin_expect(!!(Expr), 0)
+#define RESTRICT __restrict
+#define ASTARPATHFINDING_API
+
+#define UE_SOURCE_LOCATION TEXT(__FILE__)
+#define INDEX_NONE (-1)
+#define UE_ARRAY_COUNT(Array) static_cast<int32>(sizeof(Array) / sizeof((Array)[0]))
+#define MAX_uint8 (static_cast<uint8>(0xff))
+#define MAX_uint16 (static_cast<uint16>(0xffff))
+#define MAX_uint32 (static_cast<uint32>(0xffffffff))
+#define MAX_int16 (static_cast<int16>(0x7fff))
+#define MAX_int32 (static_cast<int32>(0x7fffffff))
+#define MIN_int32 (static_cast<int32>(0x80000000))
+#define MAX_int64 (static_cast<int64>(0x7fffffffffffffff))
+#define MAX_flt (3.402823466e+38F)
+#define UE_SQRT_2 (1.4142135623730950488016887242097f)
+
+#define UE_NONCOPYABLE(Type) \
+	Type(const Type&) = delete; \
+	Type& operator=(const Type&) = delete;
+
+/// Reflection markup of the shared type headers, there is no header tool outside the engine
+#define UENUM(...)
+#define USTRUCT(...)
+#define UPROPERTY(...)
+#define UMETA(...)
+#define GENERATED_BODY()
+
+//////// ASSERTS AND LOGGING ////////
+#define check(Expr) assert(Expr)
+#define checkSlow(Expr) assert(Expr)
+#define checkf(Expr, Format, ...) assert(Expr)
+
+namespace AStarPathfindingStandalone
+{
+	struct FLogCategory
+	{
+		const char* Name;
+	};
+
+	inline void Log(const FLogCategory& Category, const char* Verbosity, const char* Format, ...)
+	{
+		va_list Args;
+		va_start(Args, Format);
+		std::fprintf(stderr, "%s: %s: ", Category.Name, Verbosity);
+		std::vfprintf(stderr, Format, Args);
+		std::fputc('\n', stderr);
+		va_end(Args);
+	}
+}
+
+inline constexpr AStarPathfindingStandalone::FLogCategory LogTemp = { "LogTemp" };
+
+#define UE_LOG(Category, Verbosity, Format, ...) \
+	AStarPathfindingStandalone::Log(Category, #Verbosity, Format, ##__VA_ARGS__)
+
+//////// STATS AND TRACE ////////
+/// Profile with perf or valgrind instead, the scopes of the module compile to nothing
+#define TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+#define SCOPE_CYCLE_COUNTER(Stat)
+#define DECLARE_STATS_GROUP(...)
+#define DECLARE_CYCLE_STAT_EXTERN(...)
+#define DECLARE_DWORD_COUNTER_STAT_EXTERN(...)
+#define DECLARE_FLOAT_COUNTER_STAT_EXTERN(...)
+#define DECLARE_MEMORY_STAT_EXTERN(...)
+#define DEFINE_STAT(Stat)
+#define INC_DWORD_STAT(Stat)
+#define INC_DWORD_STAT_BY(Stat, Amount)
+#define SET_DWORD_STAT(Stat, Value)
+#define SET_FLOAT_STAT(Stat, Value)
+#define INC_MEMORY_STAT_BY(Stat, Amount)
+#define LLM_DECLARE_TAG_API(...)
+#define LLM_DEFINE_TAG(...)
+#define LLM_SCOPE_BYTAG(Tag)
+
+//////// PLATFORM ////////
+struct FMemory
+{
+	static void* Memcpy(void* Dest, const void* Src, SIZE_T Count)
+	{
+		return std::memcpy(Dest, Src, Count);
+	}
+
+	static void* Memset(void* Dest, uint8 Value, SIZE_T Count)
+	{
+		return std::memset(Dest, Value, Count);
+	}
+
+	static void* Memzero(void* Dest, SIZE_T Count)
+	{
+		return std::memset(Dest, 0, Count);
+	}
+};
+
+/** Sequentially consistent atomics on the plain integers the core shares between threads */
+struct FPlatformAtomics
+{
+	template <typename T>
+	static T AtomicRead(const volatile T* Source)
+	{
+		return __atomic_load_n(Source, __ATOMIC_SEQ_CST);
+	}
+
+	template <typename T>
+	static void AtomicStore(volatile T* Destination, T Value)
+	{
+		__atomic_store_n(Destination, Value, __ATOMIC_SEQ_CST);
+	}
+
+	template <typename T>
+	static T InterlockedIncrement(volatile T* Value)
+	{
+		return __atomic_add_fetch(Value, 1, __ATOMIC_SEQ_CST);
+	}
+
+	/** Returns the previous value, Exchange is stored only if it was Comparand */
+	template <typename T>
+	static T InterlockedCompareExchange(volatile T* Destination, T Exchange, T Comparand)
+	{
+		__atomic_compare_exchange_n(Destination, &Comparand, Exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+		return Comparand;
+	}
+};
+
+struct FPlatformTime
+{
+	static uint64 Cycles64()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static double ToMilliseconds64(uint64 Cycles)
+	{
+		return Cycles * 1e-6;
+	}
+
+	static double Seconds()
+	{
+		return Cycles64() * 1e-9;
+	}
+};
+
+struct FMath
+{
+	template <typename T>
+	static constexpr T Abs(T Value)
+	{
+		return Value < T(0) ? -Value : Value;
+	}
+
+	template <typename T>
+	static constexpr T Min(T A, T B)
+	{
+		return A < B ? A : B;
+	}
+
+	template <typename T>
+	static constexpr T Max(T A, T B)
+	{
+		return A > B ? A : B;
+	}
+
+	template <typename T>
+	static constexpr T Clamp(T Value, T MinValue, T MaxValue)
+	{
+		return Value < MinValue ? MinValue : Value > MaxValue ? MaxValue : Value;
+	}
+
+	template <typename T>
+	static constexpr T Sign(T Value)
+	{
+		return Value > T(0) ? T(1) : Value < T(0) ? T(-1) : T(0);
+	}
+
+	template <typename T>
+	static constexpr T Square(T Value)
+	{
+		return Value * Value;
+	}
+
+	template <typename T>
+	static constexpr T DivideAndRoundUp(T Dividend, T Divisor)
+	{
+		return (Dividend + Divisor - 1) / Divisor;
+	}
+
+	static float Sqrt(float Value)
+	{
+		return std::sqrt(Value);
+	}
+
+	static double Sqrt(double Value)
+	{
+		return std::sqrt(Value);
+	}
+
+	static int32 FloorToInt(float Value)
+	{
+		return static_cast<int32>(std::floor(Value));
+	}
+
+	static int32 RoundToInt(float Value)
+	{
+		return static_cast<int32>(std::lround(Value));
+	}
+
+	static int32 CeilToInt(float Value)
+	{
+		return static_cast<int32>(std::ceil(Value));
+	}
+
+	static double RoundToDouble(double Value)
+	{
+		return std::round(Value);
+	}
+
+	template <typename T, typename U>
+	static constexpr T Lerp(const T& A, const T& B, const U& Alpha)
+	{
+		return static_cast<T>(A + (B - A) * Alpha);
+	}
+
+	static uint32 CountTrailingZeros(uint32 Value)
+	{
+		return Value == 0 ? 32 : static_cast<uint32>(__builtin_ctz(Value));
+	}
+
+	static uint64 CountTrailingZeros64(uint64 Value)
+	{
+		return Value == 0 ? 64 : static_cast<uint64>(__builtin_ctzll(Value));
+	}
+
+	static uint32 CeilLogTwo(uint32 Value)
+	{
+		return Value <= 1 ? 0 : 32 - static_cast<uint32>(__builtin_clz(Value - 1));
+	}
+
+	static uint32 RoundUpToPowerOfTwo(uint32 Value)
+	{
+		return 1u << CeilLogTwo(Value);
+	}
+};
+
+//////// UTILITIES ////////
+template <typename T>
+FORCEINLINE std::remove_reference_t<T>&& MoveTemp(T&& Value)
+{
+	return static_cast<std::remove_reference_t<T>&&>(Value);
+}
+
+template <typename T>
+FORCEINLINE void Swap(T& A, T& B)
+{
+	std::swap(A, B);
+}
+
+template <typename KeyType, typename ValueType>
+struct TPair
+{
+	KeyType Key;
+	ValueType Value;
+
+	TPair() = default;
+	TPair(KeyType InKey, ValueType InValue)
+		: Key(MoveTemp(InKey))
+		, Value(MoveTemp(InValue))
+	{
+	}
+};
+
+template <typename T, T... Indices>
+using TIntegerSequence = std::integer_sequence<T, Indices...>;
+template <typename T, T Count>
+using TMakeIntegerSequence = std::make_integer_sequence<T, Count>;
+
+template <typename FunctionType>
+using TFunctionRef = std::function<FunctionType>;
+template <typename FunctionType>
+using TFunction = std::function<FunctionType>;
+
+template <typename T>
+class TUniquePtr : public std::unique_ptr<T>
+{
+public:
+	using std::unique_ptr<T>::unique_ptr;
+
+	TUniquePtr() = default;
+	TUniquePtr(std::unique_ptr<T>&& Other)
+		: std::unique_ptr<T>(MoveTemp(Other))
+	{
+	}
+
+	bool IsValid() const
+	{
+		return static_cast<bool>(*this);
+	}
+
+	T* Get() const
+	{
+		return this->get();
+	}
+
+	void Reset()
+	{
+		this->reset();
+	}
+};
+
+template <typename T, typename... ArgTypes>
+TUniquePtr<T> MakeUnique(ArgTypes&&... Args)
+{
+	return std::make_unique<T>(std::forward<ArgTypes>(Args)...);
+}
+
+/** Thread-safe shared pointer, TSharedRef is only never null by convention */
+template <typename T>
+class TSharedPtr : public std::shared_ptr<T>
+{
+public:
+	using std::shared_ptr<T>::shared_ptr;
+
+	TSharedPtr() = default;
+	template <typename OtherType>
+	TSharedPtr(const std::shared_ptr<OtherType>& Other)
+		: std::shared_ptr<T>(Other)
+	{
+	}
+
+	bool IsValid() const
+	{
+		return static_cast<bool>(*this);
+	}
+
+	T* Get() const
+	{
+		return this->get();
+	}
+
+	void Reset()
+	{
+		this->reset();
+	}
+};
+
+template <typename T>
+using TSharedRef = TSharedPtr<T>;
+
+template <typename T, typename... ArgTypes>
+TSharedRef<T> MakeShared(ArgTypes&&... Args)
+{
+	return std::make_shared<T>(std::forward<ArgTypes>(Args)...);
+}
+
+//////// HASHING ////////
+/** The engine hash of integer keys: the value itself, 64-bit values fold their high half in */
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+FORCEINLINE uint32 GetTypeHash(T Value)
+{
+	if constexpr (sizeof(T) <= 4)
+	{
+		return static_cast<uint32>(Value);
+	}
+	else
+	{
+		return static_cast<uint32>(Value) + static_cast<uint32>(static_cast<uint64>(Value) >> 32) * 23;
+	}
+}
+
+/** Same mix as the engine, so the hashes of the core do not depend on the build */
+FORCEINLINE uint32 HashCombine(uint32 A, uint32 C)
+{
+	uint32 B = 0x9e3779b9;
+	A += B;
+
+	A -= B; A -= C; A ^= (C >> 13);
+	B -= C; B -= A; B ^= (A << 8);
+	C -= A; C -= B; C ^= (B >> 13);
+	A -= B; A -= C; A ^= (C >> 12);
+	B -= C; B -= A; B ^= (A << 16);
+	C -= A; C -= B; C ^= (B >> 5);
+	A -= B; A -= C; A ^= (C >> 3);
+	B -= C; B -= A; B ^= (A << 10);
+	C -= A; C -= B; C ^= (B >> 15);
+
+	return C;
+}
+
+//////// CONTAINERS ////////
+enum class EAllowShrinking : uint8
+{
+	No,
+	Yes
+};
+
+/**
+ * Dynamic array over std::vector, indexed with SizeType like the engine TArray (int32) and TArray64 (int64).
+ * Reset keeps the allocation and Empty releases it, as the core expects of its reused buffers.
+ */
+template <typename T, typename InSizeType = int32>
+class TStandaloneArray
+{
+public:
+	typedef InSizeType SizeType;
+	static_assert(!std::is_same_v<T, bool>, "std::vector<bool> has no bool references, store uint8 flags instead");
+
+	TStandaloneArray() = default;
+	TStandaloneArray(std::initializer_list<T> Items)
+		: Items(Items)
+	{
+	}
+
+	SizeType Num() const
+	{
+		return static_cast<SizeType>(Items.size());
+	}
+
+	SizeType Max() const
+	{
+		return static_cast<SizeType>(Items.capacity());
+	}
+
+	bool IsEmpty() const
+	{
+		return Items.empty();
+	}
+
+	bool IsValidIndex(SizeType Index) const
+	{
+		return Index >= 0 && Index < Num();
+	}
+
+	T& operator[](SizeType Index)
+	{
+		checkSlow(IsValidIndex(Index));
+		return Items[Index];
+	}
+
+	const T& operator[](SizeType Index) const
+	{
+		checkSlow(IsValidIndex(Index));
+		return Items[Index];
+	}
+
+	T* GetData()
+	{
+		return Items.data();
+	}
+
+	const T* GetData() const
+	{
+		return Items.data();
+	}
+
+	T& Last(SizeType IndexFromTheEnd = 0)
+	{
+		return Items[Items.size() - 1 - IndexFromTheEnd];
+	}
+
+	const T& Last(SizeType IndexFromTheEnd = 0) const
+	{
+		return Items[Items.size() - 1 - IndexFromTheEnd];
+	}
+
+	SizeType Add(const T& Item)
+	{
+		Items.push_back(Item);
+		return Num() - 1;
+	}
+
+	SizeType Add(T&& Item)
+	{
+		Items.push_back(MoveTemp(Item));
+		return Num() - 1;
+	}
+
+	template <typename... ArgTypes>
+	SizeType Emplace(ArgTypes&&... Args)
+	{
+		Items.emplace_back(std::forward<ArgTypes>(Args)...);
+		return Num() - 1;
+	}
+
+	SizeType AddDefaulted(SizeType Count = 1)
+	{
+		const SizeType First = Num();
+		Items.resize(Items.size() + Count);
+		return First;
+	}
+
+	T& AddDefaulted_GetRef()
+	{
+		return Items.emplace_back();
+	}
+
+	SizeType AddUnique(const T& Item)
+	{
+		const SizeType Index = Find(Item);
+		return Index != INDEX_NONE ? Index : Add(Item);
+	}
+
+	SizeType AddUninitialized(SizeType Count = 1)
+	{
+		const SizeType First = Num();
+		Items.resize(Items.size() + Count);
+		return First;
+	}
+
+	SizeType AddZeroed(SizeType Count = 1)
+	{
+		const SizeType First = Num();
+		Items.resize(Items.size() + Count, T());
+		return First;
+	}
+
+	void Append(const TStandaloneArray& Other)
+	{
+		Items.insert(Items.end(), Other.Items.begin(), Other.Items.end());
+	}
+
+	void Append(const T* Source, SizeType Count)
+	{
+		Items.insert(Items.end(), Source, Source + Count);
+	}
+
+	T Pop(EAllowShrinking AllowShrinking = EAllowShrinking::Yes)
+	{
+		T Item = MoveTemp(Items.back());
+		Items.pop_back();
+		return Item;
+	}
+
+	void RemoveAt(SizeType Index, SizeType Count = 1)
+	{
+		Items.erase(Items.begin() + Index, Items.begin() + Index + Count);
+	}
+
+	void RemoveAtSwap(SizeType Index)
+	{
+		Items[Index] = MoveTemp(Items.back());
+		Items.pop_back();
+	}
+
+	template <typename PredicateType>
+	SizeType RemoveAll(const PredicateType& Predicate)
+	{
+		const SizeType PreviousNum = Num();
+		Items.erase(std::remove_if(Items.begin(), Items.end(), Predicate), Items.end());
+		return PreviousNum - Num();
+	}
+
+	void Init(const T& Item, SizeType Count)
+	{
+		Items.assign(Count, Item);
+	}
+
+	void SetNum(SizeType Count, EAllowShrinking AllowShrinking = EAllowShrinking::Yes)
+	{
+		Items.resize(Count);
+	}
+
+	void SetNumUninitialized(SizeType Count, EAllowShrinking AllowShrinking = EAllowShrinking::Yes)
+	{
+		Items.resize(Count);
+	}
+
+	void SetNumZeroed(SizeType Count, EAllowShrinking AllowShrinking = EAllowShrinking::Yes)
+	{
+		Items.assign(Count, T());
+	}
+
+	void Reserve(SizeType Count)
+	{
+		Items.reserve(Count);
+	}
+
+	void Reset(SizeType NewSize = 0)
+	{
+		Items.clear();
+		Items.reserve(NewSize);
+	}
+
+	void Empty(SizeType Slack = 0)
+	{
+		std::vector<T>().swap(Items);
+		Items.reserve(Slack);
+	}
+
+	bool Contains(const T& Item) const
+	{
+		return std::find(Items.begin(), Items.end(), Item) != Items.end();
+	}
+
+	SizeType Find(const T& Item) const
+	{
+		const auto It = std::find(Items.begin(), Items.end(), Item);
+		return It == Items.end() ? INDEX_NONE : static_cast<SizeType>(It - Items.begin());
+	}
+
+	void Sort()
+	{
+		std::sort(Items.begin(), Items.end());
+	}
+
+	template <typename PredicateType>
+	void Sort(const PredicateType& Predicate)
+	{
+		std::sort(Items.begin(), Items.end(), Predicate);
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Items.capacity() * sizeof(T);
+	}
+
+	auto begin()
+	{
+		return Items.begin();
+	}
+
+	auto end()
+	{
+		return Items.end();
+	}
+
+	auto begin() const
+	{
+		return Items.begin();
+	}
+
+	auto end() const
+	{
+		return Items.end();
+	}
+
+	bool operator==(const TStandaloneArray& Other) const
+	{
+		return Items == Other.Items;
+	}
+
+private:
+	std::vector<T> Items;
+};
+
+template <typename T>
+using TArray = TStandaloneArray<T, int32>;
+template <typename T>
+using TArray64 = TStandaloneArray<T, int64>;
+
+/** Non-owning view of contiguous items */
+template <typename T>
+class TArrayView
+{
+public:
+	TArrayView() = default;
+	TArrayView(T* InData, int32 InNum)
+		: Data(InData)
+		, Count(InNum)
+	{
+	}
+
+	template <typename OtherType, typename SizeType>
+	TArrayView(TStandaloneArray<OtherType, SizeType>& Array)
+		: Data(Array.GetData())
+		, Count(static_cast<int32>(Array.Num()))
+	{
+	}
+
+	template <typename OtherType, typename SizeType>
+	TArrayView(const TStandaloneArray<OtherType, SizeType>& Array)
+		: Data(Array.GetData())
+		, Count(static_cast<int32>(Array.Num()))
+	{
+	}
+
+	template <typename OtherType, int32 N>
+	TArrayView(OtherType (&Array)[N])
+		: Data(Array)
+		, Count(N)
+	{
+	}
+
+	int32 Num() const
+	{
+		return Count;
+	}
+
+	bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	T* GetData() const
+	{
+		return Data;
+	}
+
+	T& operator[](int32 Index) const
+	{
+		checkSlow(Index >= 0 && Index < Count);
+		return Data[Index];
+	}
+
+	T* begin() const
+	{
+		return Data;
+	}
+
+	T* end() const
+	{
+		return Data + Count;
+	}
+
+private:
+	T* Data = nullptr;
+	int32 Count = 0;
+};
+
+template <typename T>
+using TConstArrayView = TArrayView<const T>;
+
+/**
+ * Hash map over std::unordered_map, with the lookups of the engine TMap: Find returns a pointer, null if missing.
+ * Keys are hashed with GetTypeHash, found by argument-dependent lookup like in the engine.
+ */
+template <typename KeyType, typename ValueType>
+class TMap
+{
+public:
+	int32 Num() const
+	{
+		return static_cast<int32>(Pairs.size());
+	}
+
+	bool IsEmpty() const
+	{
+		return Pairs.empty();
+	}
+
+	ValueType& Add(const KeyType& Key, ValueType Value)
+	{
+		return Pairs.insert_or_assign(Key, MoveTemp(Value)).first->second;
+	}
+
+	ValueType& FindOrAdd(const KeyType& Key, ValueType Value = ValueType())
+	{
+		return Pairs.try_emplace(Key, MoveTemp(Value)).first->second;
+	}
+
+	ValueType* Find(const KeyType& Key)
+	{
+		const auto It = Pairs.find(Key);
+		return It == Pairs.end() ? nullptr : &It->second;
+	}
+
+	const ValueType* Find(const KeyType& Key) const
+	{
+		const auto It = Pairs.find(Key);
+		return It == Pairs.end() ? nullptr : &It->second;
+	}
+
+	bool Contains(const KeyType& Key) const
+	{
+		return Pairs.count(Key) != 0;
+	}
+
+	int32 Remove(const KeyType& Key)
+	{
+		return static_cast<int32>(Pairs.erase(Key));
+	}
+
+	int32 GetKeys(TArray<KeyType>& OutKeys) const
+	{
+		OutKeys.Reset(Num());
+		for (const auto& Pair : Pairs)
+		{
+			OutKeys.Add(Pair.first);
+		}
+		return OutKeys.Num();
+	}
+
+	void Reset()
+	{
+		Pairs.clear();
+	}
+
+	void Empty()
+	{
+		FPairs().swap(Pairs);
+	}
+
+	/** Estimate, the standard library does not expose the size of its nodes */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Pairs.bucket_count() * sizeof(void*) + Pairs.size() * (sizeof(typename FPairs::value_type) + sizeof(void*));
+	}
+
+private:
+	struct FKeyHash
+	{
+		size_t operator()(const KeyType& Key) const
+		{
+			return GetTypeHash(Key);
+		}
+	};
+
+	using FPairs = std::unordered_map<KeyType, ValueType, FKeyHash>;
+	FPairs Pairs;
+};
+
+/** One bit per item, for the explored cells of FPathResult */
+template <typename AllocatorType = void>
+class TBitArray
+{
+public:
+	void Init(bool bValue, int32 Count)
+	{
+		Bits.assign(Count, bValue);
+	}
+
+	void Reset()
+	{
+		Bits.clear();
+	}
+
+	void Empty()
+	{
+		std::vector<bool>().swap(Bits);
+	}
+
+	int32 Num() const
+	{
+		return static_cast<int32>(Bits.size());
+	}
+
+	std::vector<bool>::reference operator[](int32 Index)
+	{
+		return Bits[Index];
+	}
+
+	bool operator[](int32 Index) const
+	{
+		return Bits[Index];
+	}
+
+	int32 CountSetBits() const
+	{
+		return static_cast<int32>(std::count(Bits.begin(), Bits.end(), true));
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Bits.capacity() / 8;
+	}
+
+private:
+	std::vector<bool> Bits;
+};
+
+template <typename AllocatorType = void>
+class TConstSetBitIterator
+{
+public:
+	explicit TConstSetBitIterator(const TBitArray<AllocatorType>& InArray)
+		: Array(InArray)
+	{
+		SkipClearedBits();
+	}
+
+	explicit operator bool() const
+	{
+		return Index < Array.Num();
+	}
+
+	TConstSetBitIterator& operator++()
+	{
+		++Index;
+		SkipClearedBits();
+		return *this;
+	}
+
+	int32 GetIndex() const
+	{
+		return Index;
+	}
+
+private:
+	void SkipClearedBits()
+	{
+		while (Index < Array.Num() && !Array[Index])
+		{
+			++Index;
+		}
+	}
+
+	const TBitArray<AllocatorType>& Array;
+	int32 Index = 0;
+};
+
+//////// MATH TYPES ////////
+/** World position of the cell centers written by FCellCenterOutput */
+struct FVector
+{
+	double X = 0.0;
+	double Y = 0.0;
+	double Z = 0.0;
+
+	FVector() = default;
+	FVector(double InX, double InY, double InZ)
+		: X(InX)
+		, Y(InY)
+		, Z(InZ)
+	{
+	}
+
+	FVector operator+(const FVector& Other) const
+	{
+		return FVector(X + Other.X, Y + Other.Y, Z + Other.Z);
+	}
+
+	FVector operator-(const FVector& Other) const
+	{
+		return FVector(X - Other.X, Y - Other.Y, Z - Other.Z);
+	}
+
+	FVector operator*(double Scale) const
+	{
+		return FVector(X * Scale, Y * Scale, Z * Scale);
+	}
+
+	bool operator==(const FVector& Other) const
+	{
+		return X == Other.X && Y == Other.Y && Z == Other.Z;
+	}
+
+	static double Dist(const FVector& A, const FVector& B)
+	{
+		return std::sqrt((A.X - B.X) * (A.X - B.X) + (A.Y - B.Y) * (A.Y - B.Y) + (A.Z - B.Z) * (A.Z - B.Z));
+	}
+};
+
+/** Cell coordinates, for the cluster bounds of FHierarchicalGraph */
+struct FIntPoint
+{
+	int32 X = 0;
+	int32 Y = 0;
+
+	FIntPoint() = default;
+	FIntPoint(int32 InX, int32 InY)
+		: X(InX)
+		, Y(InY)
+	{
+	}
+
+	bool operator==(const FIntPoint& Other) const
+	{
+		return X == Other.X && Y == Other.Y;
+	}
+};
+
+/** Rectangle of cells, Max excluded */
+struct FIntRect
+{
+	FIntPoint Min;
+	FIntPoint Max;
+
+	FIntRect() = default;
+	FIntRect(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)
+		: Min(MinX, MinY)
+		, Max(MaxX, MaxY)
+	{
+	}
+
+	bool Contains(const FIntPoint& Point) const
+	{
+		return Point.X >= Min.X && Point.X < Max.X && Point.Y >= Min.Y && Point.Y < Max.Y;
+	}
+};
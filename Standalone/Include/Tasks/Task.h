@@ -0,0 +1,83 @@
+// Task.h
+#pragma once
+
+/**
+ * Tasks of the engine for the standalone build: Launch starts one std::thread per task instead of queueing it on
+ * the worker pool. Enough for the tests and benchmark of FPathRequestQueue, not a scheduler.
+ */
+
+#include "PathfindingCoreStandalone.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace UE::Tasks
+{
+	class FTask
+	{
+	public:
+		FTask() = default;
+
+		bool IsValid() const
+		{
+			return State != nullptr;
+		}
+
+		bool IsCompleted() const
+		{
+			return !State || State->bIsCompleted.load();
+		}
+
+		/** Blocks until the task body returned, from any number of threads */
+		void Wait() const
+		{
+			if (State)
+			{
+				State->Join();
+			}
+		}
+
+	private:
+		struct FState
+		{
+			std::thread Thread;
+			std::atomic<bool> bIsCompleted = false;
+			std::mutex JoinMutex;
+
+			~FState()
+			{
+				Join();
+			}
+
+			void Join()
+			{
+				std::lock_guard<std::mutex> Lock(JoinMutex);
+				if (Thread.joinable())
+				{
+					Thread.join();
+				}
+			}
+		};
+
+		std::shared_ptr<FState> State;
+
+		template <typename TaskBodyType>
+		friend FTask Launch(const TCHAR* DebugName, TaskBodyType&& TaskBody);
+	};
+
+	template <typename TaskBodyType>
+	FTask Launch(const TCHAR* DebugName, TaskBodyType&& TaskBody)
+	{
+		FTask Task;
+		Task.State = std::make_shared<FTask::FState>();
+		FTask::FState* State = Task.State.get();
+
+		// The thread only touches the state before the join of its destructor returns
+		State->Thread = std::thread([State, Body = std::forward<TaskBodyType>(TaskBody)]() mutable
+		{
+			Body();
+			State->bIsCompleted.store(true);
+		});
+		return Task;
+	}
+}
@@ -0,0 +1,25 @@
+#include "Misc/AutomationTest.h"
+#include <cstring>
+
+/** Runs every registered test, or the ones whose name contains the first argument */
+int main(int ArgCount, char** Args)
+{
+	const char* Filter = ArgCount > 1 ? Args[1] : "";
+	int32 NumRun = 0;
+	int32 NumFailed = 0;
+	for (FAutomationTestBase* Test : FAutomationTestBase::GetTests())
+	{
+		if (std::strstr(Test->GetTestName(), Filter) == nullptr)
+		{
+			continue;
+		}
+
+		const bool bSucceeded = Test->RunTest(FString()) && Test->GetNumErrors() == 0;
+		std::printf("%s %s\n", bSucceeded ? "Success" : "Fail   ", Test->GetTestName());
+		++NumRun;
+		NumFailed += !bSucceeded;
+	}
+
+	std::printf("%d tests run, %d failed\n", NumRun, NumFailed);
+	return NumRun > 0 && NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+// CoreMinimal.h
+#pragma once
+
+/**
+ * What the automation tests of the core use beyond the core types, for the standalone build only: FString for the
+ * test messages and FRandomStream with the engine generator, so the random grids come from the same seeds.
+ */
+
+#include "PathfindingCoreStandalone.h"
+#include <string>
+
+class FString
+{
+public:
+	FString() = default;
+	FString(const TCHAR* Text)
+		: Text(Text)
+	{
+	}
+
+	template <typename... ArgTypes>
+	static FString Printf(const TCHAR* Format, ArgTypes... Args)
+	{
+		FString Result;
+		Result.Text.resize(std::snprintf(nullptr, 0, Format, Args...));
+		std::snprintf(Result.Text.data(), Result.Text.size() + 1, Format, Args...);
+		return Result;
+	}
+
+	const TCHAR* operator*() const
+	{
+		return Text.c_str();
+	}
+
+private:
+	std::string Text;
+};
+
+/** Linear congruential generator of the engine, same sequence for the same seed */
+class FRandomStream
+{
+public:
+	explicit FRandomStream(int32 InSeed)
+		: Seed(static_cast<uint32>(InSeed))
+	{
+	}
+
+	float GetFraction()
+	{
+		Seed = Seed * 196314165u + 907633515u;
+		const uint32 Bits = 0x3F800000u | (Seed >> 9);
+		float Result;
+		FMemory::Memcpy(&Result, &Bits, sizeof(Result));
+		return Result - 1.0f;
+	}
+
+	float FRand()
+	{
+		return GetFraction();
+	}
+
+	int32 RandHelper(int32 A)
+	{
+		return A > 0 ? FMath::Min(static_cast<int32>(GetFraction() * static_cast<float>(A)), A - 1) : 0;
+	}
+
+	int32 RandRange(int32 Min, int32 Max)
+	{
+		return Min + RandHelper(Max - Min + 1);
+	}
+
+private:
+	uint32 Seed;
+};
@@ -0,0 +1,106 @@
+// AutomationTest.h
+#pragma once
+
+/**
+ * The simple automation tests of the engine for the standalone build: each IMPLEMENT_SIMPLE_AUTOMATION_TEST registers
+ * itself, AutomationTestMain.cpp runs them and fails when one of them reported an error.
+ */
+
+#include "CoreMinimal.h"
+#include <string>
+#include <type_traits>
+
+namespace EAutomationTestFlags
+{
+	enum Type : uint32
+	{
+		ApplicationContextMask = 1 << 0,
+		ProductFilter = 1 << 1
+	};
+}
+
+class FAutomationTestBase
+{
+public:
+	//////// CONSTRUCTOR ////////
+	explicit FAutomationTestBase(const TCHAR* InTestName)
+		: TestName(InTestName)
+	{
+		GetTests().Add(this);
+	}
+
+	virtual ~FAutomationTestBase() = default;
+
+	//////// METHODS ////////
+	virtual bool RunTest(const FString& Parameters) = 0;
+
+	static TArray<FAutomationTestBase*>& GetTests()
+	{
+		static TArray<FAutomationTestBase*> Tests;
+		return Tests;
+	}
+
+	const TCHAR* GetTestName() const
+	{
+		return TestName;
+	}
+
+	int32 GetNumErrors() const
+	{
+		return NumErrors;
+	}
+
+	void AddError(const FString& Error)
+	{
+		std::fprintf(stderr, "%s: %s\n", TestName, *Error);
+		++NumErrors;
+	}
+
+	bool TestTrue(const TCHAR* What, bool bValue)
+	{
+		if (!bValue)
+		{
+			AddError(FString::Printf(TEXT("Expected '%s' to be true."), What));
+		}
+		return bValue;
+	}
+
+	bool TestFalse(const TCHAR* What, bool bValue)
+	{
+		return TestTrue(What, !bValue);
+	}
+
+	/** Floating point values are compared with the tolerance of the engine */
+	template <typename ActualType, typename ExpectedType>
+	bool TestEqual(const TCHAR* What, const ActualType& Actual, const ExpectedType& Expected)
+	{
+		static_assert(std::is_arithmetic_v<ActualType> && std::is_arithmetic_v<ExpectedType>,
+			"Only numbers are compared by the standalone tests");
+		const bool bIsEqual = std::is_floating_point_v<ActualType> || std::is_floating_point_v<ExpectedType>
+			? FMath::Abs(static_cast<double>(Actual) - static_cast<double>(Expected)) <= 1.e-4
+			: Actual == Expected;
+		if (!bIsEqual)
+		{
+			AddError(FString::Printf(TEXT("Expected '%s' to be %s, but it was %s."), What,
+				std::to_string(+Expected).c_str(), std::to_string(+Actual).c_str()));
+		}
+		return bIsEqual;
+	}
+
+private:
+	//////// FIELDS ////////
+	const TCHAR* TestName;
+	int32 NumErrors = 0;
+};
+
+#define IMPLEMENT_SIMPLE_AUTOMATION_TEST(TClass, PrettyName, TFlags) \
+	class TClass : public FAutomationTestBase \
+	{ \
+	public: \
+		TClass() \
+			: FAutomationTestBase(TEXT(PrettyName)) \
+		{ \
+		} \
+		virtual bool RunTest(const FString& Parameters) override; \
+	}; \
+	static TClass TClass##Instance;